@@ -0,0 +1,321 @@
+/*
+ * Copyright 2020 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "fsl_mmc.h"
+#include "fsl_debug_console.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "pin_mux.h"
+#include "clock_config.h"
+#include "board.h"
+#include "sdmmc_config.h"
+#include "fsl_common.h"
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief Size of one random read access. */
+#define DEMO_BENCHMARK_RANDOM_SIZE (4U * 1024U)
+/*! @brief Random read access count of each queue depth. */
+#define DEMO_BENCHMARK_RANDOM_COUNT (1024U)
+/*! @brief Random read region in block, limited to the user partition size. */
+#define DEMO_BENCHMARK_RANDOM_REGION (512U * 1024U)
+/*! @brief Size of one atomic update. */
+#define DEMO_BENCHMARK_UPDATE_SIZE (4U * 1024U)
+/*! @brief Atomic update count of each write mode. */
+#define DEMO_BENCHMARK_UPDATE_COUNT (256U)
+/*! @brief Atomic update region in block, located at the end of the user partition, the data in it is destroyed. */
+#define DEMO_BENCHMARK_UPDATE_REGION (1024U)
+
+/* Task stack size and priority. */
+#define BenchmarkTask_STACK_SIZE (2048U)
+#define MMC_TASK_PRIORITY        (configMAX_PRIORITIES - 1U)
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+/*!
+ * @brief MMC card benchmark task.
+ *
+ * @param pvParameters Task parameter.
+ */
+static void BenchmarkTask(void *pvParameters);
+
+/*!
+ * @brief Run the random read benchmark with different command queue depth.
+ *
+ * @param card Card descriptor.
+ */
+static status_t BenchmarkCommandQueue(mmc_card_t *card);
+
+/*!
+ * @brief Run the atomic update benchmark with write and read back verification and with reliable write.
+ *
+ * @param card Card descriptor.
+ */
+static status_t BenchmarkReliableWrite(mmc_card_t *card);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*! @brief Card descriptor. */
+mmc_card_t g_mmc;
+
+/*! @brief Data read from the card, the random read data is discarded so all the tasks share one buffer */
+SDK_ALIGN(uint8_t g_dataRead[DEMO_BENCHMARK_RANDOM_SIZE], BOARD_SDMMC_DATA_BUFFER_ALIGN_SIZE);
+/*! @brief Data written to the card */
+SDK_ALIGN(uint8_t g_dataWrite[DEMO_BENCHMARK_UPDATE_SIZE], BOARD_SDMMC_DATA_BUFFER_ALIGN_SIZE);
+
+/*! @brief Random read tasks */
+static mmc_cmdq_task_t s_task[DEMO_BENCHMARK_RANDOM_COUNT];
+/*! @brief Benchmark queue depth */
+static const uint32_t s_benchmarkDepth[] = {1U, 2U, 4U, 8U, 16U, 32U};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+static void BenchmarkTimerInit(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0U;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+static uint32_t BenchmarkGetIops(uint32_t count, uint64_t cycles)
+{
+    if (cycles == 0U)
+    {
+        return 0U;
+    }
+
+    return (uint32_t)(((uint64_t)count * SystemCoreClock) / cycles);
+}
+
+static void BenchmarkPrepareTask(mmc_card_t *card)
+{
+    uint32_t region = card->userPartitionBlocks;
+    uint32_t seed   = 0x12345678U;
+    uint32_t blocks = DEMO_BENCHMARK_RANDOM_SIZE / FSL_SDMMC_DEFAULT_BLOCK_SIZE;
+    uint32_t i;
+
+    if (region > DEMO_BENCHMARK_RANDOM_REGION)
+    {
+        region = DEMO_BENCHMARK_RANDOM_REGION;
+    }
+
+    for (i = 0U; i < DEMO_BENCHMARK_RANDOM_COUNT; i++)
+    {
+        /* LCG to generate the same access pattern for every queue depth */
+        seed                          = seed * 1664525U + 1013904223U;
+        s_task[i].buffer              = g_dataRead;
+        s_task[i].startBlock          = ((seed >> 8U) % (region / blocks)) * blocks;
+        s_task[i].blockCount          = blocks;
+        s_task[i].isWrite             = false;
+        s_task[i].isHighPriority      = false;
+        s_task[i].isForcedProgramming = false;
+        s_task[i].isReliableWrite     = false;
+    }
+}
+
+static status_t BenchmarkCommandQueue(mmc_card_t *card)
+{
+    uint32_t supportDepth = card->cmdqDepth;
+    uint32_t depthIndex;
+    uint32_t start  = 0U;
+    uint64_t cycles = 0U;
+    uint32_t i;
+    status_t error = kStatus_Success;
+
+    BenchmarkPrepareTask(card);
+
+    PRINTF("\r\n%10s %10s %10s\r\n", "mode", "depth", "IOPS");
+
+    /* legacy CMD18 read */
+    cycles = 0U;
+    for (i = 0U; i < DEMO_BENCHMARK_RANDOM_COUNT; i++)
+    {
+        start = DWT->CYCCNT;
+        error = MMC_ReadBlocks(card, g_dataRead, s_task[i].startBlock, s_task[i].blockCount);
+        cycles += (uint32_t)(DWT->CYCCNT - start);
+        if (error != kStatus_Success)
+        {
+            PRINTF("Read failed.\r\n");
+            return error;
+        }
+    }
+    PRINTF("%10s %10d %10d\r\n", "CMD18", 1U, BenchmarkGetIops(DEMO_BENCHMARK_RANDOM_COUNT, cycles));
+
+    if ((card->flags & (uint32_t)kMMC_SupportCommandQueueFlag) == 0U)
+    {
+        PRINTF("\r\nThe command queue is not supported by the card.\r\n");
+        return kStatus_Success;
+    }
+
+    if (kStatus_Success != MMC_EnableCommandQueue(card, true))
+    {
+        PRINTF("Enable command queue failed.\r\n");
+        return kStatus_Fail;
+    }
+
+    for (depthIndex = 0U; depthIndex < ARRAY_SIZE(s_benchmarkDepth); depthIndex++)
+    {
+        if (s_benchmarkDepth[depthIndex] > supportDepth)
+        {
+            break;
+        }
+
+        /* limit the number of tasks queued in the card */
+        card->cmdqDepth = s_benchmarkDepth[depthIndex];
+
+        start  = DWT->CYCCNT;
+        error  = MMC_CommandQueueTransfer(card, s_task, DEMO_BENCHMARK_RANDOM_COUNT);
+        cycles = (uint32_t)(DWT->CYCCNT - start);
+        if (error != kStatus_Success)
+        {
+            PRINTF("Command queue read failed.\r\n");
+            break;
+        }
+
+        PRINTF("%10s %10d %10d\r\n", "CMDQ", card->cmdqDepth, BenchmarkGetIops(DEMO_BENCHMARK_RANDOM_COUNT, cycles));
+    }
+
+    card->cmdqDepth = supportDepth;
+    (void)MMC_EnableCommandQueue(card, false);
+
+    return error;
+}
+
+static status_t BenchmarkReliableWrite(mmc_card_t *card)
+{
+    uint32_t blocks      = DEMO_BENCHMARK_UPDATE_SIZE / FSL_SDMMC_DEFAULT_BLOCK_SIZE;
+    uint32_t regionStart = card->userPartitionBlocks - DEMO_BENCHMARK_UPDATE_REGION;
+    uint32_t startBlock  = 0U;
+    uint32_t start       = 0U;
+    uint64_t cycles      = 0U;
+    uint32_t i;
+    status_t error = kStatus_Success;
+
+    PRINTF("\r\n%10s %10s %10s\r\n", "mode", "size", "IOPS");
+
+    /* write then read back to verify the update */
+    cycles = 0U;
+    for (i = 0U; i < DEMO_BENCHMARK_UPDATE_COUNT; i++)
+    {
+        startBlock = regionStart + (i * blocks) % DEMO_BENCHMARK_UPDATE_REGION;
+        (void)memset(g_dataWrite, (int)i, sizeof(g_dataWrite));
+
+        start = DWT->CYCCNT;
+        error = MMC_WriteBlocks(card, g_dataWrite, startBlock, blocks);
+        if (error == kStatus_Success)
+        {
+            error = MMC_ReadBlocks(card, g_dataRead, startBlock, blocks);
+        }
+        if ((error == kStatus_Success) && (memcmp(g_dataWrite, g_dataRead, sizeof(g_dataWrite)) != 0))
+        {
+            error = kStatus_Fail;
+        }
+        cycles += (uint32_t)(DWT->CYCCNT - start);
+        if (error != kStatus_Success)
+        {
+            PRINTF("Write and read back failed.\r\n");
+            return error;
+        }
+    }
+    PRINTF("%10s %10d %10d\r\n", "VERIFY", DEMO_BENCHMARK_UPDATE_SIZE,
+           BenchmarkGetIops(DEMO_BENCHMARK_UPDATE_COUNT, cycles));
+
+    /* reliable write */
+    cycles = 0U;
+    for (i = 0U; i < DEMO_BENCHMARK_UPDATE_COUNT; i++)
+    {
+        startBlock = regionStart + (i * blocks) % DEMO_BENCHMARK_UPDATE_REGION;
+        (void)memset(g_dataWrite, (int)i, sizeof(g_dataWrite));
+
+        start = DWT->CYCCNT;
+        error = MMC_WriteBlocksReliable(card, g_dataWrite, startBlock, blocks);
+        cycles += (uint32_t)(DWT->CYCCNT - start);
+        if (error != kStatus_Success)
+        {
+            PRINTF("Reliable write failed.\r\n");
+            return error;
+        }
+    }
+    PRINTF("%10s %10d %10d\r\n", "RELIABLE", DEMO_BENCHMARK_UPDATE_SIZE,
+           BenchmarkGetIops(DEMO_BENCHMARK_UPDATE_COUNT, cycles));
+
+    return error;
+}
+
+static void BenchmarkTask(void *pvParameters)
+{
+    mmc_card_t *card = &g_mmc;
+    char ch          = '0';
+
+    PRINTF("\r\nMMCCARD benchmark example.\r\n");
+
+    BenchmarkTimerInit();
+
+    /* Init card. */
+    if (MMC_Init(card))
+    {
+        PRINTF("\n MMC card init failed \n");
+        vTaskSuspend(NULL);
+    }
+
+    PRINTF("\r\nCard size %d * %d bytes, command queue depth %d\r\n", card->userPartitionBlocks, card->blockSize,
+           card->cmdqDepth);
+
+    while (ch != 'q')
+    {
+        PRINTF("\r\n%d bytes random read benchmark......\r\n", DEMO_BENCHMARK_RANDOM_SIZE);
+        if (kStatus_Success != BenchmarkCommandQueue(card))
+        {
+            break;
+        }
+
+        PRINTF("\r\n%d bytes atomic update benchmark, reliable write sector count %d......\r\n",
+               DEMO_BENCHMARK_UPDATE_SIZE, card->extendedCsd.reliableWriteSectorCount);
+        if (kStatus_Success != BenchmarkReliableWrite(card))
+        {
+            break;
+        }
+
+        PRINTF("\r\nInput 'q' to quit benchmark.\r\nInput other char to run benchmark again.\r\n");
+        ch = GETCHAR();
+        PUTCHAR(ch);
+    }
+
+    PRINTF("\r\nThe example will not run benchmark again.\r\n");
+
+    MMC_Deinit(card);
+
+    vTaskSuspend(NULL);
+}
+
+/*! @brief Main function */
+int main(void)
+{
+    BOARD_ConfigMPU();
+    BOARD_InitPins();
+    BOARD_BootClockRUN();
+    BOARD_InitDebugConsole();
+    BOARD_MMC_Config(&g_mmc, BOARD_SDMMC_MMC_HOST_IRQ_PRIORITY);
+
+    if (pdPASS != xTaskCreate(BenchmarkTask, "BenchmarkTask", BenchmarkTask_STACK_SIZE, NULL, MMC_TASK_PRIORITY, NULL))
+    {
+        return -1;
+    }
+
+    /* Start the tasks and timer running. */
+    vTaskStartScheduler();
+    /* Scheduler should never reach this point. */
+    while (true)
+    {
+    }
+}
@@ -0,0 +1,418 @@
+/*
+ * Copyright 2020 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include "fsl_debug_console.h"
+#include "pin_mux.h"
+#include "clock_config.h"
+#include "board.h"
+#include "fsl_sd.h"
+#include "sdmmc_config.h"
+#include "fsl_common.h"
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief Maximum transfer size of one benchmark access. */
+#define DEMO_BENCHMARK_MAX_SIZE (32U * 1024U)
+/*! @brief Size of the exchange buffer used for the unaligned data buffer. */
+#define DEMO_BENCHMARK_ALIGN_BUFFER_SIZE (16U * 1024U)
+/*! @brief Repeat count of each benchmark access. */
+#define DEMO_BENCHMARK_LOOP (8U)
+/*! @brief Offset applied to the data buffer to make it unaligned. */
+#define DEMO_BENCHMARK_UNALIGN_OFFSET (1U)
+/*! @brief Total size of the sustained sequential write benchmark. */
+#define DEMO_BENCHMARK_SEQUENTIAL_SIZE (4U * 1024U * 1024U)
+/*! @brief Benchmark region in block, located at the end of the card to keep the partition table and file system at the
+ * beginning of the card, the data in it is destroyed. */
+#define DEMO_BENCHMARK_REGION_BLOCKS (DEMO_BENCHMARK_SEQUENTIAL_SIZE / FSL_SDMMC_DEFAULT_BLOCK_SIZE)
+
+/*! @brief benchmark buffer mode */
+typedef enum _benchmark_mode
+{
+    kBenchmark_AlignedBuffer           = 0U, /*!< word aligned data buffer */
+    kBenchmark_UnalignedBuffer         = 1U, /*!< unaligned data buffer through the card internal one block buffer */
+    kBenchmark_UnalignedBufferExchange = 2U, /*!< unaligned data buffer through the multiple block exchange buffer */
+} benchmark_mode_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+/*!
+ * @brief printf the card information log.
+ *
+ * @param card Card descriptor.
+ */
+static void CardInformationLog(sd_card_t *card);
+
+/*!
+ * @brief Run the aligned/unaligned data buffer benchmark.
+ *
+ * @param card Card descriptor.
+ * @param isReadOnly true to run the read benchmark only.
+ */
+static status_t BenchmarkAlignment(sd_card_t *card, bool isReadOnly);
+
+/*!
+ * @brief Run the sustained sequential write benchmark with/without pre-erase.
+ *
+ * @param card Card descriptor.
+ */
+static status_t BenchmarkPreErase(sd_card_t *card);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*! @brief Card descriptor. */
+sd_card_t g_sd;
+
+/*! @brief Benchmark data buffer, the extra space is reserved for the unaligned offset */
+SDK_ALIGN(uint8_t g_dataBuffer[DEMO_BENCHMARK_MAX_SIZE + BOARD_SDMMC_DATA_BUFFER_ALIGN_SIZE],
+          BOARD_SDMMC_DATA_BUFFER_ALIGN_SIZE);
+/*! @brief Multiple block exchange buffer for the unaligned data buffer */
+SDK_ALIGN(uint8_t g_alignBuffer[DEMO_BENCHMARK_ALIGN_BUFFER_SIZE], BOARD_SDMMC_DATA_BUFFER_ALIGN_SIZE);
+
+/*! @brief Start block of the benchmark region */
+static uint32_t s_benchmarkStartBlock;
+/*! @brief Benchmark transfer size */
+static const uint32_t s_benchmarkSize[] = {4U * 1024U, 16U * 1024U, DEMO_BENCHMARK_MAX_SIZE};
+/*! @brief Benchmark mode name */
+static const char *const s_benchmarkModeName[] = {"aligned", "unaligned", "unaligned+exchange"};
+/*! @brief Pre-erase policy name */
+static const char *const s_preErasePolicyName[] = {"disable", "ACMD23"};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+static void BenchmarkTimerInit(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0U;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+static uint32_t BenchmarkGetKBps(uint32_t bytes, uint64_t cycles)
+{
+    if (cycles == 0U)
+    {
+        return 0U;
+    }
+
+    return (uint32_t)(((uint64_t)bytes * SystemCoreClock) / (cycles * 1024U));
+}
+
+static void BenchmarkFillPattern(uint8_t *buffer, uint32_t size, uint32_t seed)
+{
+    uint32_t i;
+
+    for (i = 0U; i < size; i++)
+    {
+        buffer[i] = (uint8_t)(i + seed);
+    }
+}
+
+static bool BenchmarkCheckPattern(const uint8_t *buffer, uint32_t size, uint32_t seed)
+{
+    uint32_t i;
+
+    for (i = 0U; i < size; i++)
+    {
+        if (buffer[i] != (uint8_t)(i + seed))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static status_t BenchmarkAccess(sd_card_t *card, uint8_t *buffer, uint32_t size, bool isWrite, uint32_t *kbps)
+{
+    uint64_t cycles = 0U;
+    uint32_t start  = 0U;
+    uint32_t i;
+    status_t error = kStatus_Success;
+
+    for (i = 0U; i < DEMO_BENCHMARK_LOOP; i++)
+    {
+        start = DWT->CYCCNT;
+        if (isWrite)
+        {
+            error = SD_WriteBlocks(card, buffer, s_benchmarkStartBlock, size / FSL_SDMMC_DEFAULT_BLOCK_SIZE);
+        }
+        else
+        {
+            error = SD_ReadBlocks(card, buffer, s_benchmarkStartBlock, size / FSL_SDMMC_DEFAULT_BLOCK_SIZE);
+        }
+        cycles += (uint32_t)(DWT->CYCCNT - start);
+
+        if (error != kStatus_Success)
+        {
+            return error;
+        }
+    }
+
+    *kbps = BenchmarkGetKBps(size * DEMO_BENCHMARK_LOOP, cycles);
+
+    return kStatus_Success;
+}
+
+static status_t BenchmarkAlignment(sd_card_t *card, bool isReadOnly)
+{
+    uint32_t sizeIndex;
+    uint32_t mode;
+    uint32_t size;
+    uint32_t writeKBps = 0U;
+    uint32_t readKBps  = 0U;
+    uint8_t *buffer    = NULL;
+
+    PRINTF("\r\n%10s %20s %12s %12s\r\n", "size(B)", "buffer", "write(KB/s)", "read(KB/s)");
+
+    for (sizeIndex = 0U; sizeIndex < ARRAY_SIZE(s_benchmarkSize); sizeIndex++)
+    {
+        size = s_benchmarkSize[sizeIndex];
+
+        for (mode = (uint32_t)kBenchmark_AlignedBuffer; mode <= (uint32_t)kBenchmark_UnalignedBufferExchange; mode++)
+        {
+            buffer = g_dataBuffer;
+            if (mode != (uint32_t)kBenchmark_AlignedBuffer)
+            {
+                buffer += DEMO_BENCHMARK_UNALIGN_OFFSET;
+            }
+
+            if (mode == (uint32_t)kBenchmark_UnalignedBufferExchange)
+            {
+                card->alignBuffer     = g_alignBuffer;
+                card->alignBufferSize = sizeof(g_alignBuffer);
+            }
+            else
+            {
+                card->alignBuffer     = NULL;
+                card->alignBufferSize = 0U;
+            }
+
+            writeKBps = 0U;
+            if (!isReadOnly)
+            {
+                BenchmarkFillPattern(buffer, size, size + mode);
+                if (kStatus_Success != BenchmarkAccess(card, buffer, size, true, &writeKBps))
+                {
+                    PRINTF("Write %d bytes failed.\r\n", size);
+                    return kStatus_Fail;
+                }
+                (void)memset(buffer, 0, size);
+            }
+
+            if (kStatus_Success != BenchmarkAccess(card, buffer, size, false, &readKBps))
+            {
+                PRINTF("Read %d bytes failed.\r\n", size);
+                return kStatus_Fail;
+            }
+
+            if ((!isReadOnly) && (!BenchmarkCheckPattern(buffer, size, size + mode)))
+            {
+                PRINTF("The read/write content isn't consistent.\r\n");
+                return kStatus_Fail;
+            }
+
+            PRINTF("%10d %20s %12d %12d\r\n", size, s_benchmarkModeName[mode], writeKBps, readKBps);
+        }
+    }
+
+    card->alignBuffer     = NULL;
+    card->alignBufferSize = 0U;
+
+    return kStatus_Success;
+}
+
+static status_t BenchmarkPreErase(sd_card_t *card)
+{
+    uint32_t sizeIndex;
+    uint32_t policy;
+    uint32_t size;
+    uint32_t offset;
+    uint32_t start  = 0U;
+    uint64_t cycles = 0U;
+    uint32_t kbps   = 0U;
+
+    PRINTF("\r\n%10s %12s %12s\r\n", "chunk(B)", "pre-erase", "write(MB/s)");
+
+    BenchmarkFillPattern(g_dataBuffer, DEMO_BENCHMARK_MAX_SIZE, 0U);
+
+    for (sizeIndex = 0U; sizeIndex < ARRAY_SIZE(s_benchmarkSize); sizeIndex++)
+    {
+        size = s_benchmarkSize[sizeIndex];
+
+        for (policy = (uint32_t)kSD_PreEraseDisable; policy <= (uint32_t)kSD_PreEraseMultipleBlock; policy++)
+        {
+            card->preErasePolicy = (sd_pre_erase_policy_t)policy;
+            cycles               = 0U;
+
+            for (offset = 0U; offset < DEMO_BENCHMARK_SEQUENTIAL_SIZE; offset += size)
+            {
+                start = DWT->CYCCNT;
+                if (kStatus_Success != SD_WriteBlocks(card, g_dataBuffer,
+                                                      s_benchmarkStartBlock + offset / FSL_SDMMC_DEFAULT_BLOCK_SIZE,
+                                                      size / FSL_SDMMC_DEFAULT_BLOCK_SIZE))
+                {
+                    card->preErasePolicy = kSD_PreEraseDisable;
+                    PRINTF("Write %d bytes failed.\r\n", size);
+                    return kStatus_Fail;
+                }
+                cycles += (uint32_t)(DWT->CYCCNT - start);
+            }
+
+            kbps = BenchmarkGetKBps(DEMO_BENCHMARK_SEQUENTIAL_SIZE, cycles);
+            PRINTF("%10d %12s %9d.%02d\r\n", size, s_preErasePolicyName[policy], kbps / 1024U,
+                   (kbps % 1024U) * 100U / 1024U);
+        }
+    }
+
+    card->preErasePolicy = kSD_PreEraseDisable;
+
+    return kStatus_Success;
+}
+
+/*!
+ * @brief Main function
+ */
+int main(void)
+{
+    sd_card_t *card = &g_sd;
+    char ch         = '0';
+    bool isReadOnly;
+
+    BOARD_ConfigMPU();
+    BOARD_InitPins();
+    BOARD_BootClockRUN();
+    BOARD_InitDebugConsole();
+    BOARD_SD_Config(card, NULL, BOARD_SDMMC_SD_HOST_IRQ_PRIORITY, NULL);
+    BenchmarkTimerInit();
+
+    PRINTF("\r\nSDCARD benchmark example.\r\n");
+
+    /* SD host init function */
+    if (SD_HostInit(card) != kStatus_Success)
+    {
+        PRINTF("\r\nSD host init fail\r\n");
+        return -1;
+    }
+
+    PRINTF("\r\nPlease insert a card into board.\r\n");
+    /* wait card insert */
+    SD_PollingCardInsert(card, kSD_Inserted);
+    /* power off card */
+    SD_SetCardPower(card, false);
+    /* power on the card */
+    SD_SetCardPower(card, true);
+
+    PRINTF("\r\nCard inserted.\r\n");
+    /* Init card. */
+    if (SD_CardInit(card))
+    {
+        PRINTF("\r\nSD card init failed.\r\n");
+        return -1;
+    }
+    /* card information log */
+    CardInformationLog(card);
+
+    /* Check if card is readonly. */
+    isReadOnly = SD_CheckReadOnly(card);
+
+    if (card->blockCount < DEMO_BENCHMARK_REGION_BLOCKS)
+    {
+        PRINTF("\r\nCard is smaller than the benchmark region.\r\n");
+        return -1;
+    }
+    s_benchmarkStartBlock = card->blockCount - DEMO_BENCHMARK_REGION_BLOCKS;
+    if (!isReadOnly)
+    {
+        PRINTF("\r\nData in blocks %d - %d will be destroyed.\r\n", s_benchmarkStartBlock, card->blockCount - 1U);
+    }
+
+    while (ch != 'q')
+    {
+        PRINTF("\r\nAligned/unaligned data buffer benchmark......\r\n");
+        if (kStatus_Success != BenchmarkAlignment(card, isReadOnly))
+        {
+            break;
+        }
+
+        if (!isReadOnly)
+        {
+            PRINTF("\r\nSequential write with/without pre-erase benchmark......\r\n");
+            if (kStatus_Success != BenchmarkPreErase(card))
+            {
+                break;
+            }
+        }
+
+        PRINTF("\r\nInput 'q' to quit benchmark.\r\nInput other char to run benchmark again.\r\n");
+        ch = GETCHAR();
+        PUTCHAR(ch);
+    }
+
+    PRINTF("\r\nThe example will not run benchmark again.\r\n");
+    SD_Deinit(card);
+
+    while (true)
+    {
+    }
+}
+
+static void CardInformationLog(sd_card_t *card)
+{
+    assert(card);
+
+    PRINTF("\r\nCard size %d * %d bytes\r\n", card->blockCount, card->blockSize);
+    PRINTF("\r\nWorking condition:\r\n");
+    if (card->operationVoltage == kSDMMC_OperationVoltage330V)
+    {
+        PRINTF("\r\n  Voltage : 3.3V\r\n");
+    }
+    else if (card->operationVoltage == kSDMMC_OperationVoltage180V)
+    {
+        PRINTF("\r\n  Voltage : 1.8V\r\n");
+    }
+
+    if (card->currentTiming == kSD_TimingSDR12DefaultMode)
+    {
+        if (card->operationVoltage == kSDMMC_OperationVoltage330V)
+        {
+            PRINTF("\r\n  Timing mode: Default mode\r\n");
+        }
+        else if (card->operationVoltage == kSDMMC_OperationVoltage180V)
+        {
+            PRINTF("\r\n  Timing mode: SDR12 mode\r\n");
+        }
+    }
+    else if (card->currentTiming == kSD_TimingSDR25HighSpeedMode)
+    {
+        if (card->operationVoltage == kSDMMC_OperationVoltage180V)
+        {
+            PRINTF("\r\n  Timing mode: SDR25\r\n");
+        }
+        else
+        {
+            PRINTF("\r\n  Timing mode: High Speed\r\n");
+        }
+    }
+    else if (card->currentTiming == kSD_TimingSDR50Mode)
+    {
+        PRINTF("\r\n  Timing mode: SDR50\r\n");
+    }
+    else if (card->currentTiming == kSD_TimingSDR104Mode)
+    {
+        PRINTF("\r\n  Timing mode: SDR104\r\n");
+    }
+    else if (card->currentTiming == kSD_TimingDDR50Mode)
+    {
+        PRINTF("\r\n  Timing mode: DDR50\r\n");
+    }
+
+    PRINTF("\r\n  Freq : %d HZ\r\n", card->busClock_Hz);
+}
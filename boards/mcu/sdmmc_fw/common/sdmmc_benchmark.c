@@ -0,0 +1,343 @@
+/*
+ * Copyright 2020 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+#include <string.h>
+#include "sdmmc_benchmark.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief line ending of the printed rows */
+#if defined(BENCHMARK_SIMULATION)
+#define BENCHMARK_NEWLINE "\n"
+#else
+#define BENCHMARK_NEWLINE "\r\n"
+#endif
+
+/*! @brief benchmark pattern count */
+#define BENCHMARK_PATTERN_COUNT (4U)
+
+/*! @brief result of one row */
+typedef struct _benchmark_result
+{
+    uint64_t cycles;    /*!< total cycles */
+    uint32_t minCycles; /*!< minimum cycles of one sample */
+    uint32_t maxCycles; /*!< maximum cycles of one sample */
+    uint32_t count;     /*!< transfer count */
+} benchmark_result_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+/*!
+ * @brief Runs one result row.
+ *
+ * @param device benchmark device.
+ * @param config benchmark configuration.
+ * @param pattern pattern index.
+ * @param queueDepth queue depth.
+ * @param size transfer size in bytes.
+ * @param result row result.
+ */
+static status_t BENCHMARK_RunPoint(benchmark_device_t *device,
+                                   const benchmark_config_t *config,
+                                   uint32_t pattern,
+                                   uint32_t queueDepth,
+                                   uint32_t size,
+                                   benchmark_result_t *result);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+/*! @brief pattern name printed in the result rows */
+static const char *const s_benchmarkPatternName[BENCHMARK_PATTERN_COUNT] = {"seq_read", "seq_write", "rand_read",
+                                                                            "rand_write"};
+
+/*! @brief requests of the queued transfer */
+static benchmark_request_t s_benchmarkRequest[BENCHMARK_MAX_QUEUE_REQUEST];
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+static uint32_t BENCHMARK_Random(uint32_t *seed)
+{
+    /* numerical recipes LCG, the sequence is the same on the target and the host */
+    *seed = (*seed * 1664525U) + 1013904223U;
+
+    return *seed;
+}
+
+static void BENCHMARK_FillBuffer(uint8_t *buffer, uint32_t size, uint32_t seed)
+{
+    uint32_t i;
+
+    for (i = 0U; i < size; i++)
+    {
+        buffer[i] = (uint8_t)(BENCHMARK_Random(&seed) >> 24U);
+    }
+}
+
+static bool BENCHMARK_IsPowerOf2(uint32_t value)
+{
+    return (value != 0U) && ((value & (value - 1U)) == 0U);
+}
+
+static uint32_t BENCHMARK_NextBlock(const benchmark_config_t *config,
+                                    uint32_t pattern,
+                                    uint32_t index,
+                                    uint32_t blockCount,
+                                    uint32_t *seed)
+{
+    uint32_t slotCount = config->regionBlocks / blockCount;
+    uint32_t slot      = 0U;
+
+    if ((((uint32_t)kBENCHMARK_RandomRead | (uint32_t)kBENCHMARK_RandomWrite) & (1UL << pattern)) != 0U)
+    {
+        slot = (BENCHMARK_Random(seed) >> 8U) % slotCount;
+    }
+    else
+    {
+        slot = index % slotCount;
+    }
+
+    return config->startBlock + (slot * blockCount);
+}
+
+static void BENCHMARK_AddSample(benchmark_result_t *result, uint32_t cycles, uint32_t count)
+{
+    uint32_t sample = cycles / count;
+
+    result->cycles += cycles;
+    result->count += count;
+    if ((result->minCycles == 0U) || (sample < result->minCycles))
+    {
+        result->minCycles = sample;
+    }
+    if (sample > result->maxCycles)
+    {
+        result->maxCycles = sample;
+    }
+}
+
+static status_t BENCHMARK_RunPoint(benchmark_device_t *device,
+                                   const benchmark_config_t *config,
+                                   uint32_t pattern,
+                                   uint32_t queueDepth,
+                                   uint32_t size,
+                                   benchmark_result_t *result)
+{
+    bool isWrite        = (((uint32_t)kBENCHMARK_SequentialWrite | (uint32_t)kBENCHMARK_RandomWrite) &
+                    (1UL << pattern)) != 0U;
+    uint32_t blockCount = size / BENCHMARK_BLOCK_SIZE;
+    uint32_t count      = config->pointBytes / size;
+    uint32_t seed       = config->seed;
+    uint32_t index      = 0U;
+    uint32_t requests   = 0U;
+    uint32_t start      = 0U;
+    uint32_t i          = 0U;
+    status_t error      = kStatus_Success;
+
+    if (count < config->minLoops)
+    {
+        count = config->minLoops;
+    }
+    if (count > config->maxLoops)
+    {
+        count = config->maxLoops;
+    }
+
+    (void)memset(result, 0, sizeof(benchmark_result_t));
+
+    while ((index < count) && (error == kStatus_Success))
+    {
+        if (queueDepth == 1U)
+        {
+            uint32_t block = BENCHMARK_NextBlock(config, pattern, index, blockCount, &seed);
+
+            start = config->getCycles();
+            error = device->transfer(device->context, config->buffer, block, blockCount, isWrite);
+            BENCHMARK_AddSample(result, config->getCycles() - start, 1U);
+            index++;
+        }
+        else
+        {
+            /* the queued requests share the buffer, the data content is not checked by the benchmark */
+            requests = count - index;
+            if (requests > BENCHMARK_MAX_QUEUE_REQUEST)
+            {
+                requests = BENCHMARK_MAX_QUEUE_REQUEST;
+            }
+            for (i = 0U; i < requests; i++)
+            {
+                s_benchmarkRequest[i].buffer     = config->buffer;
+                s_benchmarkRequest[i].startBlock = BENCHMARK_NextBlock(config, pattern, index + i, blockCount, &seed);
+                s_benchmarkRequest[i].blockCount = blockCount;
+                s_benchmarkRequest[i].isWrite    = isWrite;
+            }
+
+            start = config->getCycles();
+            error = device->transferQueue(device->context, s_benchmarkRequest, requests);
+            BENCHMARK_AddSample(result, config->getCycles() - start, requests);
+            index += requests;
+        }
+    }
+
+    return error;
+}
+
+static void BENCHMARK_PrintRow(const benchmark_device_t *device,
+                               const benchmark_config_t *config,
+                               const char *timingName,
+                               uint32_t pattern,
+                               uint32_t queueDepth,
+                               uint32_t size,
+                               const benchmark_result_t *result,
+                               status_t error)
+{
+    uint64_t us     = result->cycles / config->cyclesPerUs;
+    uint64_t bytes  = (uint64_t)result->count * size;
+    uint32_t kibps  = 0U;
+    uint32_t iops   = 0U;
+    uint32_t avgLat = 0U;
+
+    if ((us != 0U) && (result->count != 0U))
+    {
+        kibps  = (uint32_t)((bytes * 1000000U) / (us * 1024U));
+        iops   = (uint32_t)(((uint64_t)result->count * 1000000U) / us);
+        avgLat = (uint32_t)(us / result->count);
+    }
+
+    BENCHMARK_PRINTF(BENCHMARK_ROW_PREFIX ",%s,%s,%s,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%d" BENCHMARK_NEWLINE,
+                     device->name, timingName, s_benchmarkPatternName[pattern], (unsigned int)queueDepth,
+                     (unsigned int)size, (unsigned int)result->count, (unsigned int)bytes, (unsigned int)us,
+                     (unsigned int)kibps, (unsigned int)iops, (unsigned int)avgLat,
+                     (unsigned int)(result->minCycles / config->cyclesPerUs),
+                     (unsigned int)(result->maxCycles / config->cyclesPerUs), (int)error);
+}
+
+void BENCHMARK_GetDefaultConfig(benchmark_config_t *config)
+{
+    assert(config != NULL);
+
+    (void)memset(config, 0, sizeof(benchmark_config_t));
+
+    config->patterns      = (uint32_t)kBENCHMARK_AllPatterns;
+    config->minSize       = 512U;
+    config->maxSize       = 4U * 1024U * 1024U;
+    config->pointBytes    = 4U * 1024U * 1024U;
+    config->minLoops      = 4U;
+    config->maxLoops      = 256U;
+    config->maxQueueDepth = 32U;
+    config->startBlock    = 0U;
+    config->regionBlocks  = (64U * 1024U * 1024U) / BENCHMARK_BLOCK_SIZE;
+    config->seed          = 0x5EED1234U;
+}
+
+status_t BENCHMARK_Run(benchmark_device_t *device, const benchmark_config_t *config)
+{
+    assert(device != NULL);
+    assert(config != NULL);
+
+    benchmark_result_t result;
+    const char *timingName = NULL;
+    uint32_t maxSize       = config->maxSize;
+    uint32_t maxDepth      = 0U;
+    uint32_t timing        = 0U;
+    uint32_t pattern       = 0U;
+    uint32_t depth         = 0U;
+    uint32_t size          = 0U;
+    status_t error         = kStatus_Success;
+
+    if ((device->transfer == NULL) || (device->setTiming == NULL) || (device->getTimingName == NULL) ||
+        (config->buffer == NULL) || (config->getCycles == NULL) || (config->cyclesPerUs == 0U) ||
+        (config->minSize < BENCHMARK_BLOCK_SIZE) || (!BENCHMARK_IsPowerOf2(config->minSize)) ||
+        (config->maxSize < config->minSize) || (config->minLoops == 0U) || (config->maxLoops < config->minLoops) ||
+        (((uint64_t)config->maxLoops * config->maxSize) > 0xFFFFFFFFU) || (config->regionBlocks == 0U) ||
+        (((uint64_t)config->startBlock + config->regionBlocks) > device->blockCount))
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    /* the transfer size is limited by the buffer and the region */
+    while ((maxSize >= config->minSize) &&
+           ((maxSize > config->bufferSize) || ((maxSize / BENCHMARK_BLOCK_SIZE) > config->regionBlocks)))
+    {
+        maxSize /= 2U;
+    }
+    if (maxSize < config->minSize)
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    BENCHMARK_PRINTF("# %s: %u blocks, region %u + %u blocks, %u cycles per us" BENCHMARK_NEWLINE, device->name,
+                     (unsigned int)device->blockCount, (unsigned int)config->startBlock,
+                     (unsigned int)config->regionBlocks, (unsigned int)config->cyclesPerUs);
+    if (maxSize < config->maxSize)
+    {
+        BENCHMARK_PRINTF("# transfer size is limited to %u bytes by the buffer or the region" BENCHMARK_NEWLINE,
+                         (unsigned int)maxSize);
+    }
+    BENCHMARK_PRINTF(BENCHMARK_ROW_PREFIX ",device,timing,pattern,queue_depth,size,count,bytes,us,kibps,iops,"
+                                          "lat_avg_us,lat_min_us,lat_max_us,status" BENCHMARK_NEWLINE);
+
+    for (timing = 0U; (timing < device->timingCount) && (error == kStatus_Success); timing++)
+    {
+        timingName = device->getTimingName(device->context, timing);
+        if (device->setTiming(device->context, timing) != kStatus_Success)
+        {
+            BENCHMARK_PRINTF("# timing %s is not supported, skipped" BENCHMARK_NEWLINE, timingName);
+            continue;
+        }
+
+        maxDepth = (device->transferQueue == NULL) ? 1U : device->maxQueueDepth;
+        if (maxDepth > config->maxQueueDepth)
+        {
+            maxDepth = config->maxQueueDepth;
+        }
+
+        for (pattern = 0U; (pattern < BENCHMARK_PATTERN_COUNT) && (error == kStatus_Success); pattern++)
+        {
+            if ((config->patterns & (1UL << pattern)) == 0U)
+            {
+                continue;
+            }
+
+            for (depth = 1U; (depth <= maxDepth) && (error == kStatus_Success); depth *= 2U)
+            {
+                if ((device->setQueueDepth != NULL) && (device->setQueueDepth(device->context, depth) != kStatus_Success))
+                {
+                    BENCHMARK_PRINTF("# queue depth %u is not supported, skipped" BENCHMARK_NEWLINE,
+                                     (unsigned int)depth);
+                    continue;
+                }
+
+                for (size = config->minSize; (size <= maxSize) && (error == kStatus_Success); size *= 2U)
+                {
+                    if ((((uint32_t)kBENCHMARK_SequentialWrite | (uint32_t)kBENCHMARK_RandomWrite) &
+                         (1UL << pattern)) != 0U)
+                    {
+                        BENCHMARK_FillBuffer(config->buffer, size, config->seed + size);
+                    }
+
+                    error = BENCHMARK_RunPoint(device, config, pattern, depth, size, &result);
+                    BENCHMARK_PrintRow(device, config, timingName, pattern, depth, size, &result, error);
+                }
+            }
+        }
+    }
+
+    if ((error == kStatus_Success) && (device->setQueueDepth != NULL))
+    {
+        (void)device->setQueueDepth(device->context, 1U);
+    }
+
+    BENCHMARK_PRINTF("# benchmark %s, status %d" BENCHMARK_NEWLINE, (error == kStatus_Success) ? "done" : "failed",
+                     (int)error);
+
+    return error;
+}
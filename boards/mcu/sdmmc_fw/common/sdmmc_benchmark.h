@@ -0,0 +1,159 @@
+/*
+ * Copyright 2020 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _SDMMC_BENCHMARK_H_
+#define _SDMMC_BENCHMARK_H_
+
+#if defined(BENCHMARK_SIMULATION)
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#else
+#include "fsl_common.h"
+#include "fsl_debug_console.h"
+#endif
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#if defined(BENCHMARK_SIMULATION)
+/*! @brief status code of the host build, the values are the same as fsl_common.h */
+typedef int32_t status_t;
+enum
+{
+    kStatus_Success         = 0,
+    kStatus_Fail            = 1,
+    kStatus_InvalidArgument = 4,
+};
+#ifndef BENCHMARK_PRINTF
+#define BENCHMARK_PRINTF printf
+#endif
+#else
+#ifndef BENCHMARK_PRINTF
+#define BENCHMARK_PRINTF PRINTF
+#endif
+#endif
+
+/*! @brief benchmark block size, the transfer size and the region are united as block */
+#define BENCHMARK_BLOCK_SIZE (512U)
+/*! @brief maximum request count submitted by one queued transfer */
+#define BENCHMARK_MAX_QUEUE_REQUEST (32U)
+/*! @brief prefix of the result rows, the rows are comma separated values */
+#define BENCHMARK_ROW_PREFIX "BENCH"
+
+/*! @brief benchmark access pattern */
+enum _benchmark_pattern
+{
+    kBENCHMARK_SequentialRead  = 1U << 0U, /*!< sequential read */
+    kBENCHMARK_SequentialWrite = 1U << 1U, /*!< sequential write */
+    kBENCHMARK_RandomRead      = 1U << 2U, /*!< random read aligned to the transfer size */
+    kBENCHMARK_RandomWrite     = 1U << 3U, /*!< random write aligned to the transfer size */
+
+    kBENCHMARK_ReadPatterns = kBENCHMARK_SequentialRead | kBENCHMARK_RandomRead, /*!< read patterns */
+    kBENCHMARK_AllPatterns  = 0xFU,                                                /*!< all patterns */
+};
+
+/*! @brief benchmark queued request */
+typedef struct _benchmark_request
+{
+    uint8_t *buffer;     /*!< data buffer */
+    uint32_t startBlock; /*!< start block */
+    uint32_t blockCount; /*!< block count */
+    bool isWrite;        /*!< true is write request */
+} benchmark_request_t;
+
+/*! @brief benchmark device
+ *
+ * The device is the only interface between the benchmark and the card, so the same sweep runs on the card driver
+ * of the target and on the simulated card of the host build.
+ */
+typedef struct _benchmark_device
+{
+    const char *name;       /*!< device name printed in the result rows */
+    void *context;          /*!< context passed to the device functions */
+    uint32_t blockCount;    /*!< device capacity in BENCHMARK_BLOCK_SIZE blocks */
+    uint32_t timingCount;   /*!< bus timing count, the timings are swept from 0 to timingCount - 1 */
+    uint32_t maxQueueDepth; /*!< queue depth supported by the current timing, updated by setTiming */
+
+    /*! name of the bus timing */
+    const char *(*getTimingName)(void *context, uint32_t timing);
+    /*! switch to the bus timing, any failure skips the timing, such as the card falls back to the other timing */
+    status_t (*setTiming)(void *context, uint32_t timing);
+    /*! switch the queue depth of the following transfers, it is called out of the measurement, optional */
+    status_t (*setQueueDepth)(void *context, uint32_t queueDepth);
+    /*! blocking transfer */
+    status_t (*transfer)(void *context, uint8_t *buffer, uint32_t startBlock, uint32_t blockCount, bool isWrite);
+    /*! blocking queued transfer, the requests are kept in flight up to the queue depth, optional */
+    status_t (*transferQueue)(void *context, benchmark_request_t *request, uint32_t requestCount);
+} benchmark_device_t;
+
+/*! @brief benchmark cycle counter */
+typedef uint32_t (*benchmark_get_cycles_t)(void);
+
+/*! @brief benchmark configuration */
+typedef struct _benchmark_config
+{
+    uint32_t patterns;      /*!< pattern mask, reference _benchmark_pattern */
+    uint32_t minSize;       /*!< minimum transfer size in bytes, power of 2 multiple of BENCHMARK_BLOCK_SIZE */
+    uint32_t maxSize;       /*!< maximum transfer size in bytes, the size is doubled from the minimum size */
+    uint32_t pointBytes;    /*!< bytes transferred by each result row, limited by minLoops and maxLoops */
+    uint32_t minLoops;      /*!< minimum transfer count of each result row */
+    uint32_t maxLoops;      /*!< maximum transfer count of each result row */
+    uint32_t maxQueueDepth; /*!< maximum queue depth of the sweep, the depth is doubled from 1 */
+    uint32_t startBlock;    /*!< first block of the region, the data is destroyed by the write patterns */
+    uint32_t regionBlocks;  /*!< region size in blocks, the random offsets are spread over the region */
+    uint32_t seed;          /*!< seed of the random offsets and the write data */
+    uint8_t *buffer;        /*!< data buffer shared by the transfers, aligned as the host DMA requires */
+    uint32_t bufferSize;    /*!< data buffer size, the larger transfer size is skipped */
+    benchmark_get_cycles_t getCycles; /*!< free running 32 bit cycle counter */
+    uint32_t cyclesPerUs;             /*!< cycle counter frequency in MHz */
+} benchmark_config_t;
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*!
+ * @brief Gets the default benchmark configuration.
+ *
+ * The default configuration sweeps all patterns from 512 B to 4 MiB with queue depth up to 32 over a 64 MiB
+ * region. The sweep destroys the data in the region, so the caller must place it by startBlock, which is left 0 here,
+ * the example main.c puts it at the end of the card. The application should also set the buffer and the cycle counter.
+ *
+ * @param config benchmark configuration.
+ */
+void BENCHMARK_GetDefaultConfig(benchmark_config_t *config);
+
+/*!
+ * @brief Runs the benchmark sweep.
+ *
+ * For each bus timing, pattern, queue depth and transfer size, the transfers are timed one by one by the cycle
+ * counter and one result row is printed:
+ *
+ * BENCH,device,timing,pattern,queue_depth,size,count,bytes,us,kibps,iops,lat_avg_us,lat_min_us,lat_max_us,status
+ *
+ * The latency is the time of one transfer at queue depth 1 and the time of one queued request on average at the
+ * larger queue depth. The header row is printed first, the other lines start with '#'. The sweep stops at the first
+ * transfer error, the failed row is printed with the error status.
+ *
+ * @param device benchmark device.
+ * @param config benchmark configuration.
+ * @retval kStatus_Success the sweep is complete.
+ * @retval kStatus_InvalidArgument invalid configuration.
+ * @retval other the transfer error.
+ */
+status_t BENCHMARK_Run(benchmark_device_t *device, const benchmark_config_t *config);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* _SDMMC_BENCHMARK_H_ */
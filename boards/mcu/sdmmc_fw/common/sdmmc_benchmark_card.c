@@ -0,0 +1,216 @@
+/*
+ * Copyright 2020 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "sdmmc_benchmark_card.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+#ifdef SD_ENABLED
+/*! @brief SD bus timings of the sweep, the card init falls back from the requested timing if it is not supported */
+static const sd_timing_mode_t s_benchmarkSDTiming[] = {kSD_TimingSDR104Mode, kSD_TimingDDR50Mode, kSD_TimingSDR50Mode,
+                                                       kSD_TimingSDR25HighSpeedMode};
+/*! @brief SD bus timing name */
+static const char *const s_benchmarkSDTimingName[] = {"SDR104", "DDR50", "SDR50", "SDR25"};
+#endif
+
+#ifdef MMC_ENABLED
+/*! @brief MMC bus timings of the sweep, the card init falls back from the requested timing if it is not supported */
+static const mmc_high_speed_timing_t s_benchmarkMMCTiming[] = {kMMC_EnhanceHighSpeed400Timing, kMMC_HighSpeed400Timing,
+                                                               kMMC_HighSpeed200Timing, kMMC_HighSpeedTiming};
+/*! @brief MMC bus timing name */
+static const char *const s_benchmarkMMCTimingName[] = {"HS400ES", "HS400", "HS200", "HS"};
+#endif
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+#ifdef SD_ENABLED
+static const char *BENCHMARK_SDGetTimingName(void *context, uint32_t timing)
+{
+    return s_benchmarkSDTimingName[timing];
+}
+
+static status_t BENCHMARK_SDSetTiming(void *context, uint32_t timing)
+{
+    sd_card_t *card = ((benchmark_sd_device_t *)context)->card;
+    status_t error  = kStatus_Success;
+
+    /* power cycle the card to re-initialize it from the default speed */
+    SD_CardDeinit(card);
+    card->currentTiming = s_benchmarkSDTiming[timing];
+    error               = SD_CardInit(card);
+    if ((error == kStatus_Success) && (card->currentTiming != s_benchmarkSDTiming[timing]))
+    {
+        error = kStatus_SDMMC_NotSupportYet;
+    }
+
+    return error;
+}
+
+static status_t BENCHMARK_SDTransfer(
+    void *context, uint8_t *buffer, uint32_t startBlock, uint32_t blockCount, bool isWrite)
+{
+    sd_card_t *card = ((benchmark_sd_device_t *)context)->card;
+
+    if (isWrite)
+    {
+        return SD_WriteBlocks(card, buffer, startBlock, blockCount);
+    }
+
+    return SD_ReadBlocks(card, buffer, startBlock, blockCount);
+}
+
+void BENCHMARK_SDDeviceInit(benchmark_sd_device_t *sdDevice, sd_card_t *card)
+{
+    assert(sdDevice != NULL);
+    assert(card != NULL);
+    assert(card->blockSize == BENCHMARK_BLOCK_SIZE);
+
+    (void)memset(sdDevice, 0, sizeof(benchmark_sd_device_t));
+
+    sdDevice->card                 = card;
+    sdDevice->device.name          = "sd";
+    sdDevice->device.context       = sdDevice;
+    sdDevice->device.blockCount    = card->blockCount;
+    sdDevice->device.timingCount   = ARRAY_SIZE(s_benchmarkSDTiming);
+    sdDevice->device.maxQueueDepth = 1U;
+    sdDevice->device.getTimingName = BENCHMARK_SDGetTimingName;
+    sdDevice->device.setTiming     = BENCHMARK_SDSetTiming;
+    sdDevice->device.transfer      = BENCHMARK_SDTransfer;
+}
+#endif
+
+#ifdef MMC_ENABLED
+static const char *BENCHMARK_MMCGetTimingName(void *context, uint32_t timing)
+{
+    return s_benchmarkMMCTimingName[timing];
+}
+
+static status_t BENCHMARK_MMCSetQueueDepth(void *context, uint32_t queueDepth)
+{
+    benchmark_mmc_device_t *mmcDevice = (benchmark_mmc_device_t *)context;
+    mmc_card_t *card                  = mmcDevice->card;
+    status_t error                    = kStatus_Success;
+
+    if (queueDepth > mmcDevice->cmdqDepth)
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    /* queue depth 1 is transferred by the legacy CMD18/CMD25 */
+    if ((queueDepth > 1U) != mmcDevice->isQueueEnabled)
+    {
+        card->cmdqDepth = mmcDevice->cmdqDepth;
+        error           = MMC_EnableCommandQueue(card, queueDepth > 1U);
+        if (error != kStatus_Success)
+        {
+            return error;
+        }
+        mmcDevice->isQueueEnabled = queueDepth > 1U;
+    }
+
+    if (queueDepth > 1U)
+    {
+        /* limit the number of tasks queued in the card */
+        card->cmdqDepth = queueDepth;
+    }
+
+    return kStatus_Success;
+}
+
+static status_t BENCHMARK_MMCSetTiming(void *context, uint32_t timing)
+{
+    benchmark_mmc_device_t *mmcDevice = (benchmark_mmc_device_t *)context;
+    mmc_card_t *card                  = mmcDevice->card;
+    status_t error                    = kStatus_Success;
+
+    (void)BENCHMARK_MMCSetQueueDepth(context, 1U);
+
+    /* power cycle the card to re-initialize it from the legacy timing */
+    MMC_CardDeinit(card);
+    MMC_HostDoReset(card);
+    MMC_SetCardPower(card, false);
+    MMC_SetCardPower(card, true);
+    card->busTiming = s_benchmarkMMCTiming[timing];
+    error           = MMC_CardInit(card);
+    if ((error == kStatus_Success) && (card->busTiming != s_benchmarkMMCTiming[timing]))
+    {
+        error = kStatus_SDMMC_NotSupportYet;
+    }
+
+    mmcDevice->isQueueEnabled = false;
+    mmcDevice->cmdqDepth      = 1U;
+    if ((card->flags & (uint32_t)kMMC_SupportCommandQueueFlag) != 0U)
+    {
+        mmcDevice->cmdqDepth = card->cmdqDepth;
+    }
+    mmcDevice->device.maxQueueDepth = mmcDevice->cmdqDepth;
+
+    return error;
+}
+
+static status_t BENCHMARK_MMCTransfer(
+    void *context, uint8_t *buffer, uint32_t startBlock, uint32_t blockCount, bool isWrite)
+{
+    mmc_card_t *card = ((benchmark_mmc_device_t *)context)->card;
+
+    if (isWrite)
+    {
+        return MMC_WriteBlocks(card, buffer, startBlock, blockCount);
+    }
+
+    return MMC_ReadBlocks(card, buffer, startBlock, blockCount);
+}
+
+static status_t BENCHMARK_MMCTransferQueue(void *context, benchmark_request_t *request, uint32_t requestCount)
+{
+    benchmark_mmc_device_t *mmcDevice = (benchmark_mmc_device_t *)context;
+    uint32_t i;
+
+    assert(requestCount <= BENCHMARK_MAX_QUEUE_REQUEST);
+
+    for (i = 0U; i < requestCount; i++)
+    {
+        mmcDevice->task[i].buffer              = request[i].buffer;
+        mmcDevice->task[i].startBlock          = request[i].startBlock;
+        mmcDevice->task[i].blockCount          = request[i].blockCount;
+        mmcDevice->task[i].isWrite             = request[i].isWrite;
+        mmcDevice->task[i].isHighPriority      = false;
+        mmcDevice->task[i].isForcedProgramming = false;
+        mmcDevice->task[i].isReliableWrite     = false;
+    }
+
+    return MMC_CommandQueueTransfer(mmcDevice->card, mmcDevice->task, requestCount);
+}
+
+void BENCHMARK_MMCDeviceInit(benchmark_mmc_device_t *mmcDevice, mmc_card_t *card)
+{
+    assert(mmcDevice != NULL);
+    assert(card != NULL);
+    assert(card->blockSize == BENCHMARK_BLOCK_SIZE);
+
+    (void)memset(mmcDevice, 0, sizeof(benchmark_mmc_device_t));
+
+    mmcDevice->card                 = card;
+    mmcDevice->cmdqDepth            = 1U;
+    mmcDevice->device.name          = "mmc";
+    mmcDevice->device.context       = mmcDevice;
+    mmcDevice->device.blockCount    = card->userPartitionBlocks;
+    mmcDevice->device.timingCount   = ARRAY_SIZE(s_benchmarkMMCTiming);
+    mmcDevice->device.maxQueueDepth = 1U;
+    mmcDevice->device.getTimingName = BENCHMARK_MMCGetTimingName;
+    mmcDevice->device.setTiming     = BENCHMARK_MMCSetTiming;
+    mmcDevice->device.setQueueDepth = BENCHMARK_MMCSetQueueDepth;
+    mmcDevice->device.transfer      = BENCHMARK_MMCTransfer;
+    mmcDevice->device.transferQueue = BENCHMARK_MMCTransferQueue;
+}
+#endif
@@ -0,0 +1,78 @@
+/*
+ * Copyright 2020 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _SDMMC_BENCHMARK_CARD_H_
+#define _SDMMC_BENCHMARK_CARD_H_
+
+#include "sdmmc_benchmark.h"
+#ifdef SD_ENABLED
+#include "fsl_sd.h"
+#endif
+#ifdef MMC_ENABLED
+#include "fsl_mmc.h"
+#endif
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#ifdef SD_ENABLED
+/*! @brief benchmark device of the SD card, the bus timing is forced by the card re-initialization */
+typedef struct _benchmark_sd_device
+{
+    benchmark_device_t device; /*!< benchmark device */
+    sd_card_t *card;           /*!< card descriptor, the host should be initialized */
+} benchmark_sd_device_t;
+#endif
+
+#ifdef MMC_ENABLED
+/*! @brief benchmark device of the MMC card, the queue depth larger than 1 is transferred by the command queue */
+typedef struct _benchmark_mmc_device
+{
+    benchmark_device_t device;                        /*!< benchmark device */
+    mmc_card_t *card;                                 /*!< card descriptor, the host should be initialized */
+    uint32_t cmdqDepth;                               /*!< command queue depth supported by the card */
+    bool isQueueEnabled;                              /*!< command queue is enabled */
+    mmc_cmdq_task_t task[BENCHMARK_MAX_QUEUE_REQUEST]; /*!< command queue tasks */
+} benchmark_mmc_device_t;
+#endif
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#ifdef SD_ENABLED
+/*!
+ * @brief Initializes the benchmark device of the SD card.
+ *
+ * The card should be initialized once before, the bus timings are swept from SDR104 to SDR25.
+ *
+ * @param sdDevice SD benchmark device.
+ * @param card initialized card descriptor.
+ */
+void BENCHMARK_SDDeviceInit(benchmark_sd_device_t *sdDevice, sd_card_t *card);
+#endif
+
+#ifdef MMC_ENABLED
+/*!
+ * @brief Initializes the benchmark device of the MMC card.
+ *
+ * The card should be initialized once before, the bus timings are swept from HS400 enhanced strobe to high speed.
+ *
+ * @param mmcDevice MMC benchmark device.
+ * @param card initialized card descriptor.
+ */
+void BENCHMARK_MMCDeviceInit(benchmark_mmc_device_t *mmcDevice, mmc_card_t *card);
+#endif
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* _SDMMC_BENCHMARK_CARD_H_ */
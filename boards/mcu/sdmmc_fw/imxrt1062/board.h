@@ -193,9 +193,6 @@ status_t BOARD_Touch_I2C_Receive(
     uint8_t deviceAddress, uint32_t subAddress, uint8_t subAddressSize, uint8_t *rxBuff, uint8_t rxBuffSize);
 #endif /* SDK_I2C_BASED_COMPONENT_USED */
 
-void BOARD_SD_Pin_Config(uint32_t speed, uint32_t strength);
-void BOARD_MMC_Pin_Config(uint32_t speed, uint32_t strength);
-
 #if defined(__cplusplus)
 }
 #endif /* __cplusplus */
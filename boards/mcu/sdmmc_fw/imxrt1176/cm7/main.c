@@ -1,6 +1,6 @@
 /*
  * Copyright (c) 2013 - 2015, Freescale Semiconductor, Inc.
- * Copyright 2016-2017 NXP
+ * Copyright 2016-2017, 2020 NXP
  * All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
@@ -11,37 +11,152 @@
 #include "pin_mux.h"
 #include "clock_config.h"
 #include "board.h"
+#include "sdmmc_config.h"
+#include "sdmmc_benchmark_card.h"
 
 /*******************************************************************************
  * Definitions
  ******************************************************************************/
-
+/*! @brief Benchmark data buffer size, the maximum transfer size of the sweep is limited to it */
+#ifndef BENCHMARK_BUFFER_SIZE
+#define BENCHMARK_BUFFER_SIZE (64U * 1024U)
+#endif
 
 /*******************************************************************************
  * Prototypes
  ******************************************************************************/
 
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+#if defined(MMC_ENABLED)
+/*! @brief Card descriptor. */
+static mmc_card_t s_card;
+/*! @brief Benchmark device. */
+static benchmark_mmc_device_t s_benchmarkDevice;
+#else
+/*! @brief Card descriptor. */
+static sd_card_t s_card;
+/*! @brief Benchmark device. */
+static benchmark_sd_device_t s_benchmarkDevice;
+#endif
+
+/*! @brief Benchmark data buffer */
+SDK_ALIGN(static uint8_t s_benchmarkBuffer[BENCHMARK_BUFFER_SIZE], BOARD_SDMMC_DATA_BUFFER_ALIGN_SIZE);
+
 /*******************************************************************************
  * Code
  ******************************************************************************/
+static void BenchmarkTimerInit(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0U;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+static uint32_t BenchmarkGetCycles(void)
+{
+    return DWT->CYCCNT;
+}
+
+static status_t BenchmarkCardInit(benchmark_config_t *config)
+{
+#if defined(MMC_ENABLED)
+    BOARD_MMC_Config(&s_card, BOARD_SDMMC_MMC_HOST_IRQ_PRIORITY);
+
+    if (MMC_Init(&s_card) != kStatus_Success)
+    {
+        PRINTF("\r\nMMC card init failed.\r\n");
+        return kStatus_Fail;
+    }
+
+    BENCHMARK_MMCDeviceInit(&s_benchmarkDevice, &s_card);
+#else
+    BOARD_SD_Config(&s_card, NULL, BOARD_SDMMC_SD_HOST_IRQ_PRIORITY, NULL);
+
+    if (SD_HostInit(&s_card) != kStatus_Success)
+    {
+        PRINTF("\r\nSD host init failed.\r\n");
+        return kStatus_Fail;
+    }
+
+    PRINTF("\r\nPlease insert a card into board.\r\n");
+    /* wait card insert */
+    SD_PollingCardInsert(&s_card, kSD_Inserted);
+    /* power cycle the card */
+    SD_SetCardPower(&s_card, false);
+    SD_SetCardPower(&s_card, true);
+
+    if (SD_CardInit(&s_card) != kStatus_Success)
+    {
+        PRINTF("\r\nSD card init failed.\r\n");
+        return kStatus_Fail;
+    }
+
+    if (SD_CheckReadOnly(&s_card))
+    {
+        PRINTF("\r\nCard is write protected, the write patterns are skipped.\r\n");
+        config->patterns &= (uint32_t)kBENCHMARK_ReadPatterns;
+    }
+
+    BENCHMARK_SDDeviceInit(&s_benchmarkDevice, &s_card);
+#endif
+
+    return kStatus_Success;
+}
+
 /*!
  * @brief Main function
  */
 int main(void)
 {
-    char ch;
+    benchmark_config_t config;
+    char ch = '0';
 
     /* Init board hardware. */
     BOARD_ConfigMPU();
     BOARD_InitPins();
     BOARD_BootClockRUN();
     BOARD_InitDebugConsole();
+    BenchmarkTimerInit();
 
-    PRINTF("hello world.\r\n");
+    PRINTF("\r\nSDMMC benchmark firmware.\r\n");
 
-    while (1)
+    BENCHMARK_GetDefaultConfig(&config);
+    if (BenchmarkCardInit(&config) != kStatus_Success)
+    {
+        return -1;
+    }
+
+    /* the benchmark region is at the end of the card */
+    if (config.regionBlocks > s_benchmarkDevice.device.blockCount)
+    {
+        config.regionBlocks = s_benchmarkDevice.device.blockCount;
+    }
+    config.startBlock  = s_benchmarkDevice.device.blockCount - config.regionBlocks;
+    config.buffer      = s_benchmarkBuffer;
+    config.bufferSize  = sizeof(s_benchmarkBuffer);
+    config.getCycles   = BenchmarkGetCycles;
+    config.cyclesPerUs = SystemCoreClock / 1000000U;
+
+    PRINTF("\r\nData in blocks %d - %d will be destroyed.\r\n", config.startBlock,
+           config.startBlock + config.regionBlocks - 1U);
+
+    while (ch != 'q')
     {
+        if (BENCHMARK_Run(&s_benchmarkDevice.device, &config) != kStatus_Success)
+        {
+            break;
+        }
+
+        PRINTF("\r\nInput 'q' to quit benchmark.\r\nInput other char to run benchmark again.\r\n");
         ch = GETCHAR();
         PUTCHAR(ch);
     }
+
+    PRINTF("\r\nThe firmware will not run benchmark again.\r\n");
+
+    while (1)
+    {
+    }
 }
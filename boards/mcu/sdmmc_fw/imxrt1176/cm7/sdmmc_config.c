@@ -0,0 +1,300 @@
+/*
+ * Copyright 2020-2022 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "sdmmc_config.h"
+#include "fsl_iomuxc.h"
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief GPIO_SD_B1 pad configuration: high drive strength, pull up */
+#define BOARD_SDMMC_SD_PAD_PULL_UP (0x04U)
+/*! @brief GPIO_SD_B1 pad configuration: high drive strength, pull down */
+#define BOARD_SDMMC_SD_PAD_PULL_DOWN (0x08U)
+/*! @brief GPIO_SD_B1 pad configuration: high drive strength, no pull */
+#define BOARD_SDMMC_SD_PAD_NO_PULL (0x0CU)
+/*! @brief GPIO_AD pad configuration: high drive strength, pull up */
+#define BOARD_SDMMC_GPIO_PAD_PULL_UP (0x0EU)
+/*! @brief GPIO_AD pad configuration: high drive strength, no pull */
+#define BOARD_SDMMC_GPIO_PAD_NO_PULL (0x02U)
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+void BOARD_SDCardPowerControl(bool enable);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+/*!brief sdmmc dma buffer */
+AT_NONCACHEABLE_SECTION_ALIGN(static uint32_t s_sdmmcHostDmaBuffer[BOARD_SDMMC_HOST_DMA_DESCRIPTOR_BUFFER_SIZE],
+                              SDMMCHOST_DMA_DESCRIPTOR_BUFFER_ALIGN_SIZE);
+#if defined SDMMCHOST_ENABLE_CACHE_LINE_ALIGN_TRANSFER && SDMMCHOST_ENABLE_CACHE_LINE_ALIGN_TRANSFER
+/* two cache line length for sdmmc host driver maintain unalign transfer */
+SDK_ALIGN(static uint8_t s_sdmmcCacheLineAlignBuffer[BOARD_SDMMC_DATA_BUFFER_ALIGN_SIZE * 2U],
+          BOARD_SDMMC_DATA_BUFFER_ALIGN_SIZE);
+#endif
+#if defined(SDIO_ENABLED) || defined(SD_ENABLED)
+static sd_detect_card_t s_cd;
+static sd_io_voltage_t s_ioVoltage = {
+    .type = BOARD_SDMMC_SD_IO_VOLTAGE_CONTROL_TYPE,
+    .func = NULL,
+};
+#endif
+static sdmmchost_t s_host;
+#ifdef SDIO_ENABLED
+static sdio_card_int_t s_sdioInt;
+#endif
+
+GPIO_HANDLE_DEFINE(s_CardDetectGpioHandle);
+GPIO_HANDLE_DEFINE(s_PowerResetGpioHandle);
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+uint32_t BOARD_USDHC1ClockConfiguration(void)
+{
+    clock_root_config_t rootCfg = {0};
+
+    /* SYS PLL2 PFD2 is configured to 528MHZ * 18 / 24 = 396 MHZ by BOARD_BootClockRUN, USDHC clock root frequency
+     * maximum: 198MHZ */
+    rootCfg.mux = kCLOCK_USDHC1_ClockRoot_MuxSysPll2Pfd2;
+    rootCfg.div = 2U;
+    CLOCK_SetRootClock(kCLOCK_Root_Usdhc1, &rootCfg);
+
+    return CLOCK_GetRootClockFreq(kCLOCK_Root_Usdhc1);
+}
+
+static void BOARD_USDHC1PinConfig(void)
+{
+    /* the GPIO_SD_B1 pads have no speed field, they are kept in high drive strength for all the bus timings */
+    IOMUXC_SetPinMux(IOMUXC_GPIO_SD_B1_00_USDHC1_CMD, 1U);
+    IOMUXC_SetPinMux(IOMUXC_GPIO_SD_B1_01_USDHC1_CLK, 1U);
+    IOMUXC_SetPinMux(IOMUXC_GPIO_SD_B1_02_USDHC1_DATA0, 1U);
+    IOMUXC_SetPinMux(IOMUXC_GPIO_SD_B1_03_USDHC1_DATA1, 1U);
+    IOMUXC_SetPinMux(IOMUXC_GPIO_SD_B1_04_USDHC1_DATA2, 1U);
+    IOMUXC_SetPinMux(IOMUXC_GPIO_SD_B1_05_USDHC1_DATA3, 1U);
+    IOMUXC_SetPinMux(IOMUXC_GPIO_AD_34_USDHC1_VSELECT, 0U);
+    IOMUXC_SetPinConfig(IOMUXC_GPIO_SD_B1_00_USDHC1_CMD, BOARD_SDMMC_SD_PAD_PULL_UP);
+    IOMUXC_SetPinConfig(IOMUXC_GPIO_SD_B1_01_USDHC1_CLK, BOARD_SDMMC_SD_PAD_NO_PULL);
+    IOMUXC_SetPinConfig(IOMUXC_GPIO_SD_B1_02_USDHC1_DATA0, BOARD_SDMMC_SD_PAD_PULL_UP);
+    IOMUXC_SetPinConfig(IOMUXC_GPIO_SD_B1_03_USDHC1_DATA1, BOARD_SDMMC_SD_PAD_PULL_UP);
+    IOMUXC_SetPinConfig(IOMUXC_GPIO_SD_B1_04_USDHC1_DATA2, BOARD_SDMMC_SD_PAD_PULL_UP);
+    IOMUXC_SetPinConfig(IOMUXC_GPIO_SD_B1_05_USDHC1_DATA3, BOARD_SDMMC_SD_PAD_PULL_UP);
+    IOMUXC_SetPinConfig(IOMUXC_GPIO_AD_34_USDHC1_VSELECT, BOARD_SDMMC_GPIO_PAD_NO_PULL);
+}
+
+#if defined(SDIO_ENABLED) || defined(SD_ENABLED)
+bool BOARD_SDCardGetDetectStatus(void)
+{
+    uint8_t pinState;
+
+    if (HAL_GpioGetInput(s_CardDetectGpioHandle, &pinState) == kStatus_HAL_GpioSuccess)
+    {
+        if (pinState == BOARD_SDMMC_SD_CD_INSERT_LEVEL)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+void SDMMC_SD_CD_Callback(void *param)
+{
+    if (s_cd.callback != NULL)
+    {
+        s_cd.callback(BOARD_SDCardGetDetectStatus(), s_cd.userData);
+    }
+}
+
+void BOARD_SDCardDAT3PullFunction(uint32_t status)
+{
+    if (status == kSD_DAT3PullDown)
+    {
+        IOMUXC_SetPinConfig(IOMUXC_GPIO_SD_B1_05_USDHC1_DATA3, BOARD_SDMMC_SD_PAD_PULL_DOWN);
+    }
+    else
+    {
+        IOMUXC_SetPinConfig(IOMUXC_GPIO_SD_B1_05_USDHC1_DATA3, BOARD_SDMMC_SD_PAD_PULL_UP);
+    }
+}
+
+void BOARD_SDCardDetectInit(sd_cd_t cd, void *userData)
+{
+    uint8_t pinState;
+
+    /* install card detect callback */
+    s_cd.cdDebounce_ms = BOARD_SDMMC_SD_CARD_DETECT_DEBOUNCE_DELAY_MS;
+    s_cd.type          = BOARD_SDMMC_SD_CD_TYPE;
+    s_cd.cardDetected  = BOARD_SDCardGetDetectStatus;
+    s_cd.callback      = cd;
+    s_cd.userData      = userData;
+
+    if (BOARD_SDMMC_SD_CD_TYPE == kSD_DetectCardByGpioCD)
+    {
+        hal_gpio_pin_config_t sw_config = {
+            kHAL_GpioDirectionIn,
+            0,
+            BOARD_SDMMC_SD_CD_GPIO_PORT,
+            BOARD_SDMMC_SD_CD_GPIO_PIN,
+        };
+
+        IOMUXC_SetPinMux(IOMUXC_GPIO_AD_32_GPIO_MUX3_IO31, 0U);
+        IOMUXC_SetPinConfig(IOMUXC_GPIO_AD_32_GPIO_MUX3_IO31, BOARD_SDMMC_GPIO_PAD_PULL_UP);
+
+        HAL_GpioInit(s_CardDetectGpioHandle, &sw_config);
+        HAL_GpioSetTriggerMode(s_CardDetectGpioHandle, BOARD_SDMMC_SD_CD_INTTERUPT_TYPE);
+        HAL_GpioInstallCallback(s_CardDetectGpioHandle, SDMMC_SD_CD_Callback, NULL);
+
+        if (HAL_GpioGetInput(s_CardDetectGpioHandle, &pinState) == kStatus_HAL_GpioSuccess)
+        {
+            if (pinState == BOARD_SDMMC_SD_CD_INSERT_LEVEL)
+            {
+                if (cd != NULL)
+                {
+                    cd(true, userData);
+                }
+            }
+        }
+    }
+
+    /* register DAT3 pull function switch function pointer */
+    if (BOARD_SDMMC_SD_CD_TYPE == kSD_DetectCardByHostDATA3)
+    {
+        s_cd.dat3PullFunc = BOARD_SDCardDAT3PullFunction;
+        /* make sure the card is power on for DAT3 pull up */
+        BOARD_SDCardPowerControl(true);
+    }
+}
+
+void BOARD_SDCardPowerResetInit(void)
+{
+    hal_gpio_pin_config_t sw_config = {
+        kHAL_GpioDirectionOut,
+        1,
+        BOARD_SDMMC_SD_POWER_RESET_GPIO_PORT,
+        BOARD_SDMMC_SD_POWER_RESET_GPIO_PIN,
+    };
+
+    IOMUXC_SetPinMux(IOMUXC_GPIO_AD_35_GPIO10_IO02, 0U);
+    IOMUXC_SetPinConfig(IOMUXC_GPIO_AD_35_GPIO10_IO02, BOARD_SDMMC_GPIO_PAD_NO_PULL);
+
+    HAL_GpioInit(s_PowerResetGpioHandle, &sw_config);
+}
+
+void BOARD_SDCardPowerControl(bool enable)
+{
+    if (enable)
+    {
+        HAL_GpioSetOutput(s_PowerResetGpioHandle, 1);
+    }
+    else
+    {
+        /* Power off the card only when the card is inserted, since the card detect circuit is depend on the power on
+         * the EVK, card detect will not work if the power is off */
+        if (BOARD_SDCardGetDetectStatus() == true)
+        {
+            HAL_GpioSetOutput(s_PowerResetGpioHandle, 0);
+        }
+    }
+}
+#endif
+
+#ifdef SD_ENABLED
+void BOARD_SD_Config(void *card, sd_cd_t cd, uint32_t hostIRQPriority, void *userData)
+{
+    assert(card);
+
+    s_host.dmaDesBuffer         = s_sdmmcHostDmaBuffer;
+    s_host.dmaDesBufferWordsNum = BOARD_SDMMC_HOST_DMA_DESCRIPTOR_BUFFER_SIZE;
+    s_host.enableCacheControl   = BOARD_SDMMC_HOST_CACHE_CONTROL;
+#if defined SDMMCHOST_ENABLE_CACHE_LINE_ALIGN_TRANSFER && SDMMCHOST_ENABLE_CACHE_LINE_ALIGN_TRANSFER
+    s_host.cacheAlignBuffer     = s_sdmmcCacheLineAlignBuffer;
+    s_host.cacheAlignBufferSize = BOARD_SDMMC_DATA_BUFFER_ALIGN_SIZE * 2U;
+#endif
+
+    BOARD_USDHC1PinConfig();
+
+    ((sd_card_t *)card)->host                                = &s_host;
+    ((sd_card_t *)card)->host->hostController.base           = BOARD_SDMMC_SD_HOST_BASEADDR;
+    ((sd_card_t *)card)->host->hostController.sourceClock_Hz = BOARD_USDHC1ClockConfiguration();
+
+    ((sd_card_t *)card)->usrParam.cd         = &s_cd;
+    ((sd_card_t *)card)->usrParam.pwr        = BOARD_SDCardPowerControl;
+    ((sd_card_t *)card)->usrParam.ioStrength = NULL;
+    ((sd_card_t *)card)->usrParam.ioVoltage  = &s_ioVoltage;
+    ((sd_card_t *)card)->usrParam.maxFreq    = BOARD_SDMMC_SD_HOST_SUPPORT_SDR104_FREQ;
+
+    BOARD_SDCardPowerResetInit();
+    BOARD_SDCardDetectInit(cd, userData);
+
+    NVIC_SetPriority(BOARD_SDMMC_SD_HOST_IRQ, hostIRQPriority);
+}
+#endif
+
+#ifdef SDIO_ENABLED
+void BOARD_SDIO_Config(void *card, sd_cd_t cd, uint32_t hostIRQPriority, sdio_int_t cardInt)
+{
+    assert(card);
+
+    s_host.dmaDesBuffer         = s_sdmmcHostDmaBuffer;
+    s_host.dmaDesBufferWordsNum = BOARD_SDMMC_HOST_DMA_DESCRIPTOR_BUFFER_SIZE;
+    s_host.enableCacheControl   = BOARD_SDMMC_HOST_CACHE_CONTROL;
+#if defined SDMMCHOST_ENABLE_CACHE_LINE_ALIGN_TRANSFER && SDMMCHOST_ENABLE_CACHE_LINE_ALIGN_TRANSFER
+    s_host.cacheAlignBuffer     = s_sdmmcCacheLineAlignBuffer;
+    s_host.cacheAlignBufferSize = BOARD_SDMMC_DATA_BUFFER_ALIGN_SIZE * 2U;
+#endif
+
+    BOARD_USDHC1PinConfig();
+
+    ((sdio_card_t *)card)->host                                = &s_host;
+    ((sdio_card_t *)card)->host->hostController.base           = BOARD_SDMMC_SDIO_HOST_BASEADDR;
+    ((sdio_card_t *)card)->host->hostController.sourceClock_Hz = BOARD_USDHC1ClockConfiguration();
+
+    ((sdio_card_t *)card)->usrParam.cd         = &s_cd;
+    ((sdio_card_t *)card)->usrParam.pwr        = BOARD_SDCardPowerControl;
+    ((sdio_card_t *)card)->usrParam.ioStrength = NULL;
+    ((sdio_card_t *)card)->usrParam.ioVoltage  = &s_ioVoltage;
+    ((sdio_card_t *)card)->usrParam.maxFreq    = BOARD_SDMMC_SD_HOST_SUPPORT_SDR104_FREQ;
+    if (cardInt != NULL)
+    {
+        s_sdioInt.cardInterrupt                 = cardInt;
+        ((sdio_card_t *)card)->usrParam.sdioInt = &s_sdioInt;
+    }
+
+    BOARD_SDCardPowerResetInit();
+    BOARD_SDCardDetectInit(cd, NULL);
+
+    NVIC_SetPriority(BOARD_SDMMC_SDIO_HOST_IRQ, hostIRQPriority);
+}
+#endif
+
+#ifdef MMC_ENABLED
+void BOARD_MMC_Config(void *card, uint32_t hostIRQPriority)
+{
+    assert(card);
+
+    s_host.dmaDesBuffer         = s_sdmmcHostDmaBuffer;
+    s_host.dmaDesBufferWordsNum = BOARD_SDMMC_HOST_DMA_DESCRIPTOR_BUFFER_SIZE;
+    s_host.enableCacheControl   = BOARD_SDMMC_HOST_CACHE_CONTROL;
+#if defined SDMMCHOST_ENABLE_CACHE_LINE_ALIGN_TRANSFER && SDMMCHOST_ENABLE_CACHE_LINE_ALIGN_TRANSFER
+    s_host.cacheAlignBuffer     = s_sdmmcCacheLineAlignBuffer;
+    s_host.cacheAlignBufferSize = BOARD_SDMMC_DATA_BUFFER_ALIGN_SIZE * 2U;
+#endif
+
+    /* the eMMC is accessed through the 4 bit SD slot */
+    BOARD_USDHC1PinConfig();
+
+    ((mmc_card_t *)card)->host                                = &s_host;
+    ((mmc_card_t *)card)->host->hostController.base           = BOARD_SDMMC_MMC_HOST_BASEADDR;
+    ((mmc_card_t *)card)->host->hostController.sourceClock_Hz = BOARD_USDHC1ClockConfiguration();
+    ((mmc_card_t *)card)->usrParam.ioStrength                 = NULL;
+    ((mmc_card_t *)card)->usrParam.maxFreq                    = BOARD_SDMMC_MMC_HOST_SUPPORT_HS200_FREQ;
+
+    ((mmc_card_t *)card)->hostVoltageWindowVCC  = BOARD_SDMMC_MMC_VCC_SUPPLY;
+    ((mmc_card_t *)card)->hostVoltageWindowVCCQ = BOARD_SDMMC_MMC_VCCQ_SUPPLY;
+
+    NVIC_SetPriority(BOARD_SDMMC_MMC_HOST_IRQ, hostIRQPriority);
+}
+#endif
@@ -0,0 +1,337 @@
+/*
+ * Copyright 2020 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "fsl_mmc.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief simulated card capacity in blocks */
+#define SIM_CARD_BLOCKS (1024U)
+/*! @brief simulated host maximum block count of one transfer */
+#define SIM_HOST_MAX_BLOCK_COUNT (64U)
+/*! @brief simulated reliable write sector count */
+#define SIM_RELIABLE_BLOCKS (8U)
+/*! @brief block count field of the CMD23 argument */
+#define SIM_SET_BLOCK_COUNT_MASK (0xFFFFU)
+/*! @brief write command log depth */
+#define SIM_WRITE_LOG_SIZE (16U)
+
+/*! @brief test check, report the failed line and fail the test case */
+#define SIM_CHECK(condition)                                                    \
+    do                                                                          \
+    {                                                                           \
+        if (!(condition))                                                       \
+        {                                                                       \
+            (void)printf("  check failed line %d: %s\n", __LINE__, #condition); \
+            return false;                                                       \
+        }                                                                       \
+    } while (false)
+
+/*! @brief one write command received by the simulated card */
+typedef struct _sim_write_log
+{
+    uint32_t startBlock; /*!< start block */
+    uint32_t blockCount; /*!< block count */
+    bool isReliable;     /*!< reliable write request flag set in CMD23 */
+} sim_write_log_t;
+
+/*! @brief simulated MMC card */
+typedef struct _sim_mmc_card
+{
+    uint8_t data[SIM_CARD_BLOCKS * FSL_SDMMC_DEFAULT_BLOCK_SIZE]; /*!< card content */
+    uint32_t setBlockCount;                                      /*!< CMD23 argument, 0 if not set */
+    sim_write_log_t writeLog[SIM_WRITE_LOG_SIZE];                /*!< received write commands */
+    uint32_t writeCount;                                         /*!< received write command count */
+} sim_mmc_card_t;
+
+/*! @brief test case */
+typedef struct _sim_test
+{
+    const char *name;   /*!< test name */
+    bool (*func)(void); /*!< test function */
+} sim_test_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+static status_t SIM_CardExecute(sdmmchost_transfer_t *content);
+static void SIM_TestReset(void);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+/*! @brief simulated host controller registers, the data line 0 is always high as the card is never busy */
+static USDHC_Type s_simUsdhc = {.PRES_STATE = (uint32_t)kUSDHC_Data0LineLevelFlag};
+/*! @brief simulated card, static to keep it below 4 GiB for the 32 bit address of the card driver */
+static sim_mmc_card_t s_simCard;
+/*! @brief host handler */
+static sdmmchost_t s_host;
+/*! @brief card descriptor */
+static mmc_card_t s_card;
+/*! @brief transfer buffer, one word more for the unaligned write */
+static uint32_t s_txBuffer[(SIM_RELIABLE_BLOCKS * 2U * FSL_SDMMC_DEFAULT_BLOCK_SIZE / sizeof(uint32_t)) + 1U];
+/*! @brief alignment buffer of the card descriptor */
+static uint32_t s_alignBuffer[SIM_RELIABLE_BLOCKS * FSL_SDMMC_DEFAULT_BLOCK_SIZE / sizeof(uint32_t)];
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+static status_t SIM_CardExecute(sdmmchost_transfer_t *content)
+{
+    sdmmchost_cmd_t *command = content->command;
+    sdmmchost_data_t *data   = content->data;
+    uint32_t setBlockCount   = 0U;
+    sim_write_log_t *log     = NULL;
+
+    /* R1 response of the card in transfer state, ready for data */
+    command->response[0U] = SDMMC_MASK(kSDMMC_R1ReadyForDataFlag) | ((uint32_t)kSDMMC_R1StateTransfer << 9U);
+
+    if (command->index == (uint32_t)kSDMMC_SetBlockCount)
+    {
+        s_simCard.setBlockCount = command->argument;
+        return kStatus_Success;
+    }
+
+    if (data == NULL)
+    {
+        return kStatus_Success;
+    }
+
+    /* CMD23 only applies to the data command right after it */
+    setBlockCount           = s_simCard.setBlockCount;
+    s_simCard.setBlockCount = 0U;
+
+    if ((command->argument + data->blockCount) > SIM_CARD_BLOCKS)
+    {
+        return kStatus_Fail;
+    }
+
+    if (data->rxData != NULL)
+    {
+        (void)memcpy((void *)(uintptr_t)data->rxData, &s_simCard.data[command->argument * FSL_SDMMC_DEFAULT_BLOCK_SIZE],
+                     data->blockCount * data->blockSize);
+        return kStatus_Success;
+    }
+
+    if (s_simCard.writeCount < SIM_WRITE_LOG_SIZE)
+    {
+        log             = &s_simCard.writeLog[s_simCard.writeCount];
+        log->startBlock = command->argument;
+        log->blockCount = data->blockCount;
+        log->isReliable = ((setBlockCount & MMC_SET_BLOCK_COUNT_RELIABLE_WRITE_MASK) != 0U) &&
+                          ((setBlockCount & SIM_SET_BLOCK_COUNT_MASK) == data->blockCount);
+    }
+    s_simCard.writeCount++;
+
+    (void)memcpy(&s_simCard.data[command->argument * FSL_SDMMC_DEFAULT_BLOCK_SIZE],
+                 (const void *)(uintptr_t)data->txData, data->blockCount * data->blockSize);
+
+    return kStatus_Success;
+}
+
+status_t SDMMCHOST_TransferFunction(sdmmchost_t *host, sdmmchost_transfer_t *content)
+{
+    return SIM_CardExecute(content);
+}
+
+status_t SDMMCHOST_ExecuteTuning(sdmmchost_t *host, uint32_t tuningCmd, uint32_t *revBuf, uint32_t blockSize)
+{
+    return kStatus_Success;
+}
+
+void SDMMCHOST_ConvertDataToLittleEndian(sdmmchost_t *host, uint32_t *data, uint32_t wordSize, uint32_t format)
+{
+}
+
+status_t SDMMCHOST_Init(sdmmchost_t *host)
+{
+    return kStatus_Success;
+}
+
+void SDMMCHOST_Deinit(sdmmchost_t *host)
+{
+}
+
+void SDMMCHOST_Reset(sdmmchost_t *host)
+{
+}
+
+void SDMMCHOST_SetCardPower(sdmmchost_t *host, bool enable)
+{
+}
+
+void SDMMCHOST_SetCardBusWidth(sdmmchost_t *host, uint32_t dataBusWidth)
+{
+}
+
+void SDMMCHOST_SwitchToVoltage(sdmmchost_t *host, uint32_t voltage)
+{
+}
+
+status_t SDMMCHOST_StartBoot(sdmmchost_t *host,
+                             sdmmchost_boot_config_t *hostConfig,
+                             sdmmchost_cmd_t *cmd,
+                             uint8_t *buffer)
+{
+    return kStatus_Fail;
+}
+
+status_t SDMMCHOST_ReadBootData(sdmmchost_t *host, sdmmchost_boot_config_t *hostConfig, uint8_t *buffer)
+{
+    return kStatus_Fail;
+}
+
+status_t SDMMCHOST_ReadBootDataAsync(sdmmchost_t *host,
+                                     sdmmchost_boot_config_t *hostConfig,
+                                     uint8_t *buffer,
+                                     sdmmchost_transfer_callback_t callback,
+                                     void *userData)
+{
+    return kStatus_Fail;
+}
+
+uint32_t USDHC_SetSdClock(USDHC_Type *base, uint32_t srcClock_Hz, uint32_t busClock_Hz)
+{
+    return busClock_Hz;
+}
+
+void USDHC_EnableDDRMode(USDHC_Type *base, bool enable, uint32_t nibblePos)
+{
+}
+
+bool USDHC_SetCardActive(USDHC_Type *base, uint32_t timeout)
+{
+    return true;
+}
+
+static void SIM_TestReset(void)
+{
+    uint32_t i;
+
+    (void)memset(&s_simCard, 0, sizeof(s_simCard));
+    for (i = 0U; i < sizeof(s_txBuffer) / sizeof(s_txBuffer[0]); i++)
+    {
+        s_txBuffer[i] = i * 0x9E3779B9U;
+    }
+
+    s_card.noInteralAlign                        = false;
+    s_card.alignBuffer                           = NULL;
+    s_card.alignBufferSize                       = 0U;
+    s_card.extendedCsd.writeReliabilityParameter = 0U;
+}
+
+static bool SIM_TestUnalignedReliableWriteRejected(void)
+{
+    const uint8_t *buffer = (const uint8_t *)s_txBuffer + 1U;
+
+    /* legacy reliable write, the aligned unit would be split into single blocks by the one block exchange buffer */
+    SIM_CHECK(MMC_WriteBlocksReliable(&s_card, buffer, 16U, SIM_RELIABLE_BLOCKS) == kStatus_InvalidArgument);
+    SIM_CHECK(s_simCard.writeCount == 0U);
+
+    /* enhanced reliable write, the exchange buffer smaller than the unit is rejected too */
+    s_card.extendedCsd.writeReliabilityParameter = MMC_WRITE_RELIABILITY_PARAMETER_EN_REL_WR_MASK;
+    s_card.alignBuffer                           = (uint8_t *)s_alignBuffer;
+    s_card.alignBufferSize                       = (SIM_RELIABLE_BLOCKS / 2U) * FSL_SDMMC_DEFAULT_BLOCK_SIZE;
+    SIM_CHECK(MMC_WriteBlocksReliable(&s_card, buffer, 16U, SIM_RELIABLE_BLOCKS) == kStatus_InvalidArgument);
+    SIM_CHECK(s_simCard.writeCount == 0U);
+
+    /* the units which fit the exchange buffer are still written */
+    SIM_CHECK(MMC_WriteBlocksReliable(&s_card, buffer, 20U, SIM_RELIABLE_BLOCKS / 2U) == kStatus_Success);
+    SIM_CHECK(s_simCard.writeCount == 1U);
+    SIM_CHECK(s_simCard.writeLog[0U].isReliable);
+
+    return true;
+}
+
+static bool SIM_TestUnalignedReliableWrite(void)
+{
+    const uint8_t *buffer = (const uint8_t *)s_txBuffer + 1U;
+    uint32_t size         = (SIM_RELIABLE_BLOCKS + 2U) * FSL_SDMMC_DEFAULT_BLOCK_SIZE;
+
+    /* legacy reliable write from block 15: single block, the aligned unit in one command, single block */
+    s_card.alignBuffer     = (uint8_t *)s_alignBuffer;
+    s_card.alignBufferSize = sizeof(s_alignBuffer);
+    SIM_CHECK(MMC_WriteBlocksReliable(&s_card, buffer, 15U, SIM_RELIABLE_BLOCKS + 2U) == kStatus_Success);
+    SIM_CHECK(s_simCard.writeCount == 3U);
+    SIM_CHECK((s_simCard.writeLog[0U].startBlock == 15U) && (s_simCard.writeLog[0U].blockCount == 1U));
+    SIM_CHECK((s_simCard.writeLog[1U].startBlock == 16U) &&
+              (s_simCard.writeLog[1U].blockCount == SIM_RELIABLE_BLOCKS));
+    SIM_CHECK((s_simCard.writeLog[2U].startBlock == 24U) && (s_simCard.writeLog[2U].blockCount == 1U));
+    SIM_CHECK(s_simCard.writeLog[0U].isReliable && s_simCard.writeLog[1U].isReliable &&
+              s_simCard.writeLog[2U].isReliable);
+    SIM_CHECK(memcmp(&s_simCard.data[15U * FSL_SDMMC_DEFAULT_BLOCK_SIZE], buffer, size) == 0);
+
+    return true;
+}
+
+static bool SIM_TestAlignedReliableWrite(void)
+{
+    uint32_t size = SIM_RELIABLE_BLOCKS * 2U * FSL_SDMMC_DEFAULT_BLOCK_SIZE;
+
+    /* enhanced reliable write, split on the reliable write sector boundary only */
+    s_card.extendedCsd.writeReliabilityParameter = MMC_WRITE_RELIABILITY_PARAMETER_EN_REL_WR_MASK;
+    SIM_CHECK(MMC_WriteBlocksReliable(&s_card, (const uint8_t *)s_txBuffer, 36U, SIM_RELIABLE_BLOCKS * 2U) ==
+              kStatus_Success);
+    SIM_CHECK(s_simCard.writeCount == 3U);
+    SIM_CHECK((s_simCard.writeLog[0U].startBlock == 36U) && (s_simCard.writeLog[0U].blockCount == 4U));
+    SIM_CHECK((s_simCard.writeLog[1U].startBlock == 40U) &&
+              (s_simCard.writeLog[1U].blockCount == SIM_RELIABLE_BLOCKS));
+    SIM_CHECK((s_simCard.writeLog[2U].startBlock == 48U) && (s_simCard.writeLog[2U].blockCount == 4U));
+    SIM_CHECK(s_simCard.writeLog[0U].isReliable && s_simCard.writeLog[1U].isReliable &&
+              s_simCard.writeLog[2U].isReliable);
+    SIM_CHECK(memcmp(&s_simCard.data[36U * FSL_SDMMC_DEFAULT_BLOCK_SIZE], s_txBuffer, size) == 0);
+
+    return true;
+}
+
+int main(void)
+{
+    static const sim_test_t tests[] = {
+        {"unaligned_reliable_write_rejected", SIM_TestUnalignedReliableWriteRejected},
+        {"unaligned_reliable_write", SIM_TestUnalignedReliableWrite},
+        {"aligned_reliable_write", SIM_TestAlignedReliableWrite},
+    };
+    uint32_t failed = 0U;
+    uint32_t i;
+
+    SDMMC_OSAInit();
+
+    /* the card is already initialized in transfer state, high capacity, user partition selected */
+    s_host.hostController.base                  = &s_simUsdhc;
+    s_host.maxBlockCount                        = SIM_HOST_MAX_BLOCK_COUNT;
+    s_host.maxBlockSize                         = SDMMCHOST_SUPPORT_MAX_BLOCK_LENGTH;
+    s_card.host                                 = &s_host;
+    s_card.isHostReady                          = true;
+    s_card.relativeAddress                      = 1U;
+    s_card.userPartitionBlocks                  = SIM_CARD_BLOCKS;
+    s_card.blockSize                            = FSL_SDMMC_DEFAULT_BLOCK_SIZE;
+    s_card.currentPartition                     = kMMC_AccessPartitionUserAera;
+    s_card.flags                                = (uint32_t)kMMC_SupportHighCapacityFlag;
+    s_card.extendedCsd.reliableWriteSectorCount = SIM_RELIABLE_BLOCKS;
+    (void)SDMMC_OSAMutexCreate(&s_card.lock);
+
+    for (i = 0U; i < sizeof(tests) / sizeof(tests[0]); i++)
+    {
+        SIM_TestReset();
+        if (tests[i].func())
+        {
+            (void)printf("PASS %s\n", tests[i].name);
+        }
+        else
+        {
+            (void)printf("FAIL %s\n", tests[i].name);
+            failed++;
+        }
+    }
+
+    (void)printf("%u/%u passed\n", (unsigned int)(i - failed), (unsigned int)i);
+
+    return failed == 0U ? 0 : 1;
+}
@@ -0,0 +1,480 @@
+/*
+ * Copyright 2020 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "fsl_sd.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief simulated card capacity in blocks */
+#define SIM_CARD_BLOCKS (1024U)
+/*! @brief simulated host maximum block count of one transfer */
+#define SIM_HOST_MAX_BLOCK_COUNT (16U)
+/*! @brief command log depth */
+#define SIM_COMMAND_LOG_SIZE (16U)
+/*! @brief maximum test callback count */
+#define SIM_CALLBACK_LOG_SIZE (4U)
+
+/*! @brief test check, report the failed line and fail the test case */
+#define SIM_CHECK(condition)                                                    \
+    do                                                                          \
+    {                                                                           \
+        if (!(condition))                                                       \
+        {                                                                       \
+            (void)printf("  check failed line %d: %s\n", __LINE__, #condition); \
+            return false;                                                       \
+        }                                                                       \
+    } while (false)
+
+/*! @brief simulated SD card */
+typedef struct _sim_sd_card
+{
+    uint8_t data[SIM_CARD_BLOCKS * FSL_SDMMC_DEFAULT_BLOCK_SIZE]; /*!< card content */
+    uint32_t setBlockCount;                                      /*!< block count set by CMD23, 0 if not set */
+    uint32_t commandLog[SIM_COMMAND_LOG_SIZE];                   /*!< received command index */
+    uint32_t commandCount;                                       /*!< received command count */
+    bool failNextData;                                           /*!< fail the next data transfer */
+    bool hangNextAsync;                                          /*!< the next asynchronous transfer never completes */
+    bool isAsyncHang;                                            /*!< the ongoing asynchronous transfer is hung */
+} sim_sd_card_t;
+
+/*! @brief asynchronous transfer callback log */
+typedef struct _sim_callback_log
+{
+    uint32_t count;                         /*!< callback count */
+    status_t status[SIM_CALLBACK_LOG_SIZE]; /*!< status of each callback */
+    void *userData[SIM_CALLBACK_LOG_SIZE];  /*!< user data of each callback */
+} sim_callback_log_t;
+
+/*! @brief test case */
+typedef struct _sim_test
+{
+    const char *name;   /*!< test name */
+    bool (*func)(void); /*!< test function */
+} sim_test_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+static status_t SIM_CardExecute(sdmmchost_transfer_t *content);
+static void SIM_HostInterrupt(void);
+static void SIM_HostWaitAsyncTransfer(sdmmchost_t *host);
+static void SIM_TestReset(void);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+/*! @brief simulated host controller registers, the data line 0 is always high as the card is never busy */
+static USDHC_Type s_simUsdhc = {.PRES_STATE = (uint32_t)kUSDHC_Data0LineLevelFlag};
+/*! @brief simulated card, static to keep it below 4 GiB for the 32 bit address of the card driver */
+static sim_sd_card_t s_simCard;
+/*! @brief host handler */
+static sdmmchost_t s_host;
+/*! @brief card descriptor */
+static sd_card_t s_card;
+/*! @brief callback log */
+static sim_callback_log_t s_callbackLog;
+/*! @brief transfer buffers */
+static uint32_t s_txBuffer[SIM_HOST_MAX_BLOCK_COUNT * FSL_SDMMC_DEFAULT_BLOCK_SIZE / sizeof(uint32_t)];
+static uint32_t s_rxBuffer[SIM_HOST_MAX_BLOCK_COUNT * FSL_SDMMC_DEFAULT_BLOCK_SIZE / sizeof(uint32_t)];
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+static status_t SIM_CardExecute(sdmmchost_transfer_t *content)
+{
+    sdmmchost_cmd_t *command = content->command;
+    sdmmchost_data_t *data   = content->data;
+    uint8_t *cardData        = NULL;
+    uint32_t size            = 0U;
+    uint32_t setBlockCount   = 0U;
+
+    s_host.transferSequence++;
+    if (s_simCard.commandCount < SIM_COMMAND_LOG_SIZE)
+    {
+        s_simCard.commandLog[s_simCard.commandCount] = command->index;
+    }
+    s_simCard.commandCount++;
+
+    /* R1 response of the card in transfer state, ready for data */
+    command->response[0U] = SDMMC_MASK(kSDMMC_R1ReadyForDataFlag) | ((uint32_t)kSDMMC_R1StateTransfer << 9U);
+
+    if (command->index == (uint32_t)kSDMMC_SetBlockCount)
+    {
+        s_simCard.setBlockCount = command->argument;
+        return kStatus_Success;
+    }
+
+    if (data == NULL)
+    {
+        return kStatus_Success;
+    }
+
+    /* CMD23 only applies to the data command right after it, even if that one fails */
+    setBlockCount           = s_simCard.setBlockCount;
+    s_simCard.setBlockCount = 0U;
+
+    if (s_simCard.failNextData)
+    {
+        s_simCard.failNextData = false;
+        return kStatus_Fail;
+    }
+
+    /* the closed-ended multiple block transfer without Auto-CMD23 needs a CMD23 right before it */
+    if ((data->blockCount > 1U) && (!data->enableAutoCommand12) && (!data->enableAutoCommand23) &&
+        (setBlockCount != data->blockCount))
+    {
+        return kStatus_Fail;
+    }
+
+    if ((command->argument + data->blockCount) > SIM_CARD_BLOCKS)
+    {
+        return kStatus_Fail;
+    }
+
+    cardData = &s_simCard.data[command->argument * FSL_SDMMC_DEFAULT_BLOCK_SIZE];
+    size     = data->blockCount * data->blockSize;
+    if (data->rxData != NULL)
+    {
+        (void)memcpy((void *)(uintptr_t)data->rxData, cardData, size);
+    }
+    else
+    {
+        (void)memcpy(cardData, (const void *)(uintptr_t)data->txData, size);
+    }
+
+    return kStatus_Success;
+}
+
+/* complete the ongoing asynchronous transfer as the host transfer complete interrupt does */
+static void SIM_HostInterrupt(void)
+{
+    status_t error;
+
+    if ((!s_host.isAsyncTransferBusy) || s_simCard.isAsyncHang)
+    {
+        return;
+    }
+
+    error                      = SIM_CardExecute(s_host.asyncTransfer);
+    s_host.isAsyncTransferBusy = false;
+    s_host.transferCallback(&s_host, error, s_host.transferUserData);
+}
+
+/* the ongoing asynchronous transfer completes while the host waits it, a hung one is aborted with timeout */
+static void SIM_HostWaitAsyncTransfer(sdmmchost_t *host)
+{
+    if (!host->isAsyncTransferBusy)
+    {
+        return;
+    }
+
+    if (s_simCard.isAsyncHang)
+    {
+        s_simCard.isAsyncHang     = false;
+        host->isAsyncTransferBusy = false;
+        host->transferCallback(host, kStatus_Timeout, host->transferUserData);
+        return;
+    }
+
+    SIM_HostInterrupt();
+}
+
+status_t SDMMCHOST_TransferFunction(sdmmchost_t *host, sdmmchost_transfer_t *content)
+{
+    SIM_HostWaitAsyncTransfer(host);
+
+    return SIM_CardExecute(content);
+}
+
+status_t SDMMCHOST_TransferAsync(sdmmchost_t *host,
+                                 sdmmchost_transfer_t *content,
+                                 sdmmchost_transfer_callback_t callback,
+                                 void *userData)
+{
+    SIM_HostWaitAsyncTransfer(host);
+
+    host->asyncTransfer       = content;
+    host->transferCallback    = callback;
+    host->transferUserData    = userData;
+    host->isAsyncTransferBusy = true;
+
+    s_simCard.isAsyncHang   = s_simCard.hangNextAsync;
+    s_simCard.hangNextAsync = false;
+
+    return kStatus_Success;
+}
+
+status_t SDMMCHOST_ExecuteTuning(sdmmchost_t *host, uint32_t tuningCmd, uint32_t *revBuf, uint32_t blockSize)
+{
+    return kStatus_Success;
+}
+
+void SDMMCHOST_ConvertDataToLittleEndian(sdmmchost_t *host, uint32_t *data, uint32_t wordSize, uint32_t format)
+{
+}
+
+status_t SDMMCHOST_Init(sdmmchost_t *host)
+{
+    return kStatus_Success;
+}
+
+void SDMMCHOST_Deinit(sdmmchost_t *host)
+{
+}
+
+void SDMMCHOST_Reset(sdmmchost_t *host)
+{
+}
+
+void SDMMCHOST_SetCardPower(sdmmchost_t *host, bool enable)
+{
+}
+
+void SDMMCHOST_SetCardBusWidth(sdmmchost_t *host, uint32_t dataBusWidth)
+{
+}
+
+void SDMMCHOST_SwitchToVoltage(sdmmchost_t *host, uint32_t voltage)
+{
+}
+
+status_t SDMMCHOST_CardDetectInit(sdmmchost_t *host, void *cd)
+{
+    return kStatus_Success;
+}
+
+uint32_t SDMMCHOST_CardDetectStatus(sdmmchost_t *host)
+{
+    return (uint32_t)kSD_Inserted;
+}
+
+status_t SDMMCHOST_PollingCardDetectStatus(sdmmchost_t *host, uint32_t waitCardStatus, uint32_t timeout)
+{
+    return kStatus_Success;
+}
+
+uint32_t USDHC_SetSdClock(USDHC_Type *base, uint32_t srcClock_Hz, uint32_t busClock_Hz)
+{
+    return busClock_Hz;
+}
+
+void USDHC_EnableDDRMode(USDHC_Type *base, bool enable, uint32_t nibblePos)
+{
+}
+
+bool USDHC_SetCardActive(USDHC_Type *base, uint32_t timeout)
+{
+    return true;
+}
+
+static void SIM_TransferCallback(sd_card_t *card, status_t status, void *userData)
+{
+    assert(card == &s_card);
+
+    if (s_callbackLog.count < SIM_CALLBACK_LOG_SIZE)
+    {
+        s_callbackLog.status[s_callbackLog.count]   = status;
+        s_callbackLog.userData[s_callbackLog.count] = userData;
+    }
+    s_callbackLog.count++;
+}
+
+static void SIM_TestReset(void)
+{
+    uint32_t i;
+
+    SIM_HostWaitAsyncTransfer(&s_host);
+
+    (void)memset(&s_simCard, 0, sizeof(s_simCard));
+    (void)memset(&s_callbackLog, 0, sizeof(s_callbackLog));
+    for (i = 0U; i < sizeof(s_txBuffer) / sizeof(s_txBuffer[0]); i++)
+    {
+        s_txBuffer[i] = i * 0x9E3779B9U;
+    }
+    (void)memset(s_rxBuffer, 0, sizeof(s_rxBuffer));
+
+    s_host.capability |= (uint32_t)kSDMMCHOST_SupportAutoCmd23;
+}
+
+static bool SIM_TestAsyncWriteRead(void)
+{
+    uint32_t size = 8U * FSL_SDMMC_DEFAULT_BLOCK_SIZE;
+
+    SIM_CHECK(SD_WriteBlocksAsync(&s_card, (uint8_t *)s_txBuffer, 100U, 8U, SIM_TransferCallback, &s_txBuffer) ==
+              kStatus_Success);
+    /* the submit returns before the transfer completes */
+    SIM_CHECK(s_callbackLog.count == 0U);
+    SIM_CHECK(s_host.isAsyncTransferBusy);
+    SIM_HostInterrupt();
+    SIM_CHECK(s_callbackLog.count == 1U);
+    SIM_CHECK(s_callbackLog.status[0U] == kStatus_Success);
+    SIM_CHECK(s_callbackLog.userData[0U] == &s_txBuffer);
+    SIM_CHECK(memcmp(&s_simCard.data[100U * FSL_SDMMC_DEFAULT_BLOCK_SIZE], s_txBuffer, size) == 0);
+
+    SIM_CHECK(SD_ReadBlocksAsync(&s_card, (uint8_t *)s_rxBuffer, 100U, 8U, SIM_TransferCallback, &s_rxBuffer) ==
+              kStatus_Success);
+    SIM_CHECK(s_callbackLog.count == 1U);
+    SIM_HostInterrupt();
+    SIM_CHECK(s_callbackLog.count == 2U);
+    SIM_CHECK(s_callbackLog.status[1U] == kStatus_Success);
+    SIM_CHECK(s_callbackLog.userData[1U] == &s_rxBuffer);
+    SIM_CHECK(memcmp(s_rxBuffer, s_txBuffer, size) == 0);
+
+    return true;
+}
+
+static bool SIM_TestAsyncSubmitWaitsPrevious(void)
+{
+    uint32_t size = FSL_SDMMC_DEFAULT_BLOCK_SIZE;
+
+    SIM_CHECK(SD_WriteBlocksAsync(&s_card, (uint8_t *)s_txBuffer, 200U, 1U, SIM_TransferCallback, NULL) ==
+              kStatus_Success);
+    /* the second submit completes the first transfer before issuing its own */
+    SIM_CHECK(SD_ReadBlocksAsync(&s_card, (uint8_t *)s_rxBuffer, 200U, 1U, SIM_TransferCallback, &s_rxBuffer) ==
+              kStatus_Success);
+    SIM_CHECK(s_callbackLog.count == 1U);
+    SIM_CHECK(s_callbackLog.userData[0U] == NULL);
+    SIM_HostInterrupt();
+    SIM_CHECK(s_callbackLog.count == 2U);
+    SIM_CHECK(s_callbackLog.userData[1U] == &s_rxBuffer);
+    SIM_CHECK(memcmp(s_rxBuffer, s_txBuffer, size) == 0);
+
+    /* the blocking transfer waits the ongoing asynchronous transfer as well */
+    SIM_CHECK(SD_WriteBlocksAsync(&s_card, (uint8_t *)s_txBuffer, 300U, 4U, SIM_TransferCallback, NULL) ==
+              kStatus_Success);
+    SIM_CHECK(SD_ReadBlocks(&s_card, (uint8_t *)s_rxBuffer, 300U, 4U) == kStatus_Success);
+    SIM_CHECK(s_callbackLog.count == 3U);
+    SIM_CHECK(memcmp(s_rxBuffer, s_txBuffer, 4U * size) == 0);
+
+    return true;
+}
+
+static bool SIM_TestAsyncTransferError(void)
+{
+    s_simCard.failNextData = true;
+    SIM_CHECK(SD_WriteBlocksAsync(&s_card, (uint8_t *)s_txBuffer, 400U, 2U, SIM_TransferCallback, NULL) ==
+              kStatus_Success);
+    SIM_HostInterrupt();
+    SIM_CHECK(s_callbackLog.count == 1U);
+    SIM_CHECK(s_callbackLog.status[0U] == kStatus_SDMMC_TransferFailed);
+
+    return true;
+}
+
+static bool SIM_TestAsyncTransferTimeout(void)
+{
+    s_simCard.hangNextAsync = true;
+    SIM_CHECK(SD_WriteBlocksAsync(&s_card, (uint8_t *)s_txBuffer, 500U, 2U, SIM_TransferCallback, NULL) ==
+              kStatus_Success);
+    SIM_HostInterrupt();
+    SIM_CHECK(s_callbackLog.count == 0U);
+
+    /* the next transfer aborts the hung one, which is reported to its callback */
+    SIM_CHECK(SD_ReadBlocks(&s_card, (uint8_t *)s_rxBuffer, 0U, 1U) == kStatus_Success);
+    SIM_CHECK(s_callbackLog.count == 1U);
+    SIM_CHECK(s_callbackLog.status[0U] == kStatus_SDMMC_TransferFailed);
+    SIM_CHECK(!s_host.isAsyncTransferBusy);
+
+    return true;
+}
+
+static bool SIM_TestAsyncInvalidArgument(void)
+{
+    /* there is no internal buffer exchange for the asynchronous transfer */
+    SIM_CHECK(SD_WriteBlocksAsync(&s_card, (uint8_t *)s_txBuffer + 1U, 0U, 1U, SIM_TransferCallback, NULL) ==
+              kStatus_InvalidArgument);
+    SIM_CHECK(SD_ReadBlocksAsync(&s_card, (uint8_t *)s_rxBuffer, 0U, SIM_HOST_MAX_BLOCK_COUNT + 1U,
+                                 SIM_TransferCallback, NULL) == kStatus_InvalidArgument);
+    SIM_CHECK(!s_host.isAsyncTransferBusy);
+    SIM_CHECK(s_simCard.commandCount == 0U);
+    SIM_CHECK(s_callbackLog.count == 0U);
+
+    return true;
+}
+
+static bool SIM_TestAsyncSetBlockCount(void)
+{
+    /* the host without Auto-CMD23 sends CMD23 before the closed-ended transfer */
+    s_host.capability &= ~(uint32_t)kSDMMCHOST_SupportAutoCmd23;
+    SIM_CHECK(SD_WriteBlocksAsync(&s_card, (uint8_t *)s_txBuffer, 600U, 4U, SIM_TransferCallback, NULL) ==
+              kStatus_Success);
+    SIM_HostInterrupt();
+    SIM_CHECK(s_callbackLog.count == 1U);
+    SIM_CHECK(s_callbackLog.status[0U] == kStatus_Success);
+    SIM_CHECK(s_simCard.commandCount >= 2U);
+    SIM_CHECK(s_simCard.commandLog[s_simCard.commandCount - 2U] == (uint32_t)kSDMMC_SetBlockCount);
+    SIM_CHECK(s_simCard.commandLog[s_simCard.commandCount - 1U] == (uint32_t)kSDMMC_WriteMultipleBlock);
+
+    return true;
+}
+
+static bool SIM_TestSetBlockCountRetry(void)
+{
+    uint32_t size = 4U * FSL_SDMMC_DEFAULT_BLOCK_SIZE;
+
+    /* the retry of the failed closed-ended transfer is preceded by its own CMD23 */
+    s_host.capability &= ~(uint32_t)kSDMMCHOST_SupportAutoCmd23;
+    s_simCard.failNextData = true;
+    SIM_CHECK(SD_WriteBlocks(&s_card, (uint8_t *)s_txBuffer, 700U, 4U) == kStatus_Success);
+    SIM_CHECK(s_simCard.commandCount >= 2U);
+    SIM_CHECK(s_simCard.commandLog[s_simCard.commandCount - 2U] == (uint32_t)kSDMMC_SetBlockCount);
+    SIM_CHECK(s_simCard.commandLog[s_simCard.commandCount - 1U] == (uint32_t)kSDMMC_WriteMultipleBlock);
+    SIM_CHECK(memcmp(&s_simCard.data[700U * FSL_SDMMC_DEFAULT_BLOCK_SIZE], s_txBuffer, size) == 0);
+
+    return true;
+}
+
+int main(void)
+{
+    static const sim_test_t tests[] = {
+        {"async_write_read", SIM_TestAsyncWriteRead},
+        {"async_submit_waits_previous", SIM_TestAsyncSubmitWaitsPrevious},
+        {"async_transfer_error", SIM_TestAsyncTransferError},
+        {"async_transfer_timeout", SIM_TestAsyncTransferTimeout},
+        {"async_invalid_argument", SIM_TestAsyncInvalidArgument},
+        {"async_set_block_count", SIM_TestAsyncSetBlockCount},
+        {"set_block_count_retry", SIM_TestSetBlockCountRetry},
+    };
+    uint32_t failed = 0U;
+    uint32_t i;
+
+    SDMMC_OSAInit();
+
+    /* the card is already initialized in transfer state, high capacity and CMD23 supported */
+    s_host.hostController.base = &s_simUsdhc;
+    s_host.maxBlockCount       = SIM_HOST_MAX_BLOCK_COUNT;
+    s_host.maxBlockSize        = SDMMCHOST_SUPPORT_MAX_BLOCK_LENGTH;
+    s_card.host                = &s_host;
+    s_card.isHostReady         = true;
+    s_card.noInteralAlign      = true;
+    s_card.relativeAddress     = 1U;
+    s_card.blockCount          = SIM_CARD_BLOCKS;
+    s_card.blockSize           = FSL_SDMMC_DEFAULT_BLOCK_SIZE;
+    s_card.flags               = (uint32_t)kSD_SupportHighCapacityFlag | (uint32_t)kSD_SupportSetBlockCountCmd;
+    (void)SDMMC_OSAMutexCreate(&s_card.lock);
+
+    for (i = 0U; i < sizeof(tests) / sizeof(tests[0]); i++)
+    {
+        SIM_TestReset();
+        if (tests[i].func())
+        {
+            (void)printf("PASS %s\n", tests[i].name);
+        }
+        else
+        {
+            (void)printf("FAIL %s\n", tests[i].name);
+            failed++;
+        }
+    }
+
+    (void)printf("%u/%u passed\n", (unsigned int)(i - failed), (unsigned int)i);
+
+    return failed == 0U ? 0 : 1;
+}
@@ -0,0 +1,297 @@
+/*
+ * Copyright 2020 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "sdmmc_benchmark.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief simulated cycle counter frequency in MHz, the same as the i.MXRT1052 core clock */
+#define SIM_CYCLES_PER_US (600U)
+/*! @brief simulated card capacity */
+#define SIM_CARD_BYTES (128U * 1024U * 1024U)
+/*! @brief simulated command queue depth of the MMC card */
+#define SIM_MMC_CMDQ_DEPTH (32U)
+
+/*! @brief simulated bus timing */
+typedef struct _sim_timing
+{
+    const char *name;       /*!< timing name, the same as the card benchmark device */
+    uint32_t bytesPerUs;    /*!< effective bus throughput */
+    bool isLegacySupported; /*!< timing is supported by the legacy 3.3V card */
+} sim_timing_t;
+
+/*! @brief simulated card profile */
+typedef struct _sim_profile
+{
+    const char *name;              /*!< device name */
+    const sim_timing_t *timing;    /*!< bus timings */
+    uint32_t timingCount;          /*!< bus timing count */
+    uint32_t commandUs;            /*!< command overhead of each transfer */
+    uint32_t sequentialReadUs;     /*!< access latency of the read following the previous transfer */
+    uint32_t randomReadUs;         /*!< access latency of the random read */
+    uint32_t sequentialWriteUs;    /*!< program latency of the write following the previous transfer */
+    uint32_t randomWriteUs;        /*!< program latency of the random write */
+    uint32_t maxQueueDepth;        /*!< queue depth supported by the card */
+} sim_profile_t;
+
+/*! @brief simulated card */
+typedef struct _sim_card
+{
+    const sim_profile_t *profile; /*!< card profile */
+    uint8_t *data;                /*!< card content */
+    uint32_t blockCount;          /*!< card capacity in blocks */
+    bool isLegacy;                /*!< legacy 3.3V card, the UHS and HS200/HS400 timings fall back */
+    uint32_t timing;              /*!< current timing */
+    uint32_t queueDepth;          /*!< current queue depth */
+    uint32_t nextBlock;           /*!< block following the previous transfer */
+} sim_card_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+/*! @brief simulated SD bus timings */
+static const sim_timing_t s_simSDTiming[] = {
+    {"SDR104", 80U, false},
+    {"DDR50", 42U, false},
+    {"SDR50", 45U, false},
+    {"SDR25", 22U, true},
+};
+
+/*! @brief simulated MMC bus timings, the 4 bit bus of the EVK slot */
+static const sim_timing_t s_simMMCTiming[] = {
+    {"HS400ES", 160U, false},
+    {"HS400", 160U, false},
+    {"HS200", 85U, false},
+    {"HS", 22U, true},
+};
+
+/*! @brief simulated card profiles */
+static const sim_profile_t s_simProfile[] = {
+    {"sd", s_simSDTiming, sizeof(s_simSDTiming) / sizeof(s_simSDTiming[0]), 30U, 15U, 350U, 60U, 2500U, 1U},
+    {"mmc", s_simMMCTiming, sizeof(s_simMMCTiming) / sizeof(s_simMMCTiming[0]), 20U, 10U, 120U, 40U, 600U,
+     SIM_MMC_CMDQ_DEPTH},
+};
+
+/*! @brief simulated cycle counter */
+static uint64_t s_simCycles;
+
+/*! @brief simulated card */
+static sim_card_t s_simCard;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+static uint32_t SIM_GetCycles(void)
+{
+    return (uint32_t)s_simCycles;
+}
+
+static const char *SIM_GetTimingName(void *context, uint32_t timing)
+{
+    return ((sim_card_t *)context)->profile->timing[timing].name;
+}
+
+static status_t SIM_SetTiming(void *context, uint32_t timing)
+{
+    sim_card_t *card = (sim_card_t *)context;
+
+    /* the card init falls back to the legacy timing */
+    if (card->isLegacy && (!card->profile->timing[timing].isLegacySupported))
+    {
+        return kStatus_Fail;
+    }
+
+    card->timing     = timing;
+    card->queueDepth = 1U;
+    card->nextBlock  = 0U;
+
+    return kStatus_Success;
+}
+
+static status_t SIM_SetQueueDepth(void *context, uint32_t queueDepth)
+{
+    sim_card_t *card = (sim_card_t *)context;
+
+    if (queueDepth > card->profile->maxQueueDepth)
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    card->queueDepth = queueDepth;
+
+    return kStatus_Success;
+}
+
+/* access latency in us, the latency is overlapped by the queued transfers */
+static uint64_t SIM_AccessUs(sim_card_t *card, uint32_t startBlock, uint32_t blockCount, bool isWrite)
+{
+    const sim_profile_t *profile = card->profile;
+    bool isSequential            = startBlock == card->nextBlock;
+    uint64_t us                  = profile->commandUs;
+
+    if (isWrite)
+    {
+        us += (isSequential ? profile->sequentialWriteUs : profile->randomWriteUs) / card->queueDepth;
+    }
+    else
+    {
+        us += (isSequential ? profile->sequentialReadUs : profile->randomReadUs) / card->queueDepth;
+    }
+    us += ((uint64_t)blockCount * BENCHMARK_BLOCK_SIZE) / profile->timing[card->timing].bytesPerUs;
+
+    card->nextBlock = startBlock + blockCount;
+
+    return us;
+}
+
+static status_t SIM_Transfer(void *context, uint8_t *buffer, uint32_t startBlock, uint32_t blockCount, bool isWrite)
+{
+    sim_card_t *card = (sim_card_t *)context;
+    uint8_t *data    = card->data + ((size_t)startBlock * BENCHMARK_BLOCK_SIZE);
+    size_t size      = (size_t)blockCount * BENCHMARK_BLOCK_SIZE;
+
+    if ((blockCount == 0U) || (((uint64_t)startBlock + blockCount) > card->blockCount))
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    if (isWrite)
+    {
+        (void)memcpy(data, buffer, size);
+    }
+    else
+    {
+        (void)memcpy(buffer, data, size);
+    }
+
+    s_simCycles += SIM_AccessUs(card, startBlock, blockCount, isWrite) * SIM_CYCLES_PER_US;
+
+    return kStatus_Success;
+}
+
+static status_t SIM_TransferQueue(void *context, benchmark_request_t *request, uint32_t requestCount)
+{
+    sim_card_t *card = (sim_card_t *)context;
+    status_t error   = kStatus_Success;
+    uint32_t i;
+
+    if (card->queueDepth < 2U)
+    {
+        return kStatus_Fail;
+    }
+
+    for (i = 0U; (i < requestCount) && (error == kStatus_Success); i++)
+    {
+        error = SIM_Transfer(context, request[i].buffer, request[i].startBlock, request[i].blockCount,
+                             request[i].isWrite);
+    }
+
+    return error;
+}
+
+static void SIM_Usage(const char *name)
+{
+    fprintf(stderr,
+            "usage: %s [-c sd|mmc] [-l] [-p patterns] [-m max size] [-q max queue depth]\n"
+            "  -c  simulated card, sd by default\n"
+            "  -l  legacy 3.3V card, the UHS and HS200/HS400 timings are skipped\n"
+            "  -p  pattern mask, 1 sequential read, 2 sequential write, 4 random read, 8 random write\n"
+            "  -m  maximum transfer size in bytes, 4194304 by default\n"
+            "  -q  maximum queue depth, 32 by default\n",
+            name);
+}
+
+int main(int argc, char **argv)
+{
+    benchmark_device_t device;
+    benchmark_config_t config;
+    status_t error;
+    int i;
+
+    (void)memset(&s_simCard, 0, sizeof(s_simCard));
+    s_simCard.profile = &s_simProfile[0];
+
+    BENCHMARK_GetDefaultConfig(&config);
+
+    for (i = 1; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "-c") == 0) && (i + 1 < argc))
+        {
+            i++;
+            if (strcmp(argv[i], "mmc") == 0)
+            {
+                s_simCard.profile = &s_simProfile[1];
+            }
+            else if (strcmp(argv[i], "sd") != 0)
+            {
+                SIM_Usage(argv[0]);
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "-l") == 0)
+        {
+            s_simCard.isLegacy = true;
+        }
+        else if ((strcmp(argv[i], "-p") == 0) && (i + 1 < argc))
+        {
+            config.patterns = (uint32_t)strtoul(argv[++i], NULL, 0);
+        }
+        else if ((strcmp(argv[i], "-m") == 0) && (i + 1 < argc))
+        {
+            config.maxSize = (uint32_t)strtoul(argv[++i], NULL, 0);
+        }
+        else if ((strcmp(argv[i], "-q") == 0) && (i + 1 < argc))
+        {
+            config.maxQueueDepth = (uint32_t)strtoul(argv[++i], NULL, 0);
+        }
+        else
+        {
+            SIM_Usage(argv[0]);
+            return 1;
+        }
+    }
+
+    s_simCard.blockCount = SIM_CARD_BYTES / BENCHMARK_BLOCK_SIZE;
+    s_simCard.data       = (uint8_t *)calloc(SIM_CARD_BYTES, 1U);
+    config.bufferSize    = config.maxSize;
+    config.buffer        = (uint8_t *)malloc(config.bufferSize);
+    if ((s_simCard.data == NULL) || (config.buffer == NULL))
+    {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    (void)memset(&device, 0, sizeof(device));
+    device.name          = s_simCard.profile->name;
+    device.context       = &s_simCard;
+    device.blockCount    = s_simCard.blockCount;
+    device.timingCount   = s_simCard.profile->timingCount;
+    device.maxQueueDepth = s_simCard.profile->maxQueueDepth;
+    device.getTimingName = SIM_GetTimingName;
+    device.setTiming     = SIM_SetTiming;
+    device.transfer      = SIM_Transfer;
+    if (s_simCard.profile->maxQueueDepth > 1U)
+    {
+        device.setQueueDepth = SIM_SetQueueDepth;
+        device.transferQueue = SIM_TransferQueue;
+    }
+
+    /* the region is at the end of the card, the same as the firmware */
+    config.startBlock  = device.blockCount - config.regionBlocks;
+    config.getCycles   = SIM_GetCycles;
+    config.cyclesPerUs = SIM_CYCLES_PER_US;
+
+    error = BENCHMARK_Run(&device, &config);
+
+    free(config.buffer);
+    free(s_simCard.data);
+
+    return (error == kStatus_Success) ? 0 : 1;
+}
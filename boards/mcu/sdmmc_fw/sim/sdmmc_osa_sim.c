@@ -0,0 +1,264 @@
+/*
+ * Copyright 2020 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <errno.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include "fsl_sdmmc_osa.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief maximum simulated mutex count */
+#define SIM_OSA_MUTEX_COUNT (16U)
+
+/*! @brief simulated mutex, the OSA mutex handle is too small to hold the pthread mutex */
+typedef struct _sim_osa_mutex
+{
+    void *handle;          /*!< sdmmc osa mutex handle, NULL if the entry is free */
+    pthread_mutex_t mutex; /*!< mutex */
+} sim_osa_mutex_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+static void SIM_OSAGetDeadline(struct timespec *deadline, uint32_t milliseconds);
+static sim_osa_mutex_t *SIM_OSAFindMutex(void *mutexHandle);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+/*! @brief critical section and event lock */
+static pthread_mutex_t s_simOsaLock;
+/*! @brief event set condition */
+static pthread_cond_t s_simOsaEventCond = PTHREAD_COND_INITIALIZER;
+/*! @brief simulated mutexes */
+static sim_osa_mutex_t s_simOsaMutex[SIM_OSA_MUTEX_COUNT];
+/*! @brief simulated mutex table lock */
+static pthread_mutex_t s_simOsaMutexTableLock = PTHREAD_MUTEX_INITIALIZER;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+static void SIM_OSAGetDeadline(struct timespec *deadline, uint32_t milliseconds)
+{
+    (void)clock_gettime(CLOCK_REALTIME, deadline);
+    deadline->tv_sec += milliseconds / 1000U;
+    deadline->tv_nsec += (long)(milliseconds % 1000U) * 1000000L;
+    if (deadline->tv_nsec >= 1000000000L)
+    {
+        deadline->tv_sec++;
+        deadline->tv_nsec -= 1000000000L;
+    }
+}
+
+static sim_osa_mutex_t *SIM_OSAFindMutex(void *mutexHandle)
+{
+    sim_osa_mutex_t *mutex = NULL;
+    uint32_t i;
+
+    (void)pthread_mutex_lock(&s_simOsaMutexTableLock);
+    for (i = 0U; i < SIM_OSA_MUTEX_COUNT; i++)
+    {
+        if (s_simOsaMutex[i].handle == mutexHandle)
+        {
+            mutex = &s_simOsaMutex[i];
+            break;
+        }
+    }
+    (void)pthread_mutex_unlock(&s_simOsaMutexTableLock);
+
+    assert(mutex != NULL);
+
+    return mutex;
+}
+
+void SDMMC_OSAInit(void)
+{
+    pthread_mutexattr_t attr;
+
+    /* the critical section nests like the interrupt masking of the target */
+    (void)pthread_mutexattr_init(&attr);
+    (void)pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    (void)pthread_mutex_init(&s_simOsaLock, &attr);
+    (void)pthread_mutexattr_destroy(&attr);
+}
+
+status_t SDMMC_OSAEventCreate(void *eventHandle)
+{
+    assert(eventHandle != NULL);
+
+    ((sdmmc_osa_event_t *)eventHandle)->eventFlag = 0U;
+
+    return kStatus_Success;
+}
+
+status_t SDMMC_OSAEventWait(void *eventHandle, uint32_t eventType, uint32_t timeoutMilliseconds, uint32_t *event)
+{
+    assert(eventHandle != NULL);
+
+    sdmmc_osa_event_t *osaEvent = (sdmmc_osa_event_t *)eventHandle;
+    struct timespec deadline;
+    status_t error = kStatus_Success;
+
+    SIM_OSAGetDeadline(&deadline, timeoutMilliseconds);
+
+    (void)pthread_mutex_lock(&s_simOsaLock);
+    while ((osaEvent->eventFlag & eventType) == 0U)
+    {
+        if (timeoutMilliseconds == osaWaitForever_c)
+        {
+            (void)pthread_cond_wait(&s_simOsaEventCond, &s_simOsaLock);
+        }
+        else if (pthread_cond_timedwait(&s_simOsaEventCond, &s_simOsaLock, &deadline) == ETIMEDOUT)
+        {
+            error = kStatus_Fail;
+            break;
+        }
+        else
+        {
+            /* Intentional empty */
+        }
+    }
+    *event = osaEvent->eventFlag;
+    (void)pthread_mutex_unlock(&s_simOsaLock);
+
+    return error;
+}
+
+status_t SDMMC_OSAEventSet(void *eventHandle, uint32_t eventType)
+{
+    assert(eventHandle != NULL);
+
+    (void)pthread_mutex_lock(&s_simOsaLock);
+    ((sdmmc_osa_event_t *)eventHandle)->eventFlag |= eventType;
+    (void)pthread_cond_broadcast(&s_simOsaEventCond);
+    (void)pthread_mutex_unlock(&s_simOsaLock);
+
+    return kStatus_Success;
+}
+
+status_t SDMMC_OSAEventGet(void *eventHandle, uint32_t eventType, uint32_t *flag)
+{
+    assert(eventHandle != NULL);
+    assert(flag != NULL);
+
+    *flag = ((sdmmc_osa_event_t *)eventHandle)->eventFlag;
+
+    return kStatus_Success;
+}
+
+status_t SDMMC_OSAEventClear(void *eventHandle, uint32_t eventType)
+{
+    assert(eventHandle != NULL);
+
+    (void)pthread_mutex_lock(&s_simOsaLock);
+    ((sdmmc_osa_event_t *)eventHandle)->eventFlag &= ~eventType;
+    (void)pthread_mutex_unlock(&s_simOsaLock);
+
+    return kStatus_Success;
+}
+
+status_t SDMMC_OSAEventDestroy(void *eventHandle)
+{
+    assert(eventHandle != NULL);
+
+    return kStatus_Success;
+}
+
+status_t SDMMC_OSAMutexCreate(void *mutexHandle)
+{
+    assert(mutexHandle != NULL);
+
+    pthread_mutexattr_t attr;
+    status_t error = kStatus_Fail;
+    uint32_t i;
+
+    (void)pthread_mutex_lock(&s_simOsaMutexTableLock);
+    for (i = 0U; i < SIM_OSA_MUTEX_COUNT; i++)
+    {
+        if (s_simOsaMutex[i].handle == NULL)
+        {
+            /* the OSA mutex is recursive */
+            (void)pthread_mutexattr_init(&attr);
+            (void)pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+            (void)pthread_mutex_init(&s_simOsaMutex[i].mutex, &attr);
+            (void)pthread_mutexattr_destroy(&attr);
+            s_simOsaMutex[i].handle = mutexHandle;
+            error                   = kStatus_Success;
+            break;
+        }
+    }
+    (void)pthread_mutex_unlock(&s_simOsaMutexTableLock);
+
+    return error;
+}
+
+status_t SDMMC_OSAMutexLock(void *mutexHandle, uint32_t millisec)
+{
+    assert(mutexHandle != NULL);
+
+    pthread_mutex_t *mutex = &SIM_OSAFindMutex(mutexHandle)->mutex;
+    struct timespec deadline;
+
+    if (millisec == osaWaitForever_c)
+    {
+        return pthread_mutex_lock(mutex) == 0 ? kStatus_Success : kStatus_Fail;
+    }
+
+    SIM_OSAGetDeadline(&deadline, millisec);
+
+    return pthread_mutex_timedlock(mutex, &deadline) == 0 ? kStatus_Success : kStatus_Fail;
+}
+
+status_t SDMMC_OSAMutexUnlock(void *mutexHandle)
+{
+    assert(mutexHandle != NULL);
+
+    (void)pthread_mutex_unlock(&SIM_OSAFindMutex(mutexHandle)->mutex);
+
+    return kStatus_Success;
+}
+
+status_t SDMMC_OSAMutexDestroy(void *mutexHandle)
+{
+    assert(mutexHandle != NULL);
+
+    sim_osa_mutex_t *mutex = SIM_OSAFindMutex(mutexHandle);
+
+    (void)pthread_mutex_lock(&s_simOsaMutexTableLock);
+    (void)pthread_mutex_destroy(&mutex->mutex);
+    mutex->handle = NULL;
+    (void)pthread_mutex_unlock(&s_simOsaMutexTableLock);
+
+    return kStatus_Success;
+}
+
+void SDMMC_OSADelay(uint32_t milliseconds)
+{
+    (void)usleep(milliseconds * 1000U);
+}
+
+uint32_t SDMMC_OSADelayUs(uint32_t microseconds)
+{
+    (void)usleep(microseconds);
+
+    return microseconds;
+}
+
+void SDMMC_OSAEnterCritical(uint32_t *sr)
+{
+    (void)pthread_mutex_lock(&s_simOsaLock);
+    *sr = 0U;
+}
+
+void SDMMC_OSAExitCritical(uint32_t sr)
+{
+    (void)sr;
+    (void)pthread_mutex_unlock(&s_simOsaLock);
+}
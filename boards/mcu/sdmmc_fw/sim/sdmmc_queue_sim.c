@@ -0,0 +1,499 @@
+/*
+ * Copyright 2020 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include "fsl_sdmmc_queue.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief simulated card capacity in blocks */
+#define SIM_CARD_BLOCKS (1024U)
+/*! @brief maximum request count of one test, including the gate request */
+#define SIM_MAX_REQUESTS (12U)
+/*! @brief maximum block count of one request */
+#define SIM_MAX_REQUEST_BLOCKS (4U)
+/*! @brief merge buffer size in blocks */
+#define SIM_MERGE_BUFFER_BLOCKS (16U)
+/*! @brief block of the gate request, the gate transfer holds the dispatch until all requests are pending */
+#define SIM_GATE_BLOCK (1000U)
+
+/*! @brief test check, report the failed line and fail the test case */
+#define SIM_CHECK(condition)                                                    \
+    do                                                                          \
+    {                                                                           \
+        if (!(condition))                                                       \
+        {                                                                       \
+            (void)printf("  check failed line %d: %s\n", __LINE__, #condition); \
+            return false;                                                       \
+        }                                                                       \
+    } while (false)
+
+/*! @brief simulated request */
+typedef struct _sim_request
+{
+    uint32_t startBlock; /*!< start block */
+    uint32_t blockCount; /*!< block count */
+    bool isWrite;        /*!< write request flag */
+} sim_request_t;
+
+/*! @brief submitter task */
+typedef struct _sim_submitter
+{
+    pthread_t thread;                                                      /*!< submitter thread */
+    sdmmc_queue_t *queue;                                                  /*!< queue */
+    sim_request_t request;                                                 /*!< request */
+    uint8_t buffer[SIM_MAX_REQUEST_BLOCKS * FSL_SDMMC_DEFAULT_BLOCK_SIZE]; /*!< request data */
+    status_t status;                                                       /*!< submit status */
+} sim_submitter_t;
+
+/*! @brief simulated card */
+typedef struct _sim_card
+{
+    uint8_t data[SIM_CARD_BLOCKS * FSL_SDMMC_DEFAULT_BLOCK_SIZE]; /*!< card content */
+    sim_request_t log[SIM_MAX_REQUESTS];                         /*!< transfers received by the card */
+    uint8_t *logBuffer[SIM_MAX_REQUESTS];                        /*!< buffer of each transfer */
+    uint32_t logCount;                                           /*!< transfer count */
+    uint32_t failBlock;                                          /*!< transfer starting at the block fails */
+    volatile bool isGateEntered;                                 /*!< gate transfer is holding the dispatch */
+    volatile bool isGateReleased;                                /*!< gate transfer can complete */
+} sim_card_t;
+
+/*! @brief test case */
+typedef struct _sim_test
+{
+    const char *name;   /*!< test name */
+    bool (*func)(void); /*!< test function */
+} sim_test_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+static status_t SIM_CardTransfer(void *card, uint8_t *buffer, uint32_t startBlock, uint32_t blockCount, bool isWrite);
+static void *SIM_SubmitterTask(void *param);
+static uint32_t SIM_GetSubmittedRequests(sdmmc_queue_t *queue);
+static void SIM_QueueRun(sdmmc_queue_t *queue, const sim_request_t *requests, uint32_t count);
+static bool SIM_CheckLog(const sim_request_t *expected, uint32_t count);
+static void SIM_TestReset(void);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+/*! @brief simulated card */
+static sim_card_t s_simCard;
+/*! @brief submitters, s_submitter[0] submits the gate request */
+static sim_submitter_t s_submitter[SIM_MAX_REQUESTS];
+/*! @brief merge buffer */
+static uint8_t s_mergeBuffer[SIM_MERGE_BUFFER_BLOCKS * FSL_SDMMC_DEFAULT_BLOCK_SIZE];
+/*! @brief queue under test */
+static sdmmc_queue_t s_queue;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+static status_t SIM_CardTransfer(void *card, uint8_t *buffer, uint32_t startBlock, uint32_t blockCount, bool isWrite)
+{
+    sim_card_t *simCard = (sim_card_t *)card;
+    uint8_t *cardData   = &simCard->data[startBlock * FSL_SDMMC_DEFAULT_BLOCK_SIZE];
+
+    assert((startBlock + blockCount) <= SIM_CARD_BLOCKS);
+
+    if (simCard->logCount < SIM_MAX_REQUESTS)
+    {
+        simCard->log[simCard->logCount].startBlock = startBlock;
+        simCard->log[simCard->logCount].blockCount = blockCount;
+        simCard->log[simCard->logCount].isWrite    = isWrite;
+        simCard->logBuffer[simCard->logCount]      = buffer;
+    }
+    simCard->logCount++;
+
+    if (startBlock == SIM_GATE_BLOCK)
+    {
+        simCard->isGateEntered = true;
+        while (!simCard->isGateReleased)
+        {
+            (void)usleep(100U);
+        }
+    }
+
+    if (startBlock == simCard->failBlock)
+    {
+        return kStatus_Fail;
+    }
+
+    if (isWrite)
+    {
+        (void)memcpy(cardData, buffer, blockCount * FSL_SDMMC_DEFAULT_BLOCK_SIZE);
+    }
+    else
+    {
+        (void)memcpy(buffer, cardData, blockCount * FSL_SDMMC_DEFAULT_BLOCK_SIZE);
+    }
+
+    return kStatus_Success;
+}
+
+static void *SIM_SubmitterTask(void *param)
+{
+    sim_submitter_t *submitter = (sim_submitter_t *)param;
+
+    submitter->status = SDMMC_QueueSubmit(submitter->queue, submitter->buffer, submitter->request.startBlock,
+                                          submitter->request.blockCount, submitter->request.isWrite);
+
+    return NULL;
+}
+
+static uint32_t SIM_GetSubmittedRequests(sdmmc_queue_t *queue)
+{
+    sdmmc_queue_statistics_t statistics;
+
+    SDMMC_QueueGetStatistics(queue, &statistics);
+
+    return statistics.submittedRequests;
+}
+
+/* submit the requests in the given order while the gate transfer holds the dispatch, then release them together */
+static void SIM_QueueRun(sdmmc_queue_t *queue, const sim_request_t *requests, uint32_t count)
+{
+    uint32_t submitted = SIM_GetSubmittedRequests(queue);
+    uint32_t i;
+
+    assert(count < SIM_MAX_REQUESTS);
+
+    s_submitter[0U].queue              = queue;
+    s_submitter[0U].request.startBlock = SIM_GATE_BLOCK;
+    s_submitter[0U].request.blockCount = 1U;
+    s_submitter[0U].request.isWrite    = false;
+    (void)pthread_create(&s_submitter[0U].thread, NULL, SIM_SubmitterTask, &s_submitter[0U]);
+    while (!s_simCard.isGateEntered)
+    {
+        (void)usleep(100U);
+    }
+
+    for (i = 1U; i <= count; i++)
+    {
+        s_submitter[i].queue = queue;
+        (void)memcpy(&s_submitter[i].request, &requests[i - 1U], sizeof(sim_request_t));
+        (void)pthread_create(&s_submitter[i].thread, NULL, SIM_SubmitterTask, &s_submitter[i]);
+        /* keep the submit order */
+        while (SIM_GetSubmittedRequests(queue) != (submitted + i + 1U))
+        {
+            (void)usleep(100U);
+        }
+    }
+
+    s_simCard.isGateReleased = true;
+    for (i = 0U; i <= count; i++)
+    {
+        (void)pthread_join(s_submitter[i].thread, NULL);
+    }
+}
+
+/* check the card transfers following the gate transfer */
+static bool SIM_CheckLog(const sim_request_t *expected, uint32_t count)
+{
+    uint32_t i;
+
+    SIM_CHECK(s_simCard.logCount == (count + 1U));
+    SIM_CHECK(s_simCard.log[0U].startBlock == SIM_GATE_BLOCK);
+    for (i = 0U; i < count; i++)
+    {
+        if ((s_simCard.log[i + 1U].startBlock != expected[i].startBlock) ||
+            (s_simCard.log[i + 1U].blockCount != expected[i].blockCount) ||
+            (s_simCard.log[i + 1U].isWrite != expected[i].isWrite))
+        {
+            (void)printf("  transfer %u: %s %u+%u, expected %s %u+%u\n", (unsigned int)i,
+                         s_simCard.log[i + 1U].isWrite ? "write" : "read",
+                         (unsigned int)s_simCard.log[i + 1U].startBlock,
+                         (unsigned int)s_simCard.log[i + 1U].blockCount, expected[i].isWrite ? "write" : "read",
+                         (unsigned int)expected[i].startBlock, (unsigned int)expected[i].blockCount);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void SIM_TestReset(void)
+{
+    sdmmc_queue_config_t config;
+    uint32_t i;
+
+    (void)memset(&s_simCard, 0, sizeof(s_simCard));
+    s_simCard.failBlock = SIM_CARD_BLOCKS;
+    for (i = 0U; i < sizeof(s_simCard.data); i++)
+    {
+        s_simCard.data[i] = (uint8_t)(i / FSL_SDMMC_DEFAULT_BLOCK_SIZE);
+    }
+
+    (void)memset(s_submitter, 0, sizeof(s_submitter));
+    for (i = 0U; i < SIM_MAX_REQUESTS; i++)
+    {
+        (void)memset(s_submitter[i].buffer, (int)(0xA0U + i), sizeof(s_submitter[i].buffer));
+    }
+
+    config.card              = &s_simCard;
+    config.transfer          = SIM_CardTransfer;
+    config.mergeBuffer       = s_mergeBuffer;
+    config.mergeBufferBlocks = SIM_MERGE_BUFFER_BLOCKS;
+    config.maxBlockCount     = SIM_MERGE_BUFFER_BLOCKS;
+    (void)SDMMC_QueueInit(&s_queue, &config);
+}
+
+static bool SIM_TestEmptyQueue(void)
+{
+    sdmmc_queue_config_t config;
+    sdmmc_queue_statistics_t statistics;
+    sdmmc_queue_t queue;
+
+    /* invalid configuration */
+    (void)memset(&config, 0, sizeof(config));
+    config.maxBlockCount = 1U;
+    SIM_CHECK(SDMMC_QueueInit(&queue, &config) == kStatus_InvalidArgument);
+    config.transfer      = SIM_CardTransfer;
+    config.maxBlockCount = 0U;
+    SIM_CHECK(SDMMC_QueueInit(&queue, &config) == kStatus_InvalidArgument);
+
+    /* invalid request is rejected without touching the queue */
+    SIM_CHECK(SDMMC_QueueSubmit(&s_queue, NULL, 0U, 1U, false) == kStatus_InvalidArgument);
+    SIM_CHECK(SDMMC_QueueSubmit(&s_queue, s_submitter[1U].buffer, 0U, 0U, true) == kStatus_InvalidArgument);
+    SDMMC_QueueGetStatistics(&s_queue, &statistics);
+    SIM_CHECK(statistics.submittedRequests == 0U);
+    SIM_CHECK(statistics.dispatchedCommands == 0U);
+    SIM_CHECK(s_simCard.logCount == 0U);
+
+    /* request to the empty queue is dispatched right away with the caller buffer */
+    SIM_CHECK(SDMMC_QueueSubmit(&s_queue, s_submitter[1U].buffer, 5U, 2U, false) == kStatus_Success);
+    SIM_CHECK(s_simCard.logCount == 1U);
+    SIM_CHECK(s_simCard.logBuffer[0U] == s_submitter[1U].buffer);
+    SIM_CHECK(memcmp(s_submitter[1U].buffer, &s_simCard.data[5U * FSL_SDMMC_DEFAULT_BLOCK_SIZE],
+                     2U * FSL_SDMMC_DEFAULT_BLOCK_SIZE) == 0);
+    SDMMC_QueueGetStatistics(&s_queue, &statistics);
+    SIM_CHECK(statistics.submittedRequests == 1U);
+    SIM_CHECK(statistics.dispatchedCommands == 1U);
+    SIM_CHECK(statistics.mergedRequests == 0U);
+
+    return true;
+}
+
+static bool SIM_TestMergeAdjacent(void)
+{
+    static const sim_request_t requests[] = {
+        {10U, 2U, true},
+        {12U, 2U, true},
+        {14U, 1U, true},
+        {8U, 2U, true},
+    };
+    static const sim_request_t expected[] = {
+        {8U, 7U, true},
+    };
+    sdmmc_queue_statistics_t statistics;
+    uint32_t i;
+
+    SIM_QueueRun(&s_queue, requests, 4U);
+    SIM_CHECK(SIM_CheckLog(expected, 1U));
+    SIM_CHECK(s_simCard.logBuffer[1U] == s_mergeBuffer);
+    for (i = 1U; i <= 4U; i++)
+    {
+        SIM_CHECK(s_submitter[i].status == kStatus_Success);
+        SIM_CHECK(memcmp(&s_simCard.data[requests[i - 1U].startBlock * FSL_SDMMC_DEFAULT_BLOCK_SIZE],
+                         s_submitter[i].buffer, requests[i - 1U].blockCount * FSL_SDMMC_DEFAULT_BLOCK_SIZE) == 0);
+    }
+
+    SDMMC_QueueGetStatistics(&s_queue, &statistics);
+    SIM_CHECK(statistics.submittedRequests == 5U);
+    SIM_CHECK(statistics.dispatchedCommands == 2U);
+    SIM_CHECK(statistics.mergedRequests == 3U);
+
+    return true;
+}
+
+static bool SIM_TestMergedReadData(void)
+{
+    static const sim_request_t requests[] = {
+        {21U, 3U, false},
+        {20U, 1U, false},
+    };
+    static const sim_request_t expected[] = {
+        {20U, 4U, false},
+    };
+
+    SIM_QueueRun(&s_queue, requests, 2U);
+    SIM_CHECK(SIM_CheckLog(expected, 1U));
+    SIM_CHECK(memcmp(s_submitter[1U].buffer, &s_simCard.data[21U * FSL_SDMMC_DEFAULT_BLOCK_SIZE],
+                     3U * FSL_SDMMC_DEFAULT_BLOCK_SIZE) == 0);
+    SIM_CHECK(memcmp(s_submitter[2U].buffer, &s_simCard.data[20U * FSL_SDMMC_DEFAULT_BLOCK_SIZE],
+                     FSL_SDMMC_DEFAULT_BLOCK_SIZE) == 0);
+
+    return true;
+}
+
+static bool SIM_TestMergeLimit(void)
+{
+    static const sim_request_t requests[] = {
+        {0U, 2U, true},
+        {2U, 2U, true},
+        {4U, 2U, true},
+    };
+    static const sim_request_t expectedLimited[] = {
+        {0U, 4U, true},
+        {4U, 2U, true},
+    };
+    static const sim_request_t expectedNoMerge[] = {
+        {0U, 2U, true},
+        {2U, 2U, true},
+        {4U, 2U, true},
+    };
+    sdmmc_queue_config_t config;
+
+    /* the merged transfer is limited by the merge buffer size */
+    SDMMC_QueueDeinit(&s_queue);
+    config.card              = &s_simCard;
+    config.transfer          = SIM_CardTransfer;
+    config.mergeBuffer       = s_mergeBuffer;
+    config.mergeBufferBlocks = 4U;
+    config.maxBlockCount     = SIM_MERGE_BUFFER_BLOCKS;
+    SIM_CHECK(SDMMC_QueueInit(&s_queue, &config) == kStatus_Success);
+    SIM_QueueRun(&s_queue, requests, 3U);
+    SIM_CHECK(SIM_CheckLog(expectedLimited, 2U));
+
+    /* and by the max block count of the card command */
+    SIM_TestReset();
+    SDMMC_QueueDeinit(&s_queue);
+    config.mergeBufferBlocks = SIM_MERGE_BUFFER_BLOCKS;
+    config.maxBlockCount     = 4U;
+    SIM_CHECK(SDMMC_QueueInit(&s_queue, &config) == kStatus_Success);
+    SIM_QueueRun(&s_queue, requests, 3U);
+    SIM_CHECK(SIM_CheckLog(expectedLimited, 2U));
+
+    /* no merge without the merge buffer */
+    SIM_TestReset();
+    SDMMC_QueueDeinit(&s_queue);
+    config.mergeBuffer = NULL;
+    SIM_CHECK(SDMMC_QueueInit(&s_queue, &config) == kStatus_Success);
+    SIM_QueueRun(&s_queue, requests, 3U);
+    SIM_CHECK(SIM_CheckLog(expectedNoMerge, 3U));
+
+    return true;
+}
+
+static bool SIM_TestElevatorOrder(void)
+{
+    static const sim_request_t requests[] = {
+        {700U, 1U, false}, {100U, 1U, false}, {1010U, 1U, false}, {300U, 1U, false}, {1005U, 1U, false},
+    };
+    /* ascending from the head block next to the gate transfer, then wrap to the lowest block */
+    static const sim_request_t expected[] = {
+        {1005U, 1U, false}, {1010U, 1U, false}, {100U, 1U, false}, {300U, 1U, false}, {700U, 1U, false},
+    };
+
+    SIM_QueueRun(&s_queue, requests, 5U);
+    SIM_CHECK(SIM_CheckLog(expected, 5U));
+
+    return true;
+}
+
+static bool SIM_TestReadPriority(void)
+{
+    static const sim_request_t requests[] = {
+        {100U, 1U, true},  {200U, 1U, true},  {10U, 1U, false}, {20U, 1U, false},
+        {30U, 1U, false},  {40U, 1U, false},  {50U, 1U, false}, {60U, 1U, false},
+    };
+    /* the write is forced after SDMMC_QUEUE_READ_BATCH_LIMIT read batches */
+    static const sim_request_t expected[] = {
+        {10U, 1U, false}, {20U, 1U, false}, {30U, 1U, false}, {40U, 1U, false},
+        {100U, 1U, true}, {50U, 1U, false}, {60U, 1U, false}, {200U, 1U, true},
+    };
+
+    SIM_CHECK(SDMMC_QUEUE_READ_BATCH_LIMIT == 4U);
+    SIM_QueueRun(&s_queue, requests, 8U);
+    SIM_CHECK(SIM_CheckLog(expected, 8U));
+
+    return true;
+}
+
+static bool SIM_TestOverlapOrder(void)
+{
+    static const sim_request_t requests[] = {
+        {50U, 4U, true},
+        {52U, 1U, false},
+        {52U, 1U, true},
+    };
+    /* the read after the overlapped write is not dispatched ahead of it, nor the later write ahead of the read */
+    static const sim_request_t expected[] = {
+        {50U, 4U, true},
+        {52U, 1U, false},
+        {52U, 1U, true},
+    };
+
+    SIM_QueueRun(&s_queue, requests, 3U);
+    SIM_CHECK(SIM_CheckLog(expected, 3U));
+    SIM_CHECK(memcmp(s_submitter[2U].buffer, &s_submitter[1U].buffer[2U * FSL_SDMMC_DEFAULT_BLOCK_SIZE],
+                     FSL_SDMMC_DEFAULT_BLOCK_SIZE) == 0);
+    SIM_CHECK(memcmp(&s_simCard.data[52U * FSL_SDMMC_DEFAULT_BLOCK_SIZE], s_submitter[3U].buffer,
+                     FSL_SDMMC_DEFAULT_BLOCK_SIZE) == 0);
+
+    return true;
+}
+
+static bool SIM_TestTransferError(void)
+{
+    static const sim_request_t requests[] = {
+        {30U, 1U, true},
+        {31U, 1U, true},
+        {40U, 1U, true},
+    };
+
+    /* every request merged into the failed transfer gets its status */
+    s_simCard.failBlock = 30U;
+    SIM_QueueRun(&s_queue, requests, 3U);
+    SIM_CHECK(s_submitter[1U].status == kStatus_Fail);
+    SIM_CHECK(s_submitter[2U].status == kStatus_Fail);
+    SIM_CHECK(s_submitter[3U].status == kStatus_Success);
+
+    return true;
+}
+
+int main(void)
+{
+    static const sim_test_t tests[] = {
+        {"queue_empty", SIM_TestEmptyQueue},
+        {"queue_merge_adjacent", SIM_TestMergeAdjacent},
+        {"queue_merged_read_data", SIM_TestMergedReadData},
+        {"queue_merge_limit", SIM_TestMergeLimit},
+        {"queue_elevator_order", SIM_TestElevatorOrder},
+        {"queue_read_priority", SIM_TestReadPriority},
+        {"queue_overlap_order", SIM_TestOverlapOrder},
+        {"queue_transfer_error", SIM_TestTransferError},
+    };
+    uint32_t failed = 0U;
+    uint32_t i;
+
+    SDMMC_OSAInit();
+
+    for (i = 0U; i < sizeof(tests) / sizeof(tests[0]); i++)
+    {
+        SIM_TestReset();
+        if (tests[i].func())
+        {
+            (void)printf("PASS %s\n", tests[i].name);
+        }
+        else
+        {
+            (void)printf("FAIL %s\n", tests[i].name);
+            failed++;
+        }
+        SDMMC_QueueDeinit(&s_queue);
+    }
+
+    (void)printf("%u/%u passed\n", (unsigned int)(i - failed), (unsigned int)i);
+
+    return failed == 0U ? 0 : 1;
+}
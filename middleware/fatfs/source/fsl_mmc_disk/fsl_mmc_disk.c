@@ -67,7 +67,8 @@ DRESULT mmc_disk_read(BYTE pdrv, BYTE* buff, LBA_t sector, UINT count)
 
 DRESULT mmc_disk_ioctl(BYTE pdrv, BYTE cmd, void* buff)
 {
-    DRESULT res = RES_OK;
+    DRESULT res    = RES_OK;
+    status_t error = kStatus_Success;
 
     if (pdrv != MMCDISK)
     {
@@ -107,7 +108,34 @@ DRESULT mmc_disk_ioctl(BYTE pdrv, BYTE cmd, void* buff)
             }
             break;
         case CTRL_SYNC:
-            res = RES_OK;
+            /* the written data is in the nonvolatile memory already if the cache is not enabled */
+            error = MMC_FlushCache(&g_mmc);
+            if ((error != kStatus_Success) && (error != kStatus_SDMMC_NotSupportYet))
+            {
+                res = RES_ERROR;
+            }
+            break;
+        case CTRL_TRIM:
+            if (buff)
+            {
+                /* buff holds the start and end sector of the block freed by the file system */
+                error = MMC_DiscardBlocks(&g_mmc, (uint32_t)((LBA_t *)buff)[0U],
+                                          (uint32_t)(((LBA_t *)buff)[1U] - ((LBA_t *)buff)[0U] + 1U));
+                if (error == kStatus_SDMMC_NotSupportYet)
+                {
+                    error = MMC_TrimBlocks(&g_mmc, (uint32_t)((LBA_t *)buff)[0U],
+                                           (uint32_t)(((LBA_t *)buff)[1U] - ((LBA_t *)buff)[0U] + 1U));
+                }
+                /* the trim is a hint only, it is fine if the card doesn't support it */
+                if ((error != kStatus_Success) && (error != kStatus_SDMMC_NotSupportYet))
+                {
+                    res = RES_ERROR;
+                }
+            }
+            else
+            {
+                res = RES_PARERR;
+            }
             break;
         default:
             res = RES_PARERR;
@@ -109,6 +109,23 @@ DRESULT sd_disk_ioctl(BYTE pdrv, BYTE cmd, void* buff)
         case CTRL_SYNC:
             result = RES_OK;
             break;
+        case CTRL_TRIM:
+            if (buff)
+            {
+                /* buff holds the start and end sector of the block freed by the file system */
+                status_t error = SD_DiscardBlocks(&g_sd, (uint32_t)((LBA_t *)buff)[0U],
+                                                  (uint32_t)(((LBA_t *)buff)[1U] - ((LBA_t *)buff)[0U] + 1U));
+                /* the trim is a hint only, it is fine if the card doesn't support it */
+                if ((error != kStatus_Success) && (error != kStatus_SDMMC_NotSupportYet))
+                {
+                    result = RES_ERROR;
+                }
+            }
+            else
+            {
+                result = RES_PARERR;
+            }
+            break;
         default:
             result = RES_PARERR;
             break;
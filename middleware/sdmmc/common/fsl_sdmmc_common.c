@@ -164,3 +164,257 @@ status_t SDMMC_SetCardInactive(sdmmchost_t *host)
 
     return kStatus_Success;
 }
+
+void SDMMC_BusGovernorReset(sdmmc_bus_governor_t *governor, uint32_t busClock_Hz)
+{
+    assert(governor != NULL);
+
+    (void)memset(governor, 0, sizeof(sdmmc_bus_governor_t));
+    governor->busClock_Hz = busClock_Hz;
+}
+
+void SDMMC_BusGovernorUpdate(sdmmc_bus_governor_t *governor, uint32_t event)
+{
+    assert(governor != NULL);
+
+    sdmmc_bus_governor_level_t *levelStat = &governor->levelStat[governor->level];
+    uint32_t backoff                      = 0U;
+
+    /* the result of the transfer before the pending level switch is ignored */
+    if ((governor->busClock_Hz == 0U) || (governor->level != governor->targetLevel))
+    {
+        return;
+    }
+
+    if (event == (uint32_t)kSDMMC_BusGovernorTransferSuccess)
+    {
+        governor->quietTransfers++;
+        if (governor->quietTransfers == SDMMC_BUS_GOVERNOR_QUIET_TRANSFERS)
+        {
+            governor->errorCount = 0U;
+            if (governor->isProbing)
+            {
+                governor->isProbing      = false;
+                levelStat->probeFailures = 0U;
+            }
+        }
+
+        if ((governor->level != 0U) && (governor->quietTransfers >= SDMMC_BUS_GOVERNOR_QUIET_TRANSFERS))
+        {
+            backoff =
+                MIN(governor->levelStat[governor->level - 1U].probeFailures, SDMMC_BUS_GOVERNOR_MAX_PROBE_BACKOFF);
+            if (governor->quietTransfers >= (SDMMC_BUS_GOVERNOR_QUIET_TRANSFERS << backoff))
+            {
+                governor->targetLevel = governor->level - 1U;
+            }
+        }
+
+        return;
+    }
+
+    if (event == (uint32_t)kSDMMC_BusGovernorCommandError)
+    {
+        levelStat->commandErrors++;
+    }
+    else if (event == (uint32_t)kSDMMC_BusGovernorDataError)
+    {
+        levelStat->dataErrors++;
+    }
+    else
+    {
+        levelStat->tuningErrors++;
+    }
+
+    governor->quietTransfers = 0U;
+    governor->errorCount++;
+
+    if ((uint32_t)governor->level + 1U >= SDMMC_BUS_GOVERNOR_LEVEL_COUNT)
+    {
+        return;
+    }
+
+    if (governor->isProbing)
+    {
+        levelStat->probeFailures++;
+    }
+    else if (governor->errorCount < SDMMC_BUS_GOVERNOR_ERROR_THRESHOLD)
+    {
+        return;
+    }
+    else
+    {
+        /* Intentional empty */
+    }
+
+    levelStat->stepDowns++;
+    governor->targetLevel = governor->level + 1U;
+}
+
+void SDMMC_BusGovernorSetLevel(sdmmc_bus_governor_t *governor, uint32_t level)
+{
+    assert(governor != NULL);
+    assert(level < SDMMC_BUS_GOVERNOR_LEVEL_COUNT);
+
+    governor->isProbing      = level < (uint32_t)governor->level;
+    governor->level          = (uint8_t)level;
+    governor->targetLevel    = (uint8_t)level;
+    governor->errorCount     = 0U;
+    governor->quietTransfers = 0U;
+}
+
+void SDMMC_LatencyHistogramRecord(sdmmc_latency_histogram_t *histogram, uint32_t latencyUs)
+{
+    assert(histogram != NULL);
+
+    uint32_t index = 0U;
+
+    while ((index < (SDMMC_LATENCY_HISTOGRAM_BUCKETS - 1U)) &&
+           (latencyUs >= (SDMMC_LATENCY_HISTOGRAM_BASE_US << index)))
+    {
+        index++;
+    }
+
+    histogram->bucket[index]++;
+    histogram->count++;
+    if (latencyUs > histogram->maxUs)
+    {
+        histogram->maxUs = latencyUs;
+    }
+}
+
+uint32_t SDMMC_LatencyHistogramPercentile(const sdmmc_latency_histogram_t *histogram, uint32_t percent)
+{
+    assert(histogram != NULL);
+    assert((percent != 0U) && (percent <= 100U));
+
+    /* rank of the percentile sample, rounded up */
+    uint32_t rank  = (uint32_t)((((uint64_t)histogram->count * percent) + 99U) / 100U);
+    uint32_t count = 0U;
+    uint32_t bound = histogram->maxUs;
+    uint32_t index = 0U;
+
+    if (histogram->count == 0U)
+    {
+        return 0U;
+    }
+
+    for (index = 0U; index < SDMMC_LATENCY_HISTOGRAM_BUCKETS; index++)
+    {
+        count += histogram->bucket[index];
+        if (count >= rank)
+        {
+            break;
+        }
+    }
+
+    /* the last bucket has no upper bound */
+    if ((index < (SDMMC_LATENCY_HISTOGRAM_BUCKETS - 1U)) && ((SDMMC_LATENCY_HISTOGRAM_BASE_US << index) < bound))
+    {
+        bound = SDMMC_LATENCY_HISTOGRAM_BASE_US << index;
+    }
+
+    return bound;
+}
+
+void SDMMC_UpdatePendingReads(volatile uint32_t *pendingReads, bool isPending)
+{
+    assert(pendingReads != NULL);
+
+    uint32_t sr = 0U;
+
+    SDMMC_OSAEnterCritical(&sr);
+    if (isPending)
+    {
+        (*pendingReads)++;
+    }
+    else if (*pendingReads != 0U)
+    {
+        (*pendingReads)--;
+    }
+    else
+    {
+        /* empty with intentional */
+    }
+    SDMMC_OSAExitCritical(sr);
+}
+
+void SDMMC_WaitPendingReads(volatile uint32_t *pendingReads)
+{
+    assert(pendingReads != NULL);
+
+    /* the reader of any priority takes the card lock in the delay */
+    while (*pendingReads != 0U)
+    {
+        SDMMC_OSADelay(1U);
+    }
+}
+
+#if SDMMC_ENABLE_INSTRUMENTATION
+void SDMMC_InstrumentReset(sdmmc_instrument_t *instrument)
+{
+    assert(instrument != NULL);
+
+#if defined(SDMMC_INSTRUMENT_DWT_CYCLES)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
+    (void)memset(instrument, 0, sizeof(sdmmc_instrument_t));
+}
+
+uint32_t SDMMC_InstrumentElapsedUs(uint32_t startCycles)
+{
+    /* the unsigned subtraction is correct across one counter wrap */
+    return (SDMMC_INSTRUMENT_GET_CYCLES() - startCycles) / SDMMC_INSTRUMENT_CYCLES_PER_US;
+}
+
+void SDMMC_InstrumentTransfer(sdmmc_instrument_t *instrument,
+                              const sdmmchost_transfer_t *content,
+                              status_t error,
+                              uint32_t startCycles)
+{
+    assert(instrument != NULL);
+    assert(content != NULL);
+
+    sdmmc_command_instrument_t *command =
+        &instrument->command[content->command->index & (SDMMC_INSTRUMENT_COMMAND_COUNT - 1U)];
+    uint32_t bytes = 0U;
+
+    SDMMC_LatencyHistogramRecord(&command->latency, SDMMC_InstrumentElapsedUs(startCycles));
+    command->count++;
+
+    if (error != kStatus_Success)
+    {
+        command->errors++;
+        if (content->data != NULL)
+        {
+            instrument->dataErrors++;
+        }
+        else
+        {
+            instrument->commandErrors++;
+        }
+        return;
+    }
+
+    if (((content->command->responseType == kCARD_ResponseTypeR1) ||
+         (content->command->responseType == kCARD_ResponseTypeR1b)) &&
+        ((content->command->response[0U] & SDMMC_MASK(kSDMMC_R1CommandCrcErrorFlag)) != 0U))
+    {
+        instrument->cardCrcErrors++;
+    }
+
+    if (content->data != NULL)
+    {
+        bytes = content->data->blockSize * content->data->blockCount;
+        if (content->data->rxData != NULL)
+        {
+            instrument->bytesRead += bytes;
+        }
+        else
+        {
+            instrument->bytesWritten += bytes;
+        }
+    }
+}
+#endif
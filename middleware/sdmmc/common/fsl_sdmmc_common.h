@@ -282,6 +282,146 @@ typedef struct _sdio_usr_param
     uint32_t capability;         /*!< board capability flag */
 } sdio_usr_param_t;
 
+/*! @brief card re-tuning statistics */
+typedef struct _sdmmc_retuning_statistics
+{
+    uint32_t avoidedRetries;  /*!< re-tuning executed between the requests for the host re-tuning request, each of them
+                                   avoids one rejected transfer and its retry */
+    uint32_t errorTuning;     /*!< re-tuning executed after the transfer failed */
+    uint32_t transferRetries; /*!< transfers sent again after the transfer failed */
+} sdmmc_retuning_statistics_t;
+
+/*! @brief bus speed governor level count, the bus clock of level n is the clock selected by the card init / 2^n */
+#ifndef SDMMC_BUS_GOVERNOR_LEVEL_COUNT
+#define SDMMC_BUS_GOVERNOR_LEVEL_COUNT (3U)
+#endif
+/*! @brief errors in one level to step down to the next level */
+#ifndef SDMMC_BUS_GOVERNOR_ERROR_THRESHOLD
+#define SDMMC_BUS_GOVERNOR_ERROR_THRESHOLD (4U)
+#endif
+/*! @brief successful transfers without error to clear the error count and to probe the upper level */
+#ifndef SDMMC_BUS_GOVERNOR_QUIET_TRANSFERS
+#define SDMMC_BUS_GOVERNOR_QUIET_TRANSFERS (4096U)
+#endif
+/*! @brief maximum shift of the quiet period, the period is doubled for each failed probe of the upper level */
+#define SDMMC_BUS_GOVERNOR_MAX_PROBE_BACKOFF (6U)
+/*! @brief bus clock of the bus speed governor level */
+#define SDMMC_BUS_GOVERNOR_LEVEL_CLOCK(governor, level) ((governor)->busClock_Hz >> (uint32_t)(level))
+
+/*! @brief bus speed governor transfer event */
+typedef enum _sdmmc_bus_governor_event
+{
+    kSDMMC_BusGovernorTransferSuccess = 0U, /*!< transfer success */
+    kSDMMC_BusGovernorCommandError    = 1U, /*!< command CRC, timeout, end bit or index error */
+    kSDMMC_BusGovernorDataError       = 2U, /*!< data CRC, timeout or end bit error */
+    kSDMMC_BusGovernorTuningError     = 3U, /*!< tuning failed */
+} sdmmc_bus_governor_event_t;
+
+/*! @brief bus speed governor level statistics */
+typedef struct _sdmmc_bus_governor_level
+{
+    uint32_t commandErrors; /*!< command errors in the level */
+    uint32_t dataErrors;    /*!< data errors in the level */
+    uint32_t tuningErrors;  /*!< tuning errors in the level */
+    uint32_t stepDowns;     /*!< step down count from the level */
+    uint32_t probeFailures; /*!< consecutive failed probes of the level */
+} sdmmc_bus_governor_level_t;
+
+/*! @brief bus speed governor, keeps the bus clock of the selected timing at the highest level without repeated errors */
+typedef struct _sdmmc_bus_governor
+{
+    uint32_t busClock_Hz;    /*!< level 0 bus clock selected by the card init, 0 if the governor is disabled */
+    uint8_t level;           /*!< current level */
+    uint8_t targetLevel;     /*!< level switched by the card driver before the next request */
+    bool isProbing;          /*!< the level is probed after step up, the first error steps down again */
+    uint32_t errorCount;     /*!< errors in the current level since the last quiet period */
+    uint32_t quietTransfers; /*!< successful transfers since the last error */
+    sdmmc_bus_governor_level_t levelStat[SDMMC_BUS_GOVERNOR_LEVEL_COUNT]; /*!< statistics of each level */
+} sdmmc_bus_governor_t;
+
+/*! @brief latency histogram bucket count, bucket n counts the latency below SDMMC_LATENCY_HISTOGRAM_BASE_US << n and
+ * not below the bound of bucket n - 1, the last bucket counts the rest */
+#ifndef SDMMC_LATENCY_HISTOGRAM_BUCKETS
+#define SDMMC_LATENCY_HISTOGRAM_BUCKETS (16U)
+#endif
+/*! @brief latency histogram bucket 0 upper bound in us */
+#ifndef SDMMC_LATENCY_HISTOGRAM_BASE_US
+#define SDMMC_LATENCY_HISTOGRAM_BASE_US (125U)
+#endif
+
+/*! @brief latency histogram in log2 buckets */
+typedef struct _sdmmc_latency_histogram
+{
+    uint32_t count;                                   /*!< sample count */
+    uint32_t maxUs;                                   /*!< max latency in us */
+    uint32_t bucket[SDMMC_LATENCY_HISTOGRAM_BUCKETS]; /*!< sample count of each bucket */
+} sdmmc_latency_histogram_t;
+
+/*! @brief enable the transfer instrumentation of the card drivers, it takes about 5KB RAM per card */
+#ifndef SDMMC_ENABLE_INSTRUMENTATION
+#define SDMMC_ENABLE_INSTRUMENTATION (0U)
+#endif
+
+#if SDMMC_ENABLE_INSTRUMENTATION
+/*! @brief instrumented command index count, the application command is counted with the same index command */
+#define SDMMC_INSTRUMENT_COMMAND_COUNT (64U)
+/*! @brief instrumentation cycle counter, the DWT cycle counter is enabled by SDMMC_InstrumentReset by default */
+#ifndef SDMMC_INSTRUMENT_GET_CYCLES
+#define SDMMC_INSTRUMENT_GET_CYCLES() (DWT->CYCCNT)
+#define SDMMC_INSTRUMENT_DWT_CYCLES
+#endif
+/*! @brief instrumentation cycle counter frequency in MHz */
+#ifndef SDMMC_INSTRUMENT_CYCLES_PER_US
+#define SDMMC_INSTRUMENT_CYCLES_PER_US (SystemCoreClock / 1000000U)
+#endif
+
+/*! @brief start cycles of the instrumented operation */
+#define SDMMC_INSTRUMENT_TIMESTAMP() SDMMC_INSTRUMENT_GET_CYCLES()
+/*! @brief record the instrumented transfer */
+#define SDMMC_INSTRUMENT_TRANSFER(instrument, content, error, start) \
+    SDMMC_InstrumentTransfer((instrument), (content), (error), (start))
+/*! @brief record the instrumented busy wait */
+#define SDMMC_INSTRUMENT_BUSY_WAIT(instrument, start) \
+    SDMMC_LatencyHistogramRecord(&(instrument)->busyWait, SDMMC_InstrumentElapsedUs(start))
+/*! @brief increase the instrumentation counter */
+#define SDMMC_INSTRUMENT_COUNT(instrument, counter) ((instrument)->counter++)
+#else
+#define SDMMC_INSTRUMENT_TIMESTAMP() (0U)
+#define SDMMC_INSTRUMENT_TRANSFER(instrument, content, error, start) ((void)(start))
+#define SDMMC_INSTRUMENT_BUSY_WAIT(instrument, start) ((void)(start))
+#define SDMMC_INSTRUMENT_COUNT(instrument, counter)
+#endif
+
+#if SDMMC_ENABLE_INSTRUMENTATION
+/*! @brief command instrumentation */
+typedef struct _sdmmc_command_instrument
+{
+    uint32_t count;                    /*!< command transfers, retries included */
+    uint32_t errors;                   /*!< command transfer failures */
+    sdmmc_latency_histogram_t latency; /*!< command transfer latency */
+} sdmmc_command_instrument_t;
+
+/*! @brief card transfer instrumentation
+ *
+ * The host reports the transfer failure without the CRC or timeout cause, so the failures are split by the transfer
+ * with or without data, the CRC error of the command received by the card is reported by COM_CRC_ERROR of the
+ * following R1 response.
+ */
+typedef struct _sdmmc_instrument
+{
+    uint64_t bytesRead;                 /*!< data bytes read */
+    uint64_t bytesWritten;              /*!< data bytes written */
+    uint32_t commandErrors;             /*!< failed transfers without data */
+    uint32_t dataErrors;                /*!< failed transfers with data */
+    uint32_t cardCrcErrors;             /*!< R1 response reports COM_CRC_ERROR */
+    uint32_t retries;                   /*!< transfer retries */
+    uint32_t tuningEvents;              /*!< tuning executed */
+    uint32_t tuningErrors;              /*!< tuning failed */
+    sdmmc_latency_histogram_t busyWait; /*!< card busy wait latency */
+    sdmmc_command_instrument_t command[SDMMC_INSTRUMENT_COMMAND_COUNT]; /*!< instrumentation of each command index */
+} sdmmc_instrument_t;
+#endif
+
 /*! @brief tuning pattern */
 #if SDMMCHOST_SUPPORT_DDR50 || SDMMCHOST_SUPPORT_SDR104 || SDMMCHOST_SUPPORT_SDR50 || SDMMCHOST_SUPPORT_HS200 || \
     SDMMCHOST_SUPPORT_HS400
@@ -359,6 +499,102 @@ status_t SDMMC_SetBlockSize(sdmmchost_t *host, uint32_t blockSize);
  */
 status_t SDMMC_SetCardInactive(sdmmchost_t *host);
 
+/*!
+ * @brief Resets the bus speed governor.
+ *
+ * @param governor bus speed governor.
+ * @param busClock_Hz bus clock selected by the card init, 0 to disable the governor.
+ */
+void SDMMC_BusGovernorReset(sdmmc_bus_governor_t *governor, uint32_t busClock_Hz);
+
+/*!
+ * @brief Updates the bus speed governor with the transfer result.
+ *
+ * The target level is stepped down when the errors of the current level reach SDMMC_BUS_GOVERNOR_ERROR_THRESHOLD or on
+ * the first error of the probed level, and stepped up after SDMMC_BUS_GOVERNOR_QUIET_TRANSFERS successful transfers.
+ * The card driver switches the bus clock to the target level between the requests.
+ *
+ * @param governor bus speed governor.
+ * @param event transfer result, reference sdmmc_bus_governor_event_t.
+ */
+void SDMMC_BusGovernorUpdate(sdmmc_bus_governor_t *governor, uint32_t event);
+
+/*!
+ * @brief Sets the bus speed governor level after the bus clock is switched.
+ *
+ * @param governor bus speed governor.
+ * @param level the level switched to.
+ */
+void SDMMC_BusGovernorSetLevel(sdmmc_bus_governor_t *governor, uint32_t level);
+
+/*!
+ * @brief Records a latency sample in the latency histogram.
+ *
+ * @param histogram latency histogram.
+ * @param latencyUs latency in us.
+ */
+void SDMMC_LatencyHistogramRecord(sdmmc_latency_histogram_t *histogram, uint32_t latencyUs);
+
+/*!
+ * @brief Gets the latency percentile from the latency histogram.
+ *
+ * The result is the upper bound of the bucket holding the percentile and not above the max latency, so it is
+ * accurate to the bucket width only.
+ *
+ * @param histogram latency histogram.
+ * @param percent percentile from 1 to 100, such as 99 for p99.
+ * @return latency percentile in us, 0 if the histogram is empty.
+ */
+uint32_t SDMMC_LatencyHistogramPercentile(const sdmmc_latency_histogram_t *histogram, uint32_t percent);
+
+/*!
+ * @brief Updates the pending read request count of the card.
+ *
+ * The read request is pending from the card access start to the card lock taken, the latency bounded write yields the
+ * card lock between the chunks while the count is not 0.
+ *
+ * @param pendingReads pending read request count.
+ * @param isPending true to add a pending read request, false to remove it.
+ */
+void SDMMC_UpdatePendingReads(volatile uint32_t *pendingReads, bool isPending);
+
+/*!
+ * @brief Waits until all the pending read requests take the card lock released by the write.
+ *
+ * @param pendingReads pending read request count.
+ */
+void SDMMC_WaitPendingReads(volatile uint32_t *pendingReads);
+
+#if SDMMC_ENABLE_INSTRUMENTATION
+/*!
+ * @brief Resets the transfer instrumentation, the DWT cycle counter is enabled if it is the instrumentation clock.
+ *
+ * @param instrument transfer instrumentation.
+ */
+void SDMMC_InstrumentReset(sdmmc_instrument_t *instrument);
+
+/*!
+ * @brief Gets the elapsed time of the instrumented operation.
+ *
+ * @param startCycles start cycles got by SDMMC_INSTRUMENT_TIMESTAMP.
+ * @return elapsed time in us.
+ */
+uint32_t SDMMC_InstrumentElapsedUs(uint32_t startCycles);
+
+/*!
+ * @brief Records the transfer in the instrumentation.
+ *
+ * @param instrument transfer instrumentation.
+ * @param content transfer content.
+ * @param error transfer status.
+ * @param startCycles start cycles got by SDMMC_INSTRUMENT_TIMESTAMP.
+ */
+void SDMMC_InstrumentTransfer(sdmmc_instrument_t *instrument,
+                              const sdmmchost_transfer_t *content,
+                              status_t error,
+                              uint32_t startCycles);
+#endif
+
 /* @} */
 
 #if defined(__cplusplus)
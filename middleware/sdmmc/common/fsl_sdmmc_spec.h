@@ -264,6 +264,19 @@ typedef enum _sd_switch_mode
     kSD_SwitchSet   = 1U, /*!< SD switch mode 1: set function */
 } sd_switch_mode_t;
 
+/*! @brief SD card speed class control function, the argument bit[31:28] of CMD20 */
+typedef enum _sd_speed_class_control
+{
+    kSD_SpeedClassStartRecording = 0U, /*!< start recording */
+    kSD_SpeedClassCreateDir      = 1U, /*!< create directory entry */
+    kSD_SpeedClassEndRecording   = 2U, /*!< end recording */
+    kSD_SpeedClassUpdateCI       = 3U, /*!< update continuous information */
+    kSD_SpeedClassSuspendAU      = 4U, /*!< suspend AU */
+    kSD_SpeedClassResumeAU       = 5U, /*!< resume AU */
+    kSD_SpeedClassSetFreeAU      = 6U, /*!< set free AU */
+    kSD_SpeedClassReleaseDir     = 7U, /*!< release directory entry */
+} sd_speed_class_control_t;
+
 /*! @brief SD card CSD register flags
  * @anchor _sd_csd_flag
  */
@@ -573,8 +586,38 @@ typedef enum _mmc_command
     kMMC_EraseGroupEnd          = 36U, /*!< Erase Group End */
     kMMC_FastInputOutput        = 39U, /*!< Fast IO */
     kMMC_GoInterruptState       = 40U, /*!< Go interrupt State */
+    kMMC_QueuedTaskParameter    = 44U, /*!< Queued task parameter */
+    kMMC_QueuedTaskAddress      = 45U, /*!< Queued task address */
+    kMMC_ExecuteReadTask        = 46U, /*!< Execute read task */
+    kMMC_ExecuteWriteTask       = 47U, /*!< Execute write task */
+    kMMC_CmdqTaskManagement     = 48U, /*!< Command queue task management */
 } mmc_command_t;
 
+/*! @brief The bit mask for BLOCK COUNT field in CMD44 */
+#define MMC_CMDQ_BLOCK_COUNT_MASK (0x0000FFFFU)
+/*! @brief The bit shift for TASK ID field in CMD44/CMD46/CMD47/CMD48 */
+#define MMC_CMDQ_TASK_ID_SHIFT (16U)
+/*! @brief The bit mask for TASK ID field in CMD44/CMD46/CMD47/CMD48 */
+#define MMC_CMDQ_TASK_ID_MASK (0x001F0000U)
+/*! @brief The bit mask for PRIORITY field in CMD44 */
+#define MMC_CMDQ_PRIORITY_MASK (0x00800000U)
+/*! @brief The bit mask for FORCED PROGRAMMING field in CMD44, the data is programmed to the nonvolatile storage */
+#define MMC_CMDQ_FORCED_PROGRAMMING_MASK (0x01000000U)
+/*! @brief The bit mask for DATA DIRECTION field in CMD44, set for read task */
+#define MMC_CMDQ_DATA_DIRECTION_READ_MASK (0x40000000U)
+/*! @brief The bit mask for RELIABLE WRITE REQUEST field in CMD44 */
+#define MMC_CMDQ_RELIABLE_WRITE_MASK (0x80000000U)
+/*! @brief The bit mask for SEND QUEUE STATUS field in CMD13, the response is QSR if set */
+#define MMC_CMDQ_SEND_QUEUE_STATUS_MASK (0x00008000U)
+/*! @brief The TM OP-CODE of CMD48 to discard the entire queue */
+#define MMC_CMDQ_DISCARD_ENTIRE_QUEUE (1U)
+/*! @brief The maximum task number of the command queue */
+#define MMC_CMDQ_MAX_DEPTH (32U)
+/*! @brief The bit mask for QUEUE DEPTH field in CMDQ_DEPTH of Extended CSD, the value is depth - 1 */
+#define MMC_CMDQ_DEPTH_MASK (0x1FU)
+/*! @brief mmc command queue mode enable */
+#define MMC_CMDQ_MODE_ENABLE (1U)
+
 /*! @brief MMC card classified as voltage range */
 typedef enum _mmc_classified_voltage
 {
@@ -703,6 +746,69 @@ enum
 #define MMC_CACHE_CONTROL_ENABLE (1U)
 /*! @brief mmc cache flush */
 #define MMC_CACHE_TRIGGER_FLUSH (1U)
+/*! @brief mmc sanitize start */
+#define MMC_SANITIZE_START (1U)
+/*! @brief The bit mask for SEC_GB_CL_EN field in SEC_FEATURE_SUPPORT, trim and discard are supported if set */
+#define MMC_SEC_FEATURE_SUPPORT_GB_CL_EN_MASK (0x10U)
+/*! @brief The bit mask for SEC_SANITIZE field in SEC_FEATURE_SUPPORT */
+#define MMC_SEC_FEATURE_SUPPORT_SANITIZE_MASK (0x40U)
+/*! @brief The bit mask for SUPPORTED field in BKOPS_SUPPORT */
+#define MMC_BKOPS_SUPPORT_MASK (0x01U)
+/*! @brief mmc background operations start */
+#define MMC_BKOPS_START (1U)
+/*! @brief The bit mask for OUTSTANDING field in BKOPS_STATUS */
+#define MMC_BKOPS_STATUS_OUTSTANDING_MASK (0x03U)
+/*! @brief The bit mask for HPI_SUPPORT field in HPI_FEATURES */
+#define MMC_HPI_FEATURE_SUPPORT_MASK (0x01U)
+/*! @brief The bit mask for HPI_IMPLEMENTATION field in HPI_FEATURES, HPI is CMD12 if set, otherwise CMD13 */
+#define MMC_HPI_FEATURE_CMD12_MASK (0x02U)
+/*! @brief mmc high priority interrupt management enable */
+#define MMC_HPI_MANAGEMENT_ENABLE (1U)
+/*! @brief The bit mask for HPI bit in CMD12/CMD13 argument */
+#define MMC_HPI_ARGUMENT_MASK (0x01U)
+
+/*! @brief MMC card background operations enable, the value of BKOPS_EN */
+typedef enum _mmc_bkops_mode
+{
+    kMMC_BkopsManual = 0x01U, /*!< host starts the background operations by BKOPS_START, it is one time programmable */
+    kMMC_BkopsAuto   = 0x02U, /*!< card starts the background operations when idle, extended CSD revision 1.8 */
+} mmc_bkops_mode_t;
+
+/*! @brief MMC card background operations status, the OUTSTANDING field of BKOPS_STATUS */
+typedef enum _mmc_bkops_status
+{
+    kMMC_BkopsStatusNotRequired         = 0U, /*!< no operations required */
+    kMMC_BkopsStatusNonCritical         = 1U, /*!< operations outstanding, non critical */
+    kMMC_BkopsStatusPerformanceImpacted = 2U, /*!< operations outstanding, performance being impacted */
+    kMMC_BkopsStatusCritical            = 3U, /*!< operations outstanding, critical */
+} mmc_bkops_status_t;
+
+/*! @brief MMC card erase command argument */
+typedef enum _mmc_erase_argument
+{
+    kMMC_EraseArgument   = 0x00000000U, /*!< erase the erase groups */
+    kMMC_TrimArgument    = 0x00000001U, /*!< trim the write blocks, the content is set to the erased value */
+    kMMC_DiscardArgument = 0x00000003U, /*!< discard the write blocks, the content is indeterminate */
+} mmc_erase_argument_t;
+
+/*! @brief The bit mask for FORCED_PRG field in CMD23, the data is programmed to the nonvolatile storage directly */
+#define MMC_SET_BLOCK_COUNT_FORCED_PROGRAMMING_MASK (0x01000000U)
+/*! @brief The bit mask for PACKED field in CMD23 */
+#define MMC_SET_BLOCK_COUNT_PACKED_MASK (0x40000000U)
+/*! @brief The bit mask for reliable write request field in CMD23 */
+#define MMC_SET_BLOCK_COUNT_RELIABLE_WRITE_MASK (0x80000000U)
+/*! @brief The bit mask for EN_REL_WR field in WR_REL_PARAM, the enhanced reliable write is supported */
+#define MMC_WRITE_RELIABILITY_PARAMETER_EN_REL_WR_MASK (0x04U)
+/*! @brief mmc packed command header version */
+#define MMC_PACKED_COMMAND_VERSION (1U)
+/*! @brief mmc packed command header read type */
+#define MMC_PACKED_COMMAND_READ (1U)
+/*! @brief mmc packed command header write type */
+#define MMC_PACKED_COMMAND_WRITE (2U)
+/*! @brief The bit mask for ERROR field in PACKED_COMMAND_STATUS */
+#define MMC_PACKED_COMMAND_STATUS_ERROR_MASK (0x01U)
+/*! @brief The bit mask for INDEXED ERROR field in PACKED_COMMAND_STATUS */
+#define MMC_PACKED_COMMAND_STATUS_INDEXED_ERROR_MASK (0x02U)
 
 /*! @brief MMC card high-speed timing(HS_TIMING in Extended CSD) */
 typedef enum _mmc_high_speed_timing
@@ -852,8 +958,15 @@ typedef enum _mmc_extended_csd_access_mode
 /*! @brief EXT CSD byte index */
 typedef enum _mmc_extended_csd_index
 {
+    kMMC_ExtendedCsdIndexCmdqModeEnable       = 15U,  /*!< command queue mode enable */
     kMMC_ExtendedCsdIndexFlushCache           = 32U,  /*!< flush cache */
     kMMC_ExtendedCsdIndexCacheControl         = 33U,  /*!< cache control */
+    kMMC_ExtendedCsdIndexPackedFailureIndex   = 35U,  /*!< packed command failure index */
+    kMMC_ExtendedCsdIndexPackedCommandStatus  = 36U,  /*!< packed command status */
+    kMMC_ExtendedCsdIndexHpiManagement        = 161U, /*!< HPI management */
+    kMMC_ExtendedCsdIndexBkopsEnable          = 163U, /*!< background operations enable */
+    kMMC_ExtendedCsdIndexBkopsStart           = 164U, /*!< manual background operations start */
+    kMMC_ExtendedCsdIndexSanitizeStart        = 165U, /*!< sanitize start */
     kMMC_ExtendedCsdIndexBootPartitionWP      = 173U, /*!< Boot partition write protect */
     kMMC_ExtendedCsdIndexEraseGroupDefinition = 175U, /*!< Erase Group Def */
     kMMC_ExtendedCsdIndexBootBusConditions    = 177U, /*!< Boot Bus conditions */
@@ -863,6 +976,7 @@ typedef enum _mmc_extended_csd_index
     kMMC_ExtendedCsdIndexHighSpeedTiming      = 185U, /*!< High-speed Timing */
     kMMC_ExtendedCsdIndexPowerClass           = 187U, /*!< Power Class */
     kMMC_ExtendedCsdIndexCommandSet           = 191U, /*!< Command Set */
+    kMMC_ExtendedCsdIndexBkopsStatus          = 246U, /*!< background operations status */
 } mmc_extended_csd_index_t;
 
 /*! @brief mmc driver strength
@@ -986,8 +1100,18 @@ typedef struct _sd_status
     uint8_t eraseOffset;     /*!< fixed offset value added to erase time */
     uint8_t uhsSpeedGrade;   /*!< speed grade for UHS mode */
     uint8_t uhsAuSize;       /*!< size of AU for UHS mode */
+    uint8_t discardSupport;  /*!< card supports discard */
+    uint8_t fuleSupport;     /*!< card supports full user area logical erase */
 } sd_status_t;
 
+/*! @brief SD card erase command argument */
+typedef enum _sd_erase_argument
+{
+    kSD_EraseArgument   = 0x00000000U, /*!< erase the write blocks */
+    kSD_DiscardArgument = 0x00000001U, /*!< discard the write blocks, the content is indeterminate */
+    kSD_FuleArgument    = 0x00000002U, /*!< full user area logical erase */
+} sd_erase_argument_t;
+
 /*! @brief SD card CID register */
 typedef struct _sd_cid
 {
@@ -1095,6 +1219,7 @@ typedef struct _mmc_csd
 /*! @brief MMC card Extended CSD register (unit: byte). */
 typedef struct _mmc_extended_csd
 {
+    uint8_t cmdqModeEnable;                   /*!< command queue mode enable[15]*/
     /*uint8_t SecureRemoveType;*/             /*!< secure removal type[16]*/
     /*uint8_t enProductStateAware;*/          /*!< product state awareness enablement[17]*/
     /*uint32_t maxPreLoadDataSize;*/          /*!< max preload data size[21-18]*/
@@ -1104,8 +1229,8 @@ typedef struct _mmc_extended_csd
     /*uint8_t modeConfig;*/                   /*!< mode config [30]*/
     uint8_t cacheCtrl;                        /*!< control to turn on/off cache[33]*/
     /*uint8_t pwroffNotify;*/                 /*!< power off notification[34]*/
-    /*uint8_t packedCmdFailIndex;*/           /*!< packed cmd fail index [35]*/
-    /*uint8_t packedCmdStatus;*/              /*!< packed cmd status[36]*/
+    uint8_t packedCmdFailIndex;               /*!< packed cmd fail index [35]*/
+    uint8_t packedCmdStatus;                  /*!< packed cmd status[36]*/
     /*uint32_t contextConfig[4U];*/           /*!< context configuration[51-37]*/
     /*uint16_t extPartitionAttr;*/            /*!< extended partitions attribut[53-52]*/
     /*uint16_t exceptEventStatus;*/           /*!< exception events status[55-54]*/
@@ -1124,8 +1249,9 @@ typedef struct _mmc_extended_csd
     /*uint32_t generalPartitionSize[3];*/     /*!< general purpose partition size[154-143]*/
     uint8_t partitionAttribute;               /*!< partition attribute [156]*/
     /*uint32_t maxEnhanceAreaSize;*/          /*!< max enhance area size [159-157]*/
-    /*uint8_t hpiManagementEn;*/              /*!< HPI management [161]*/
-    /*uint8_t writeReliabilityParameter;*/    /*!< write reliability parameter register[166] */
+    uint8_t hpiManagementEn;                  /*!< HPI management [161]*/
+    uint8_t bkOpsEnable;                      /*!< background operations enable [163]*/
+    uint8_t writeReliabilityParameter;        /*!< write reliability parameter register[166] */
     /*uint8_t writeReliabilitySet;*/          /*!< write reliability setting register[167] */
     /*uint8_t rpmbSizeMult;*/                 /*!< RPMB size multi [168]*/
     /*uint8_t fwConfig;*/                     /*!< FW configuration[169]*/
@@ -1146,7 +1272,7 @@ typedef struct _mmc_extended_csd
     uint8_t csdStructureVersion;              /*!< CSD structure version [194] */
     uint8_t cardType;                         /*!< Card Type [196] */
     uint8_t ioDriverStrength;                 /*!< IO driver strength [197] */
-    /*uint8_t OutofInterruptBusyTiming;*/     /*!< out of interrupt busy timing [198] */
+    uint8_t outOfInterruptBusyTiming;         /*!< out of interrupt busy timing [198] */
     uint8_t partitionSwitchTimeout;           /*!< partition switch timing [199] */
     uint8_t powerClass52MHz195V;              /*!< Power Class for 52MHz @ 1.95V [200] */
     uint8_t powerClass26MHz195V;              /*!< Power Class for 26MHz @ 1.95V [201] */
@@ -1171,10 +1297,10 @@ typedef struct _mmc_extended_csd
     uint8_t highCapacityEraseTimeout;          /*!< High-capacity erase timeout [223] */
     uint8_t highCapacityEraseUnitSize;         /*!< High-capacity erase unit size [224] */
     uint8_t accessSize;                        /*!< Access size [225] */
-    /*uint8_t secureTrimMultiplier;*/          /*!< secure trim multiplier[229]*/
-    /*uint8_t secureEraseMultiplier;*/         /*!< secure erase multiplier[230]*/
-    /*uint8_t secureFeatureSupport;*/          /*!< secure feature support[231]*/
-    /*uint32_t trimMultiplier;*/               /*!< trim multiplier[232]*/
+    uint8_t secureTrimMultiplier;              /*!< secure trim multiplier[229]*/
+    uint8_t secureEraseMultiplier;             /*!< secure erase multiplier[230]*/
+    uint8_t secureFeatureSupport;              /*!< secure feature support[231]*/
+    uint8_t trimMultiplier;                    /*!< trim multiplier[232]*/
     uint8_t minReadPerformance8bitAt52MHZDDR;  /*!< Minimum read performance for 8bit at DDR 52MHZ[234]*/
     uint8_t minWritePerformance8bitAt52MHZDDR; /*!< Minimum write performance for 8bit at DDR 52MHZ[235]*/
     uint8_t powerClass200MHZVCCQ130VVCC360V;   /*!< power class for 200MHZ, at VCCQ= 1.3V,VCC=3.6V[236]*/
@@ -1183,20 +1309,22 @@ typedef struct _mmc_extended_csd
     uint8_t powerClass52MHZDDR360V;            /*!< power class for 52MHZ,DDR at Vcc 3.6V[239]*/
     /*uint8_t iniTimeoutAP;*/                  /*!< 1st initialization time after partitioning[241]*/
     /*uint32_t correctPrgSectorNum;*/          /*!< correct prg sectors number[245-242]*/
-    /*uint8_t bkOpsStatus;*/                   /*!< background operations status[246]*/
+    uint8_t bkOpsStatus;                       /*!< background operations status[246]*/
     /*uint8_t powerOffNotifyTimeout;*/         /*!< power off notification timeout[247]*/
     uint32_t genericCMD6Timeout;               /*!< generic CMD6 timeout[248]*/
     uint32_t cacheSize;                        /*!< cache size[252-249]*/
     uint8_t powerClass200MHZDDR360V;           /*!< power class for 200MHZ, DDR at VCC=2.6V[253]*/
     /*uint32_t fwVer[2U];*/                    /*!< fw VERSION [261-254]*/
     /*uint16_t deviceVer;*/                    /*!< device version[263-262]*/
-    /*uint8_t optimalTrimSize;*/               /*!< optimal trim size[264]*/
+    uint8_t optimalTrimSize;                   /*!< optimal trim size[264]*/
     /*uint8_t optimalWriteSize;*/              /*!< optimal write size[265]*/
     /*uint8_t optimalReadSize;*/               /*!< optimal read size[266]*/
     /*uint8_t preEolInfo;*/                    /*!< pre EOL information[267]*/
     /*uint8_t deviceLifeTimeEstimationA;*/     /*!< device life time estimation typeA[268]*/
     /*uint8_t deviceLifeTimeEstimationB;*/     /*!< device life time estimation typeB[269]*/
     /*uint32_t correctPrgFWSectorNum;*/        /*!< number of FW sectors correctly programmed[305-302]*/
+    uint8_t cmdqDepth;                         /*!< command queue depth[307]*/
+    uint8_t cmdqSupport;                       /*!< command queue support[308]*/
     /*uint32_t ffuArg;*/                       /*!< FFU argument[490-487]*/
     /*uint8_t operationCodeTimeout;*/          /*!< operation code timeout[491]*/
     /*uint8_t supportMode;*/                   /*!< support mode [493]*/
@@ -1205,9 +1333,10 @@ typedef struct _mmc_extended_csd
     /*uint8_t contextManageCap;*/              /*!< context management capability[496]*/
     /*uint8_t tagResourceSize;*/               /*!< tag resource size[497]*/
     /*uint8_t tagUnitSize;*/                   /*!< tag unit size[498]*/
-    /*uint8_t maxPackedWriteCmd;*/             /*!< max packed write cmd[500]*/
-    /*uint8_t maxPackedReadCmd;*/              /*!< max packed read cmd[501]*/
-    /*uint8_t hpiFeature;*/                    /*!< HPI feature[503]*/
+    uint8_t maxPackedWriteCmd;                 /*!< max packed write cmd[500]*/
+    uint8_t maxPackedReadCmd;                  /*!< max packed read cmd[501]*/
+    uint8_t bkOpsSupport;                      /*!< background operations support[502]*/
+    uint8_t hpiFeature;                        /*!< HPI feature[503]*/
     uint8_t supportedCommandSet;               /*!< Supported Command Sets [504] */
     /*uint8_t extSecurityCmdError;*/           /*!< extended security commands error[505]*/
 } mmc_extended_csd_t;
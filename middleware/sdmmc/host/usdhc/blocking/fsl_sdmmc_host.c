@@ -8,6 +8,9 @@
 
 #include "fsl_sdmmc_host.h"
 #include "fsl_sdmmc_common.h"
+#if SDMMC_ENABLE_TRACE
+#include "fsl_sdmmc_trace.h"
+#endif
 #if ((defined __DCACHE_PRESENT) && __DCACHE_PRESENT) || (defined FSL_FEATURE_HAS_L1CACHE && FSL_FEATURE_HAS_L1CACHE)
 #if !(defined(FSL_SDK_ENABLE_DRIVER_CACHE_CONTROL) && FSL_SDK_ENABLE_DRIVER_CACHE_CONTROL)
 #include "fsl_cache.h"
@@ -39,6 +42,17 @@ static status_t SDMMCHOST_ExecuteManualTuning(sdmmchost_t *host,
                                               uint32_t tuningCmd,
                                               uint32_t *revBuf,
                                               uint32_t blockSize);
+
+/*!
+ * @brief SDMMCHOST validate the saved tuning delay setting with one tuning block, the setting is applied if valid.
+ * @param host host handler.
+ * @param tuningCmd tuning command
+ * @param revBuf receive buffer pointer
+ * @param blockSize receive block size
+ * @param delaySetting tuning delay setting, DLY_CELL_SET_PRE/OUT/POST in CLK_TUNE_CTRL_STATUS
+ */
+static status_t SDMMCHOST_ValidateTuningDelay(
+    sdmmchost_t *host, uint32_t tuningCmd, uint32_t *revBuf, uint32_t blockSize, uint32_t delaySetting);
 #endif
 /*******************************************************************************
  * Variables
@@ -154,6 +168,11 @@ status_t SDMMCHOST_TransferFunction(sdmmchost_t *host, sdmmchost_transfer_t *con
     status_t error = kStatus_Success;
 
     usdhc_adma_config_t dmaConfig;
+#if SDMMC_ENABLE_TRACE
+    uint32_t traceStart = SDMMC_TRACE_GET_CYCLES();
+#endif
+
+    host->transferSequence++;
 
     if (content->data != NULL)
     {
@@ -201,6 +220,32 @@ status_t SDMMCHOST_TransferFunction(sdmmchost_t *host, sdmmchost_transfer_t *con
 #endif
 #endif
 
+#if SDMMC_ENABLE_TRACE
+    SDMMC_TraceTransfer(content, error, traceStart, 0U);
+#endif
+
+    return error;
+}
+
+status_t SDMMCHOST_TransferAsync(sdmmchost_t *host,
+                                 sdmmchost_transfer_t *content,
+                                 sdmmchost_transfer_callback_t callback,
+                                 void *userData)
+{
+    assert(host != NULL);
+    assert(content != NULL);
+
+    status_t error = kStatus_Success;
+
+    /* blocking host adapter complete the transfer before invoke the callback */
+    error = SDMMCHOST_TransferFunction(host, content);
+
+    if (callback != NULL)
+    {
+        callback(host, error, userData);
+    }
+
+    /* the transfer is already completed, report its status to the submitter as well */
     return error;
 }
 
@@ -304,7 +349,8 @@ status_t SDMMCHOST_Init(sdmmchost_t *host)
                        (uint32_t)kSDMMCHOST_SupportVoltage3v3 | (uint32_t)kSDMMCHOST_SupportVoltage1v8 |
                        (uint32_t)kSDMMCHOST_SupportVoltage1v2 | (uint32_t)kSDMMCHOST_Support4BitDataWidth |
                        (uint32_t)kSDMMCHOST_SupportDDRMode | (uint32_t)kSDMMCHOST_SupportDetectCardByData3 |
-                       (uint32_t)kSDMMCHOST_SupportDetectCardByCD | (uint32_t)kSDMMCHOST_SupportAutoCmd12;
+                       (uint32_t)kSDMMCHOST_SupportDetectCardByCD | (uint32_t)kSDMMCHOST_SupportAutoCmd12 |
+                       (uint32_t)kSDMMCHOST_SupportAutoCmd23;
 
     if (bus8bitCapability != 0U)
     {
@@ -337,6 +383,11 @@ status_t SDMMCHOST_Init(sdmmchost_t *host)
     usdhcHost->config.readWatermarkLevel  = 0x80U;
     usdhcHost->config.writeWatermarkLevel = 0x80U;
     USDHC_Init(usdhcHost->base, &(usdhcHost->config));
+#if !(defined(FSL_FEATURE_USDHC_REGISTER_HOST_CTRL_CAP_HAS_NO_RETUNING_TIME_COUNTER) && \
+      FSL_FEATURE_USDHC_REGISTER_HOST_CTRL_CAP_HAS_NO_RETUNING_TIME_COUNTER)
+    /* the timer re-tuning request is serviced by the card driver between the requests */
+    USDHC_SetRetuningTimer(usdhcHost->base, SDMMCHOST_RETUNING_TIMER_COUNT);
+#endif
 
     return kStatus_Success;
 }
@@ -599,17 +650,102 @@ static status_t SDMMCHOST_ExecuteManualTuning(sdmmchost_t *host,
 
     return ret;
 }
+
+static status_t SDMMCHOST_ValidateTuningDelay(
+    sdmmchost_t *host, uint32_t tuningCmd, uint32_t *revBuf, uint32_t blockSize, uint32_t delaySetting)
+{
+    uint32_t preDelay  = (delaySetting >> 8U) & 0x7FU;
+    uint32_t outDelay  = (delaySetting >> 4U) & 0xFU;
+    uint32_t postDelay = delaySetting & 0xFU;
+    status_t error     = kStatus_SDMMC_TuningFail;
+
+    sdmmchost_transfer_t content = {0U};
+    sdmmchost_cmd_t command      = {0U};
+    sdmmchost_data_t data        = {0U};
+
+    command.index        = tuningCmd;
+    command.argument     = 0U;
+    command.responseType = kCARD_ResponseTypeR1;
+
+    data.blockSize  = blockSize;
+    data.blockCount = 1U;
+    data.rxData     = revBuf;
+
+    content.command = &command;
+    content.data    = &data;
+
+    /* sample the tuning block with the saved delay setting, same as one step of the manual tuning */
+    (void)USDHC_Reset(host->hostController.base, kUSDHC_ResetAll, 100U);
+    USDHC_EnableManualTuning(host->hostController.base, true);
+    USDHC_ForceClockOn(host->hostController.base, true);
+    (void)USDHC_SetTuningDelay(host->hostController.base, preDelay, outDelay, postDelay);
+
+    if ((SDMMCHOST_TransferFunction(host, &content) == kStatus_Success) &&
+        (((uint32_t)kUSDHC_TuningPassFlag & USDHC_GetInterruptStatusFlags(host->hostController.base)) != 0U))
+    {
+        USDHC_ClearInterruptStatusFlags(host->hostController.base, kUSDHC_TuningPassFlag);
+        error = kStatus_Success;
+    }
+
+    /* abort tuning */
+    USDHC_EnableManualTuning(host->hostController.base, false);
+    USDHC_ForceClockOn(host->hostController.base, false);
+    (void)USDHC_Reset(host->hostController.base, kUSDHC_ResetAll, 100U);
+
+    if (error == kStatus_Success)
+    {
+        (void)USDHC_SetTuningDelay(host->hostController.base, preDelay, outDelay, postDelay);
+        /* wait the tuning delay value write successfully */
+        while ((USDHC_GetTuningDelayStatus(host->hostController.base) & SDMMCHOST_TUNING_DELAY_SETTING_MASK) !=
+               delaySetting)
+        {
+        }
+        /* enable auto tuning */
+        USDHC_EnableAutoTuning(host->hostController.base, true);
+    }
+
+    return error;
+}
 #endif
 
 status_t SDMMCHOST_ExecuteTuning(sdmmchost_t *host, uint32_t tuningCmd, uint32_t *revBuf, uint32_t blockSize)
 {
 #if SDMMCHOST_SUPPORT_SDR104 || SDMMCHOST_SUPPORT_SDR50 || SDMMCHOST_SUPPORT_HS200 || SDMMCHOST_SUPPORT_HS400
+    const sdmmchost_tuning_persistence_t *persistence = host->tuningPersistence;
+    uint32_t delaySetting                             = 0U;
+    status_t error                                    = kStatus_Success;
+
+    /* the pending re-tuning event is serviced by this tuning */
+    USDHC_ClearInterruptStatusFlags(host->hostController.base, (uint32_t)kUSDHC_ReTuningEventFlag);
+
+    /* try the saved tuning result firstly, it takes one tuning block instead of the full sweep */
+    if ((persistence != NULL) && (persistence->load != NULL) &&
+        persistence->load(persistence->userData, &host->tuningKey, &delaySetting))
+    {
+        if (SDMMCHOST_ValidateTuningDelay(host, tuningCmd, revBuf, blockSize,
+                                          delaySetting & SDMMCHOST_TUNING_DELAY_SETTING_MASK) == kStatus_Success)
+        {
+            return kStatus_Success;
+        }
+    }
+
     if (host->tuningType == (uint32_t)kSDMMCHOST_StandardTuning)
     {
-        return SDMMCHOST_ExecuteStdTuning(host, tuningCmd, revBuf, blockSize);
+        error = SDMMCHOST_ExecuteStdTuning(host, tuningCmd, revBuf, blockSize);
+    }
+    else
+    {
+        error = SDMMCHOST_ExecuteManualTuning(host, tuningCmd, revBuf, blockSize);
+    }
+
+    if ((error == kStatus_Success) && (persistence != NULL) && (persistence->save != NULL))
+    {
+        /* the tap selected by either tuning is in the delay setting layout already */
+        delaySetting = USDHC_GetTuningDelayStatus(host->hostController.base);
+        persistence->save(persistence->userData, &host->tuningKey, delaySetting & SDMMCHOST_TUNING_DELAY_SETTING_MASK);
     }
 
-    return SDMMCHOST_ExecuteManualTuning(host, tuningCmd, revBuf, blockSize);
+    return error;
 #else
     return kStatus_SDMMC_NotSupportYet;
 #endif
@@ -624,6 +760,9 @@ status_t SDMMCHOST_StartBoot(sdmmchost_t *host,
     sdmmchost_data_t data        = {0};
     status_t error               = kStatus_Success;
 
+    /* the boot data descriptors are appended after the last valid one, start from an empty table */
+    (void)memset(host->dmaDesBuffer, 0, host->dmaDesBufferWordsNum * sizeof(uint32_t));
+
     USDHC_SetMmcBootConfig(host->hostController.base, hostConfig);
 
     data.blockSize  = hostConfig->blockSize;
@@ -672,3 +811,37 @@ status_t SDMMCHOST_ReadBootData(sdmmchost_t *host, sdmmchost_boot_config_t *host
 
     return kStatus_Success;
 }
+
+status_t SDMMCHOST_ReadBootDataAsync(sdmmchost_t *host,
+                                     sdmmchost_boot_config_t *hostConfig,
+                                     uint8_t *buffer,
+                                     sdmmchost_transfer_callback_t callback,
+                                     void *userData)
+{
+    assert(host != NULL);
+    assert(hostConfig != NULL);
+    assert(buffer != NULL);
+
+    USDHC_SetMmcBootConfig(host->hostController.base, hostConfig);
+    USDHC_EnableMmcBoot(host->hostController.base, true);
+
+    (void)memset(&host->bootCommand, 0, sizeof(sdmmchost_cmd_t));
+    (void)memset(&host->bootData, 0, sizeof(sdmmchost_data_t));
+
+    host->bootData.blockSize  = hostConfig->blockSize;
+    host->bootData.blockCount = hostConfig->blockCount;
+    host->bootData.rxData     = (uint32_t *)(uint32_t)buffer;
+    host->bootData.dataType   = kUSDHC_TransferDataBootcontinous;
+    /* no command should be send out  */
+    host->bootCommand.type = kCARD_CommandTypeEmpty;
+
+    host->bootTransfer.data    = &host->bootData;
+    host->bootTransfer.command = &host->bootCommand;
+
+    if (kStatus_Success != SDMMCHOST_TransferAsync(host, &host->bootTransfer, callback, userData))
+    {
+        return kStatus_SDMMC_TransferFailed;
+    }
+
+    return kStatus_Success;
+}
@@ -23,7 +23,7 @@
  * Definitions
  ******************************************************************************/
 /*! @brief Middleware adapter version. */
-#define FSL_SDMMC_HOST_ADAPTER_VERSION (MAKE_VERSION(2U, 6U, 3U)) /*2.6.3*/
+#define FSL_SDMMC_HOST_ADAPTER_VERSION (MAKE_VERSION(2U, 7U, 0U)) /*2.7.0*/
 
 #if ((defined __DCACHE_PRESENT) && __DCACHE_PRESENT) || (defined FSL_FEATURE_HAS_L1CACHE && FSL_FEATURE_HAS_L1CACHE)
 #define SDMMCHOST_ENABLE_CACHE_LINE_ALIGN_TRANSFER 0
@@ -37,22 +37,24 @@
 /*! @brief sdmmc host capability */
 enum
 {
-    kSDMMCHOST_SupportHighSpeed         = 1U << 0U,  /*!< high speed capability */
-    kSDMMCHOST_SupportSuspendResume     = 1U << 1U,  /*!< suspend resume capability */
-    kSDMMCHOST_SupportVoltage3v3        = 1U << 2U,  /*!< 3V3 capability */
-    kSDMMCHOST_SupportVoltage3v0        = 1U << 3U,  /*!< 3V0 capability */
-    kSDMMCHOST_SupportVoltage1v8        = 1U << 4U,  /*!< 1V8 capability */
-    kSDMMCHOST_SupportVoltage1v2        = 1U << 5U,  /*!< 1V2 capability */
-    kSDMMCHOST_Support4BitDataWidth     = 1U << 6U,  /*!< 4 bit data width capability */
-    kSDMMCHOST_Support8BitDataWidth     = 1U << 7U,  /*!< 8 bit data width capability */
-    kSDMMCHOST_SupportDDRMode           = 1U << 8U,  /*!< DDR mode capability */
-    kSDMMCHOST_SupportDetectCardByData3 = 1U << 9U,  /*!< data3 detect card capability */
-    kSDMMCHOST_SupportDetectCardByCD    = 1U << 10U, /*!< CD detect card capability */
-    kSDMMCHOST_SupportAutoCmd12         = 1U << 11U, /*!< auto command 12 capability */
-    kSDMMCHOST_SupportSDR104            = 1U << 12U, /*!< SDR104 capability */
-    kSDMMCHOST_SupportSDR50             = 1U << 13U, /*!< SDR50 capability */
-    kSDMMCHOST_SupportHS200             = 1U << 14U, /*!< HS200 capability */
-    kSDMMCHOST_SupportHS400             = 1U << 15U, /*!< HS400 capability */
+    kSDMMCHOST_SupportHighSpeed           = 1U << 0U,  /*!< high speed capability */
+    kSDMMCHOST_SupportSuspendResume       = 1U << 1U,  /*!< suspend resume capability */
+    kSDMMCHOST_SupportVoltage3v3          = 1U << 2U,  /*!< 3V3 capability */
+    kSDMMCHOST_SupportVoltage3v0          = 1U << 3U,  /*!< 3V0 capability */
+    kSDMMCHOST_SupportVoltage1v8          = 1U << 4U,  /*!< 1V8 capability */
+    kSDMMCHOST_SupportVoltage1v2          = 1U << 5U,  /*!< 1V2 capability */
+    kSDMMCHOST_Support4BitDataWidth       = 1U << 6U,  /*!< 4 bit data width capability */
+    kSDMMCHOST_Support8BitDataWidth       = 1U << 7U,  /*!< 8 bit data width capability */
+    kSDMMCHOST_SupportDDRMode             = 1U << 8U,  /*!< DDR mode capability */
+    kSDMMCHOST_SupportDetectCardByData3   = 1U << 9U,  /*!< data3 detect card capability */
+    kSDMMCHOST_SupportDetectCardByCD      = 1U << 10U, /*!< CD detect card capability */
+    kSDMMCHOST_SupportAutoCmd12           = 1U << 11U, /*!< auto command 12 capability */
+    kSDMMCHOST_SupportSDR104              = 1U << 12U, /*!< SDR104 capability */
+    kSDMMCHOST_SupportSDR50               = 1U << 13U, /*!< SDR50 capability */
+    kSDMMCHOST_SupportHS200               = 1U << 14U, /*!< HS200 capability */
+    kSDMMCHOST_SupportHS400               = 1U << 15U, /*!< HS400 capability */
+    kSDMMCHOST_SupportAutoCmd23           = 1U << 16U, /*!< auto command 23 capability */
+    kSDMMCHOST_SupportHS400EnhancedStrobe = 1U << 17U, /*!< HS400 enhanced strobe capability */
 };
 
 /*!@brief sdmmc host misc capability */
@@ -68,6 +70,7 @@ enum
 #define SDMMCHOST_SUPPORT_DETECT_CARD_BY_DATA3 (1U)
 #define SDMMCHOST_SUPPORT_DETECT_CARD_BY_CD    (1U)
 #define SDMMCHOST_SUPPORT_AUTO_CMD12           (1U)
+#define SDMMCHOST_SUPPORT_AUTO_CMD23           (1U)
 #define SDMMCHOST_SUPPORT_MAX_BLOCK_LENGTH     (4096U)
 #define SDMMCHOST_SUPPORT_MAX_BLOCK_COUNT      (USDHC_MAX_BLOCK_COUNT)
 #if !(defined(FSL_FEATURE_USDHC_HAS_NO_VOLTAGE_SELECT) && (FSL_FEATURE_USDHC_HAS_NO_VOLTAGE_SELECT))
@@ -131,8 +134,17 @@ enum
 #ifndef SDMMCHOST_DATA3_DETECT_CARD_DELAY
 #define SDMMCHOST_DATA3_DETECT_CARD_DELAY (10U)
 #endif
+/*!@brief timeout in milliseconds waiting for the ongoing asynchronous transfer, the transfer is aborted when it expires */
+#ifndef SDMMCHOST_ASYNC_TRANSFER_TIMEOUT
+#define SDMMCHOST_ASYNC_TRANSFER_TIMEOUT (10000U)
+#endif
 /*!@brief SDMMC host dma descriptor buffer address align size */
 #define SDMMCHOST_DMA_DESCRIPTOR_BUFFER_ALIGN_SIZE (4U)
+/*!@brief maximum chunk size of the boot stream, one chunk is described by one ADMA2 descriptor */
+#define SDMMCHOST_BOOT_STREAM_MAX_CHUNK_SIZE (USDHC_ADMA2_DESCRIPTOR_MAX_LENGTH_PER_ENTRY)
+/*!@brief DMA descriptor words of the boot stream, the descriptors are appended to the table by each chunk read, one
+ * for the chunk and one for the boot data word received between the chunks */
+#define SDMMCHOST_BOOT_STREAM_DESCRIPTOR_WORDS(chunkCount) ((chunkCount)*4U)
 /*!@brief tuning configuration */
 #define SDMMCHOST_STANDARD_TUNING_START            (10U) /*!< standard tuning start point */
 #define SDMMCHOST_TUINIG_STEP                      (2U)  /*!< standard tuning stBep */
@@ -140,6 +152,18 @@ enum
 #define SDMMCHOST_STROBE_DLL_DELAY_TARGET          (7U)
 #define SDMMCHOST_STROBE_DLL_DELAY_UPDATE_INTERVAL (4U)
 #define SDMMCHOST_MAX_TUNING_DELAY_CELL            (128U)
+/*!@brief tuning delay setting in the DLY_CELL_SET_PRE/OUT/POST layout of CLK_TUNE_CTRL_STATUS, the tap selected by the
+ * tuning TAP_SEL_PRE/OUT/POST is returned by USDHC_GetTuningDelayStatus in the same layout */
+#define SDMMCHOST_TUNING_DELAY_SETTING_MASK (0x7FFFU)
+/*!@brief re-tuning timer count, the re-tuning request is raised 2^(count - 1) seconds after the tuning, 0 disables the
+ * timer, it takes effect only when the host has the re-tuning timer */
+#ifndef SDMMCHOST_RETUNING_TIMER_COUNT
+#define SDMMCHOST_RETUNING_TIMER_COUNT (0U)
+#endif
+/*!@brief record the transfers into the trace ring installed by SDMMC_TraceInit, the trace component is required */
+#ifndef SDMMC_ENABLE_TRACE
+#define SDMMC_ENABLE_TRACE (0U)
+#endif
 /*!@brief sdmmc host transfer function */
 typedef usdhc_transfer_t sdmmchost_transfer_t;
 typedef usdhc_command_t sdmmchost_cmd_t;
@@ -177,6 +201,35 @@ enum
     kSDMMCHOST_CacheControlRWBuffer = 1U, /*!< sdmmc host cache control read/write buffer */
 };
 
+/*! @brief sdmmc host tuning result cache key */
+typedef struct _sdmmchost_tuning_key
+{
+    uint32_t cardId[4U];  /*!< raw CID register content of the card, the CIS manufacturer ID for the SDIO card */
+    uint32_t busMode;     /*!< card bus timing mode, such as sd_timing_mode_t or mmc_high_speed_timing_t */
+    uint32_t busClock_Hz; /*!< card bus clock */
+} sdmmchost_tuning_key_t;
+
+/*!@brief sdmmc host tuning result load function, return false if there is no saved delay setting for the key */
+typedef bool (*sdmmchost_tuning_load_t)(void *userData, const sdmmchost_tuning_key_t *key, uint32_t *delaySetting);
+
+/*!@brief sdmmc host tuning result save function, called after a full tuning sweep */
+typedef void (*sdmmchost_tuning_save_t)(void *userData, const sdmmchost_tuning_key_t *key, uint32_t delaySetting);
+
+/*! @brief sdmmc host tuning result persistence hook, the saved tuning delay setting is validated with one tuning block
+ * before use, so a stale setting only costs one tuning block transfer */
+typedef struct _sdmmchost_tuning_persistence
+{
+    sdmmchost_tuning_load_t load; /*!< load the saved tuning delay setting */
+    sdmmchost_tuning_save_t save; /*!< save the tuning delay setting */
+    void *userData;               /*!< user data pass to the hook */
+} sdmmchost_tuning_persistence_t;
+
+/*!@brief sdmmc host asynchronous transfer complete callback
+ * The callback is invoked from the host interrupt context when using the non_blocking host adapter, so application
+ * should not call any blocking function in it.
+ */
+typedef void (*sdmmchost_transfer_callback_t)(struct _sdmmchost_ *host, status_t status, void *userData);
+
 /*!@brief sdmmc host handler  */
 typedef struct _sdmmchost_
 {
@@ -188,7 +241,9 @@ typedef struct _sdmmchost_
     uint32_t maxBlockCount;        /*!< host controller maximum block count */
     uint32_t maxBlockSize;         /*!< host controller maximum block size */
 
-    uint8_t tuningType; /*!< host tuning type */
+    uint8_t tuningType;                                      /*!< host tuning type */
+    const sdmmchost_tuning_persistence_t *tuningPersistence; /*!< tuning result persistence hook, NULL to disable */
+    sdmmchost_tuning_key_t tuningKey;                        /*!< tuning result key, set by card driver before tuning */
 
     sdmmc_osa_event_t hostEvent; /*!< host event handler */
     void *cd;                    /*!< card detect */
@@ -206,6 +261,20 @@ typedef struct _sdmmchost_
 #endif
 #endif
 
+    sdmmchost_transfer_callback_t transferCallback; /*!< asynchronous transfer complete callback */
+    void *transferUserData;                         /*!< asynchronous transfer complete callback user data */
+    sdmmchost_transfer_t *asyncTransfer;            /*!< ongoing asynchronous transfer content */
+    volatile bool isAsyncTransferBusy;              /*!< asynchronous transfer in progress flag */
+    uint32_t transferSequence;                      /*!< increased on every transfer issued to the card, card driver
+                                                       use it to know if any command was sent since its last access */
+#if SDMMC_ENABLE_TRACE
+    uint32_t asyncTraceStart; /*!< trace cycles when the asynchronous transfer is submitted */
+#endif
+
+    sdmmchost_transfer_t bootTransfer; /*!< asynchronous boot data transfer content */
+    sdmmchost_cmd_t bootCommand;       /*!< asynchronous boot data empty command */
+    sdmmchost_data_t bootData;         /*!< asynchronous boot data descriptor */
+
     sdmmc_osa_mutex_t lock; /*!< host access lock */
 } sdmmchost_t;
 
@@ -316,6 +385,21 @@ static inline void SDMMCHOST_EnableHS400Mode(sdmmchost_t *host, bool enable)
 #endif
 }
 
+/*!
+ * @brief enable HS400 enhanced strobe mode.
+ *
+ * The uSDHC driver has no enhanced strobe control, so kSDMMCHOST_SupportHS400EnhancedStrobe is not reported and the
+ * function does nothing.
+ *
+ * @param host host handler
+ * @param enable true is enable, false is disable.
+ */
+static inline void SDMMCHOST_EnableHS400EnhancedStrobe(sdmmchost_t *host, bool enable)
+{
+    (void)host;
+    (void)enable;
+}
+
 /*!
  * @brief enable STROBE DLL.
  * @param host host handler
@@ -357,6 +441,23 @@ status_t SDMMCHOST_StartBoot(sdmmchost_t *host,
  */
 status_t SDMMCHOST_ReadBootData(sdmmchost_t *host, sdmmchost_boot_config_t *hostConfig, uint8_t *buffer);
 
+/*!
+ * @brief read boot data asynchronously.
+ * The next hostConfig->blockCount blocks are received into the buffer after the function return, the descriptor of the
+ * buffer is appended to the DMA descriptor table, so the table should hold
+ * SDMMCHOST_BOOT_STREAM_DESCRIPTOR_WORDS(chunk count) words for the whole boot read.
+ * @param host host handler
+ * @param hostConfig boot configuration
+ * @param buffer buffer address
+ * @param callback boot data complete callback, reference SDMMCHOST_TransferAsync.
+ * @param userData user data pass to callback.
+ */
+status_t SDMMCHOST_ReadBootDataAsync(sdmmchost_t *host,
+                                     sdmmchost_boot_config_t *hostConfig,
+                                     uint8_t *buffer,
+                                     sdmmchost_transfer_callback_t callback,
+                                     void *userData);
+
 /*!
  * @brief enable boot mode.
  * @param host host handler
@@ -384,6 +485,19 @@ static inline void SDMMCHOST_ForceClockOn(sdmmchost_t *host, bool enable)
     USDHC_ForceClockOn(host->hostController.base, enable);
 }
 
+/*!
+ * @brief check the re-tuning request.
+ * The request is raised by the re-tuning timer or by the sampling point drift, the next transfer is rejected with
+ * kStatus_USDHC_ReTuningRequest if the tuning is not executed before it.
+ * @param host host handler
+ * @retval true is re-tuning requested, false is not.
+ */
+static inline bool SDMMCHOST_IsReTuningRequest(sdmmchost_t *host)
+{
+    return ((USDHC_GetInterruptStatusFlags(host->hostController.base) & (uint32_t)kUSDHC_ReTuningEventFlag) != 0U) ||
+           ((USDHC_GetPresentStatusFlags(host->hostController.base) & (uint32_t)kUSDHC_ReTuningRequestFlag) != 0U);
+}
+
 /*!
  * @brief switch to voltage.
  * @param host host handler
@@ -477,9 +591,43 @@ void SDMMCHOST_InstallCacheAlignBuffer(sdmmchost_t *host, void *cacheAlignBuffer
  */
 status_t SDMMCHOST_TransferFunction(sdmmchost_t *host, sdmmchost_transfer_t *content);
 
+/*!
+ * @brief host asynchronous transfer function.
+ *
+ * Please note it is a thread safe function.
+ *
+ * @note
+ * 1. The function submits the transfer and return immediately, the callback will be invoked once the transfer
+ * complete, for the non_blocking host adapter the callback is invoked in the host interrupt context, for the blocking
+ * host adapter the callback is invoked before the function return.
+ * 2. The transfer content, command and data descriptor must stay valid until the callback is invoked.
+ * 3. Only one asynchronous transfer can be in flight per host, SDMMCHOST_TransferFunction and
+ * SDMMCHOST_TransferAsync will wait the ongoing asynchronous transfer complete before start a new transfer. If it does
+ * not complete within SDMMCHOST_ASYNC_TRANSFER_TIMEOUT, it is aborted and its callback receive kStatus_Timeout.
+ * 4. Re-tuning and retry are not performed for the asynchronous transfer, the callback receive the failed status and
+ * upper layer can retry the transfer through the blocking path.
+ * 5. When cache line size align transfer is enabled, the receive buffer must be cache line size align.
+ *
+ * @param host host handler
+ * @param content transfer content.
+ * @param callback transfer complete callback.
+ * @param userData user data pass to callback.
+ * @retval kStatus_Success transfer submitted successfully, or completed successfully for the blocking host adapter.
+ * @retval kStatus_InvalidArgument invalid transfer buffer.
+ * @retval kStatus_Fail submit transfer failed, or transfer failed for the blocking host adapter.
+ */
+status_t SDMMCHOST_TransferAsync(sdmmchost_t *host,
+                                 sdmmchost_transfer_t *content,
+                                 sdmmchost_transfer_callback_t callback,
+                                 void *userData);
+
 /*!
  * @brief sdmmc host excute tuning.
  *
+ * If tuningPersistence is set, the tuning delay setting saved for the tuningKey is validated with one tuning block
+ * firstly, the full tuning sweep is performed only if there is no saved setting or the validation fails, and the new
+ * result is saved then.
+ *
  * @param host host handler
  * @param tuningCmd tuning command.
  * @param revBuf receive buffer pointer
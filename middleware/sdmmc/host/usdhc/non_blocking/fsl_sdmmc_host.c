@@ -8,6 +8,9 @@
 
 #include "fsl_sdmmc_host.h"
 #include "fsl_sdmmc_common.h"
+#if SDMMC_ENABLE_TRACE
+#include "fsl_sdmmc_trace.h"
+#endif
 #if ((defined __DCACHE_PRESENT) && __DCACHE_PRESENT) || (defined FSL_FEATURE_HAS_L1CACHE && FSL_FEATURE_HAS_L1CACHE)
 #if !(defined(FSL_SDK_ENABLE_DRIVER_CACHE_CONTROL) && FSL_SDK_ENABLE_DRIVER_CACHE_CONTROL)
 #include "fsl_cache.h"
@@ -57,6 +60,27 @@ static void SDMMCHOST_TransferCompleteCallback(USDHC_Type *base,
  */
 static void SDMMCHOST_ErrorRecovery(USDHC_Type *base);
 
+/*!
+ * @brief SDMMCHOST asynchronous transfer complete handler.
+ * @param host host handler.
+ * @param eventStatus transfer event status.
+ */
+static void SDMMCHOST_AsyncTransferComplete(sdmmchost_t *host, uint32_t eventStatus);
+
+/*!
+ * @brief SDMMCHOST wait ongoing asynchronous transfer complete.
+ * @param host host handler.
+ * @retval kStatus_Success no asynchronous transfer is ongoing.
+ * @retval kStatus_Timeout the ongoing asynchronous transfer is aborted since it is not completed in time.
+ */
+static status_t SDMMCHOST_WaitAsyncTransferComplete(sdmmchost_t *host);
+
+/*!
+ * @brief SDMMCHOST abort the ongoing asynchronous transfer.
+ * @param host host handler.
+ */
+static void SDMMCHOST_AbortAsyncTransfer(sdmmchost_t *host);
+
 #if SDMMCHOST_SUPPORT_SDR104 || SDMMCHOST_SUPPORT_SDR50 || SDMMCHOST_SUPPORT_HS200 || SDMMCHOST_SUPPORT_HS400
 /*!
  * @brief SDMMCHOST execute manual tuning.
@@ -69,6 +93,17 @@ static status_t SDMMCHOST_ExecuteManualTuning(sdmmchost_t *host,
                                               uint32_t tuningCmd,
                                               uint32_t *revBuf,
                                               uint32_t blockSize);
+
+/*!
+ * @brief SDMMCHOST validate the saved tuning delay setting with one tuning block, the setting is applied if valid.
+ * @param host host handler.
+ * @param tuningCmd tuning command
+ * @param revBuf receive buffer pointer
+ * @param blockSize receive block size
+ * @param delaySetting tuning delay setting, DLY_CELL_SET_PRE/OUT/POST in CLK_TUNE_CTRL_STATUS
+ */
+static status_t SDMMCHOST_ValidateTuningDelay(
+    sdmmchost_t *host, uint32_t tuningCmd, uint32_t *revBuf, uint32_t blockSize, uint32_t delaySetting);
 #endif
 /*******************************************************************************
  * Variables
@@ -364,9 +399,119 @@ static void SDMMCHOST_TransferCompleteCallback(USDHC_Type *base,
         eventStatus = SDMMC_OSA_EVENT_TRANSFER_CMD_SUCCESS;
     }
 
+    if (((sdmmchost_t *)userData)->isAsyncTransferBusy)
+    {
+        SDMMCHOST_AsyncTransferComplete((sdmmchost_t *)userData, eventStatus);
+    }
+
     (void)SDMMC_OSAEventSet(&(((sdmmchost_t *)userData)->hostEvent), eventStatus);
 }
 
+static void SDMMCHOST_AsyncTransferComplete(sdmmchost_t *host, uint32_t eventStatus)
+{
+    sdmmchost_transfer_t *content = host->asyncTransfer;
+    status_t error                = kStatus_Success;
+
+    if ((eventStatus & (SDMMC_OSA_EVENT_TRANSFER_CMD_FAIL | SDMMC_OSA_EVENT_TRANSFER_DATA_FAIL)) != 0U)
+    {
+        error = kStatus_Fail;
+        /* host error recovery */
+        SDMMCHOST_ErrorRecovery(host->hostController.base);
+    }
+    else if ((eventStatus == SDMMC_OSA_EVENT_TRANSFER_DATA_SUCCESS) ||
+             ((eventStatus == SDMMC_OSA_EVENT_TRANSFER_CMD_SUCCESS) && (content->data == NULL)))
+    {
+#if ((defined __DCACHE_PRESENT) && __DCACHE_PRESENT) || (defined FSL_FEATURE_HAS_L1CACHE && FSL_FEATURE_HAS_L1CACHE)
+#if !(defined(FSL_SDK_ENABLE_DRIVER_CACHE_CONTROL) && FSL_SDK_ENABLE_DRIVER_CACHE_CONTROL)
+        /* invalidate the cache for read */
+        if ((content->data != NULL) && (content->data->rxData != NULL) &&
+            (host->enableCacheControl == kSDMMCHOST_CacheControlRWBuffer))
+        {
+            DCACHE_InvalidateByRange((uint32_t)content->data->rxData,
+                                     (content->data->blockSize) * (content->data->blockCount));
+        }
+#endif
+#endif
+    }
+    else
+    {
+        /* transfer is still ongoing, such as command complete but data not complete */
+        return;
+    }
+
+    host->asyncTransfer       = NULL;
+    host->isAsyncTransferBusy = false;
+
+#if SDMMC_ENABLE_TRACE
+    SDMMC_TraceTransfer(content, error, host->asyncTraceStart, (uint32_t)kSDMMC_TraceFlagAsync);
+#endif
+
+    if (host->transferCallback != NULL)
+    {
+        host->transferCallback(host, error, host->transferUserData);
+    }
+}
+
+static void SDMMCHOST_AbortAsyncTransfer(sdmmchost_t *host)
+{
+    sdmmchost_transfer_t *content = NULL;
+    uint32_t regPrimask           = DisableGlobalIRQ();
+
+    /* the transfer may complete right before the abort, a late completion interrupt only sets the transfer event once
+     * the busy flag is cleared */
+    if (host->isAsyncTransferBusy)
+    {
+        content                   = host->asyncTransfer;
+        host->asyncTransfer       = NULL;
+        host->isAsyncTransferBusy = false;
+    }
+
+    EnableGlobalIRQ(regPrimask);
+
+    if (content == NULL)
+    {
+        return;
+    }
+
+    /* host error recovery */
+    SDMMCHOST_ErrorRecovery(host->hostController.base);
+
+#if SDMMC_ENABLE_TRACE
+    SDMMC_TraceTransfer(content, kStatus_Timeout, host->asyncTraceStart, (uint32_t)kSDMMC_TraceFlagAsync);
+#endif
+
+    if (host->transferCallback != NULL)
+    {
+        host->transferCallback(host, kStatus_Timeout, host->transferUserData);
+    }
+}
+
+static status_t SDMMCHOST_WaitAsyncTransferComplete(sdmmchost_t *host)
+{
+    uint32_t event = 0U;
+
+    /* the asynchronous transfer busy flag is cleared before the transfer event is set in the interrupt context */
+    while (host->isAsyncTransferBusy)
+    {
+        if (kStatus_Success != SDMMC_OSAEventWait(&(host->hostEvent),
+                                                  SDMMC_OSA_EVENT_TRANSFER_CMD_FAIL | SDMMCHOST_TRANSFER_DATA_EVENT,
+                                                  SDMMCHOST_ASYNC_TRANSFER_TIMEOUT, &event))
+        {
+            break;
+        }
+        /* consume the event, a stale event would turn the wait into a busy loop */
+        (void)SDMMC_OSAEventClear(&(host->hostEvent), event);
+    }
+
+    if (host->isAsyncTransferBusy)
+    {
+        SDMMCHOST_AbortAsyncTransfer(host);
+        return kStatus_Timeout;
+    }
+
+    return kStatus_Success;
+}
+
 #if defined SDMMCHOST_ENABLE_CACHE_LINE_ALIGN_TRANSFER && SDMMCHOST_ENABLE_CACHE_LINE_ALIGN_TRANSFER
 void SDMMCHOST_InstallCacheAlignBuffer(sdmmchost_t *host, void *cacheAlignBuffer, uint32_t cacheAlignBufferSize)
 {
@@ -383,6 +528,9 @@ status_t SDMMCHOST_TransferFunction(sdmmchost_t *host, sdmmchost_transfer_t *con
     status_t error = kStatus_Success;
     uint32_t event = 0U;
     usdhc_adma_config_t dmaConfig;
+#if SDMMC_ENABLE_TRACE
+    uint32_t traceStart = 0U;
+#endif
 
 #if defined SDMMCHOST_ENABLE_CACHE_LINE_ALIGN_TRANSFER && SDMMCHOST_ENABLE_CACHE_LINE_ALIGN_TRANSFER
     usdhc_scatter_gather_data_list_t sgDataList0;
@@ -394,6 +542,14 @@ status_t SDMMCHOST_TransferFunction(sdmmchost_t *host, sdmmchost_transfer_t *con
 
     (void)SDMMC_OSAMutexLock(&host->lock, osaWaitForever_c);
 
+    /* wait the ongoing asynchronous transfer complete, the aborted one is reported to its callback */
+    (void)SDMMCHOST_WaitAsyncTransferComplete(host);
+
+#if SDMMC_ENABLE_TRACE
+    traceStart = SDMMC_TRACE_GET_CYCLES();
+#endif
+    host->transferSequence++;
+
     if (content->data != NULL)
     {
         (void)memset(&dmaConfig, 0, sizeof(usdhc_adma_config_t));
@@ -576,6 +732,90 @@ status_t SDMMCHOST_TransferFunction(sdmmchost_t *host, sdmmchost_transfer_t *con
         }
     }
 
+#if SDMMC_ENABLE_TRACE
+    SDMMC_TraceTransfer(content, error, traceStart, 0U);
+#endif
+
+    (void)SDMMC_OSAMutexUnlock(&host->lock);
+
+    return error;
+}
+
+status_t SDMMCHOST_TransferAsync(sdmmchost_t *host,
+                                 sdmmchost_transfer_t *content,
+                                 sdmmchost_transfer_callback_t callback,
+                                 void *userData)
+{
+    assert(host != NULL);
+    assert(content != NULL);
+
+    status_t error = kStatus_Success;
+    usdhc_adma_config_t dmaConfig;
+
+    (void)SDMMC_OSAMutexLock(&host->lock, osaWaitForever_c);
+
+    /* only one asynchronous transfer is allowed at the same time, the aborted one is reported to its callback */
+    (void)SDMMCHOST_WaitAsyncTransferComplete(host);
+
+#if SDMMC_ENABLE_TRACE
+    host->asyncTraceStart = SDMMC_TRACE_GET_CYCLES();
+#endif
+    host->transferSequence++;
+
+    if (content->data != NULL)
+    {
+#if defined SDMMCHOST_ENABLE_CACHE_LINE_ALIGN_TRANSFER && SDMMCHOST_ENABLE_CACHE_LINE_ALIGN_TRANSFER
+        /* the unalign head/tail region cannot be copied back in the interrupt context */
+        if ((content->data->rxData != NULL) &&
+            (((uint32_t)content->data->rxData % SDMMC_DATA_BUFFER_ALIGN_CACHE) != 0U))
+        {
+            (void)SDMMC_OSAMutexUnlock(&host->lock);
+            return kStatus_InvalidArgument;
+        }
+#endif
+        (void)memset(&dmaConfig, 0, sizeof(usdhc_adma_config_t));
+        /* config adma */
+        dmaConfig.dmaMode = SDMMCHOST_DMA_MODE;
+#if !(defined(FSL_FEATURE_USDHC_HAS_NO_RW_BURST_LEN) && FSL_FEATURE_USDHC_HAS_NO_RW_BURST_LEN)
+        dmaConfig.burstLen = kUSDHC_EnBurstLenForINCR;
+#endif
+        dmaConfig.admaTable      = host->dmaDesBuffer;
+        dmaConfig.admaTableWords = host->dmaDesBufferWordsNum;
+
+#if ((defined __DCACHE_PRESENT) && __DCACHE_PRESENT) || (defined FSL_FEATURE_HAS_L1CACHE && FSL_FEATURE_HAS_L1CACHE)
+#if !(defined(FSL_SDK_ENABLE_DRIVER_CACHE_CONTROL) && FSL_SDK_ENABLE_DRIVER_CACHE_CONTROL)
+        if (host->enableCacheControl == kSDMMCHOST_CacheControlRWBuffer)
+        {
+            /* no matter read or write transfer, clean the cache line anyway to avoid data miss */
+            DCACHE_CleanByRange(
+                (uint32_t)(content->data->txData == NULL ? content->data->rxData : content->data->txData),
+                (content->data->blockSize) * (content->data->blockCount));
+        }
+#endif
+#endif
+    }
+
+    host->transferCallback    = callback;
+    host->transferUserData    = userData;
+    host->asyncTransfer       = content;
+    host->isAsyncTransferBusy = true;
+
+    /* clear redundant transfer event flag */
+    (void)SDMMC_OSAEventClear(&(host->hostEvent), SDMMCHOST_TRANSFER_CMD_EVENT);
+
+    error = USDHC_TransferNonBlocking(host->hostController.base, &host->handle,
+                                      content->data == NULL ? NULL : &dmaConfig, content);
+    if (error != kStatus_Success)
+    {
+        host->asyncTransfer       = NULL;
+        host->isAsyncTransferBusy = false;
+        /* host error recovery */
+        SDMMCHOST_ErrorRecovery(host->hostController.base);
+#if SDMMC_ENABLE_TRACE
+        SDMMC_TraceTransfer(content, error, host->asyncTraceStart, (uint32_t)kSDMMC_TraceFlagAsync);
+#endif
+    }
+
     (void)SDMMC_OSAMutexUnlock(&host->lock);
 
     return error;
@@ -646,7 +886,8 @@ status_t SDMMCHOST_Init(sdmmchost_t *host)
                        (uint32_t)kSDMMCHOST_SupportVoltage3v3 | (uint32_t)kSDMMCHOST_SupportVoltage1v8 |
                        (uint32_t)kSDMMCHOST_SupportVoltage1v2 | (uint32_t)kSDMMCHOST_Support4BitDataWidth |
                        (uint32_t)kSDMMCHOST_SupportDDRMode | (uint32_t)kSDMMCHOST_SupportDetectCardByData3 |
-                       (uint32_t)kSDMMCHOST_SupportDetectCardByCD | (uint32_t)kSDMMCHOST_SupportAutoCmd12;
+                       (uint32_t)kSDMMCHOST_SupportDetectCardByCD | (uint32_t)kSDMMCHOST_SupportAutoCmd12 |
+                       (uint32_t)kSDMMCHOST_SupportAutoCmd23;
 
     if (bus8bitCapability != 0U)
     {
@@ -673,6 +914,9 @@ status_t SDMMCHOST_Init(sdmmchost_t *host)
     host->maxBlockCount = SDMMCHOST_SUPPORT_MAX_BLOCK_COUNT;
     host->maxBlockSize  = SDMMCHOST_SUPPORT_MAX_BLOCK_LENGTH;
 
+    host->asyncTransfer       = NULL;
+    host->isAsyncTransferBusy = false;
+
     (void)SDMMC_OSAMutexCreate(&host->lock);
     (void)SDMMC_OSAMutexLock(&host->lock, osaWaitForever_c);
 
@@ -682,6 +926,11 @@ status_t SDMMCHOST_Init(sdmmchost_t *host)
     usdhcHost->config.readWatermarkLevel  = 0x80U;
     usdhcHost->config.writeWatermarkLevel = 0x80U;
     USDHC_Init(usdhcHost->base, &(usdhcHost->config));
+#if !(defined(FSL_FEATURE_USDHC_REGISTER_HOST_CTRL_CAP_HAS_NO_RETUNING_TIME_COUNTER) && \
+      FSL_FEATURE_USDHC_REGISTER_HOST_CTRL_CAP_HAS_NO_RETUNING_TIME_COUNTER)
+    /* the timer re-tuning request is serviced by the card driver between the requests */
+    USDHC_SetRetuningTimer(usdhcHost->base, SDMMCHOST_RETUNING_TIMER_COUNT);
+#endif
 
     /* Create handle for SDHC driver */
     usdhcCallback.TransferComplete = SDMMCHOST_TransferCompleteCallback;
@@ -960,17 +1209,102 @@ static status_t SDMMCHOST_ExecuteManualTuning(sdmmchost_t *host,
 
     return ret;
 }
+
+static status_t SDMMCHOST_ValidateTuningDelay(
+    sdmmchost_t *host, uint32_t tuningCmd, uint32_t *revBuf, uint32_t blockSize, uint32_t delaySetting)
+{
+    uint32_t preDelay  = (delaySetting >> 8U) & 0x7FU;
+    uint32_t outDelay  = (delaySetting >> 4U) & 0xFU;
+    uint32_t postDelay = delaySetting & 0xFU;
+    status_t error     = kStatus_SDMMC_TuningFail;
+
+    sdmmchost_transfer_t content = {0U};
+    sdmmchost_cmd_t command      = {0U};
+    sdmmchost_data_t data        = {0U};
+
+    command.index        = tuningCmd;
+    command.argument     = 0U;
+    command.responseType = kCARD_ResponseTypeR1;
+
+    data.blockSize  = blockSize;
+    data.blockCount = 1U;
+    data.rxData     = revBuf;
+
+    content.command = &command;
+    content.data    = &data;
+
+    /* sample the tuning block with the saved delay setting, same as one step of the manual tuning */
+    (void)USDHC_Reset(host->hostController.base, kUSDHC_ResetAll, 100U);
+    USDHC_EnableManualTuning(host->hostController.base, true);
+    USDHC_ForceClockOn(host->hostController.base, true);
+    (void)USDHC_SetTuningDelay(host->hostController.base, preDelay, outDelay, postDelay);
+
+    if ((SDMMCHOST_TransferFunction(host, &content) == kStatus_Success) &&
+        (((uint32_t)kUSDHC_TuningPassFlag & USDHC_GetInterruptStatusFlags(host->hostController.base)) != 0U))
+    {
+        USDHC_ClearInterruptStatusFlags(host->hostController.base, kUSDHC_TuningPassFlag);
+        error = kStatus_Success;
+    }
+
+    /* abort tuning */
+    USDHC_EnableManualTuning(host->hostController.base, false);
+    USDHC_ForceClockOn(host->hostController.base, false);
+    (void)USDHC_Reset(host->hostController.base, kUSDHC_ResetAll, 100U);
+
+    if (error == kStatus_Success)
+    {
+        (void)USDHC_SetTuningDelay(host->hostController.base, preDelay, outDelay, postDelay);
+        /* wait the tuning delay value write successfully */
+        while ((USDHC_GetTuningDelayStatus(host->hostController.base) & SDMMCHOST_TUNING_DELAY_SETTING_MASK) !=
+               delaySetting)
+        {
+        }
+        /* enable auto tuning */
+        USDHC_EnableAutoTuning(host->hostController.base, true);
+    }
+
+    return error;
+}
 #endif
 
 status_t SDMMCHOST_ExecuteTuning(sdmmchost_t *host, uint32_t tuningCmd, uint32_t *revBuf, uint32_t blockSize)
 {
 #if SDMMCHOST_SUPPORT_SDR104 || SDMMCHOST_SUPPORT_SDR50 || SDMMCHOST_SUPPORT_HS200 || SDMMCHOST_SUPPORT_HS400
+    const sdmmchost_tuning_persistence_t *persistence = host->tuningPersistence;
+    uint32_t delaySetting                             = 0U;
+    status_t error                                    = kStatus_Success;
+
+    /* the pending re-tuning event is serviced by this tuning */
+    USDHC_ClearInterruptStatusFlags(host->hostController.base, (uint32_t)kUSDHC_ReTuningEventFlag);
+
+    /* try the saved tuning result firstly, it takes one tuning block instead of the full sweep */
+    if ((persistence != NULL) && (persistence->load != NULL) &&
+        persistence->load(persistence->userData, &host->tuningKey, &delaySetting))
+    {
+        if (SDMMCHOST_ValidateTuningDelay(host, tuningCmd, revBuf, blockSize,
+                                          delaySetting & SDMMCHOST_TUNING_DELAY_SETTING_MASK) == kStatus_Success)
+        {
+            return kStatus_Success;
+        }
+    }
+
     if (host->tuningType == (uint32_t)kSDMMCHOST_StandardTuning)
     {
-        return SDMMCHOST_ExecuteStdTuning(host, tuningCmd, revBuf, blockSize);
+        error = SDMMCHOST_ExecuteStdTuning(host, tuningCmd, revBuf, blockSize);
+    }
+    else
+    {
+        error = SDMMCHOST_ExecuteManualTuning(host, tuningCmd, revBuf, blockSize);
+    }
+
+    if ((error == kStatus_Success) && (persistence != NULL) && (persistence->save != NULL))
+    {
+        /* the tap selected by either tuning is in the delay setting layout already */
+        delaySetting = USDHC_GetTuningDelayStatus(host->hostController.base);
+        persistence->save(persistence->userData, &host->tuningKey, delaySetting & SDMMCHOST_TUNING_DELAY_SETTING_MASK);
     }
 
-    return SDMMCHOST_ExecuteManualTuning(host, tuningCmd, revBuf, blockSize);
+    return error;
 #else
     return kStatus_SDMMC_NotSupportYet;
 #endif
@@ -985,6 +1319,9 @@ status_t SDMMCHOST_StartBoot(sdmmchost_t *host,
     sdmmchost_data_t data        = {0};
     status_t error               = kStatus_Success;
 
+    /* the boot data descriptors are appended after the last valid one, start from an empty table */
+    (void)memset(host->dmaDesBuffer, 0, host->dmaDesBufferWordsNum * sizeof(uint32_t));
+
     USDHC_SetMmcBootConfig(host->hostController.base, hostConfig);
 
     data.blockSize  = hostConfig->blockSize;
@@ -1033,3 +1370,40 @@ status_t SDMMCHOST_ReadBootData(sdmmchost_t *host, sdmmchost_boot_config_t *host
 
     return kStatus_Success;
 }
+
+status_t SDMMCHOST_ReadBootDataAsync(sdmmchost_t *host,
+                                     sdmmchost_boot_config_t *hostConfig,
+                                     uint8_t *buffer,
+                                     sdmmchost_transfer_callback_t callback,
+                                     void *userData)
+{
+    assert(host != NULL);
+    assert(hostConfig != NULL);
+    assert(buffer != NULL);
+
+    /* the boot configuration cannot be changed until the previous boot data is received */
+    (void)SDMMCHOST_WaitAsyncTransferComplete(host);
+
+    USDHC_SetMmcBootConfig(host->hostController.base, hostConfig);
+    USDHC_EnableMmcBoot(host->hostController.base, true);
+
+    (void)memset(&host->bootCommand, 0, sizeof(sdmmchost_cmd_t));
+    (void)memset(&host->bootData, 0, sizeof(sdmmchost_data_t));
+
+    host->bootData.blockSize  = hostConfig->blockSize;
+    host->bootData.blockCount = hostConfig->blockCount;
+    host->bootData.rxData     = (uint32_t *)(uint32_t)buffer;
+    host->bootData.dataType   = kUSDHC_TransferDataBootcontinous;
+    /* no command should be send out  */
+    host->bootCommand.type = kCARD_CommandTypeEmpty;
+
+    host->bootTransfer.data    = &host->bootData;
+    host->bootTransfer.command = &host->bootCommand;
+
+    if (kStatus_Success != SDMMCHOST_TransferAsync(host, &host->bootTransfer, callback, userData))
+    {
+        return kStatus_SDMMC_TransferFailed;
+    }
+
+    return kStatus_Success;
+}
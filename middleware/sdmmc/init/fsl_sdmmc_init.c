@@ -0,0 +1,181 @@
+/*
+ * Copyright 2020 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <string.h>
+#include "fsl_sdmmc_init.h"
+
+#if (defined(FSL_OSA_TASK_ENABLE) && (FSL_OSA_TASK_ENABLE > 0U))
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief slot init complete event */
+#define SDMMC_INIT_EVENT_SLOT_COMPLETE (1UL << 0U)
+/*! @brief slot init task idle delay after the slot complete, the task is deleted by the service wait */
+#define SDMMC_INIT_TASK_IDLE_DELAY (1000U)
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+/*!
+ * @brief Slot init task.
+ *
+ * @param param slot descriptor.
+ */
+static void SDMMC_InitSlotTask(osa_task_param_t param);
+
+/*!
+ * @brief Complete the slot init.
+ *
+ * @param slot slot descriptor.
+ * @param status init function return value.
+ * @param startTime init start time.
+ */
+static void SDMMC_InitSlotComplete(sdmmc_init_slot_t *slot, status_t status, uint32_t startTime);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+static void SDMMC_InitSlotComplete(sdmmc_init_slot_t *slot, status_t status, uint32_t startTime)
+{
+    sdmmc_init_service_t *service = slot->service;
+
+    slot->status      = status;
+    slot->elapsedTime = OSA_TimeGetMsec() - startTime;
+    slot->state       = (uint8_t)(status == kStatus_Success ? kSDMMC_InitSlotComplete : kSDMMC_InitSlotFailed);
+
+    if (service->callback != NULL)
+    {
+        service->callback(slot, service->userData);
+    }
+}
+
+static void SDMMC_InitSlotTask(osa_task_param_t param)
+{
+    sdmmc_init_slot_t *slot = (sdmmc_init_slot_t *)param;
+    uint32_t startTime      = OSA_TimeGetMsec();
+
+    SDMMC_InitSlotComplete(slot, slot->init(slot->card), startTime);
+    (void)SDMMC_OSAEventSet(&slot->event, SDMMC_INIT_EVENT_SLOT_COMPLETE);
+
+    /* the task is deleted by the service wait, it should not return */
+    while (true)
+    {
+        SDMMC_OSADelay(SDMMC_INIT_TASK_IDLE_DELAY);
+    }
+}
+
+status_t SDMMC_InitServiceStart(sdmmc_init_service_t *service,
+                                sdmmc_init_slot_t *slots,
+                                uint32_t slotCount,
+                                sdmmc_init_callback_t callback,
+                                void *userData)
+{
+    assert(service != NULL);
+
+    sdmmc_init_slot_t *slot = NULL;
+    uint32_t i;
+
+    if ((slots == NULL) || (slotCount == 0U))
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    for (i = 0U; i < slotCount; i++)
+    {
+        if ((slots[i].card == NULL) || (slots[i].init == NULL))
+        {
+            return kStatus_InvalidArgument;
+        }
+    }
+
+    service->slots       = slots;
+    service->slotCount   = slotCount;
+    service->callback    = callback;
+    service->userData    = userData;
+    service->elapsedTime = 0U;
+    service->startTime   = OSA_TimeGetMsec();
+
+    for (i = 0U; i < slotCount; i++)
+    {
+        slot              = &slots[i];
+        slot->service     = service;
+        slot->status      = kStatus_Success;
+        slot->elapsedTime = 0U;
+        slot->state       = (uint8_t)kSDMMC_InitSlotRunning;
+        (void)SDMMC_OSAEventCreate(&slot->event);
+
+        (void)memset(&slot->taskDef, 0, sizeof(slot->taskDef));
+        slot->taskDef.pthread   = SDMMC_InitSlotTask;
+        slot->taskDef.tpriority = SDMMC_INIT_TASK_PRIORITY;
+        slot->taskDef.instances = 1U;
+        slot->taskDef.stacksize = SDMMC_INIT_TASK_STACK_SIZE;
+        slot->taskDef.tstack    = slot->taskStack;
+        slot->taskDef.tname     = (uint8_t *)(uintptr_t)(slot->name == NULL ? "sdmmc_init" : slot->name);
+
+        if (KOSA_StatusSuccess !=
+            OSA_TaskCreate((osa_task_handle_t)slot->taskHandle, &slot->taskDef, (osa_task_param_t)slot))
+        {
+            SDMMC_LOG("\r\nError: create init task for slot %d failed\r\n", i);
+            slot->taskDef.pthread = NULL;
+            (void)SDMMC_OSAEventDestroy(&slot->event);
+            SDMMC_InitSlotComplete(slot, kStatus_Fail, OSA_TimeGetMsec());
+        }
+    }
+
+    return kStatus_Success;
+}
+
+status_t SDMMC_InitServiceWait(sdmmc_init_service_t *service, uint32_t timeoutMilliseconds)
+{
+    assert(service != NULL);
+
+    sdmmc_init_slot_t *slot = NULL;
+    uint32_t startTime      = OSA_TimeGetMsec();
+    uint32_t timeout        = timeoutMilliseconds;
+    uint32_t elapsedTime    = 0U;
+    uint32_t event          = 0U;
+    bool isFailed           = false;
+    uint32_t i;
+
+    for (i = 0U; i < service->slotCount; i++)
+    {
+        slot = &service->slots[i];
+
+        /* the slot task is deleted after it reports the complete event, the callback is done then */
+        if (slot->taskDef.pthread != NULL)
+        {
+            if (timeoutMilliseconds != osaWaitForever_c)
+            {
+                elapsedTime = OSA_TimeGetMsec() - startTime;
+                timeout     = elapsedTime >= timeoutMilliseconds ? 0U : timeoutMilliseconds - elapsedTime;
+            }
+
+            if (kStatus_Success != SDMMC_OSAEventWait(&slot->event, SDMMC_INIT_EVENT_SLOT_COMPLETE, timeout, &event))
+            {
+                return kStatus_Timeout;
+            }
+
+            (void)OSA_TaskDestroy((osa_task_handle_t)slot->taskHandle);
+            slot->taskDef.pthread = NULL;
+            (void)SDMMC_OSAEventDestroy(&slot->event);
+        }
+
+        if (slot->state == (uint8_t)kSDMMC_InitSlotFailed)
+        {
+            isFailed = true;
+        }
+    }
+
+    service->elapsedTime = OSA_TimeGetMsec() - service->startTime;
+
+    return isFailed ? kStatus_Fail : kStatus_Success;
+}
+#endif
@@ -0,0 +1,169 @@
+/*
+ * Copyright 2020 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _FSL_SDMMC_INIT_H_
+#define _FSL_SDMMC_INIT_H_
+
+#include "fsl_sdmmc_common.h"
+
+/*!
+ * @addtogroup sdmmc_init SDMMC init service
+ * @ingroup card
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief Init service version. */
+#define FSL_SDMMC_INIT_VERSION (MAKE_VERSION(1U, 0U, 0U)) /*1.0.0*/
+
+/*! @brief slot init task stack size in byte */
+#ifndef SDMMC_INIT_TASK_STACK_SIZE
+#define SDMMC_INIT_TASK_STACK_SIZE (2048U)
+#endif
+
+/*! @brief slot init task priority */
+#ifndef SDMMC_INIT_TASK_PRIORITY
+#define SDMMC_INIT_TASK_PRIORITY (OSA_PRIORITY_HIGH)
+#endif
+
+/*! @brief sdmmc init slot state */
+typedef enum _sdmmc_init_slot_state
+{
+    kSDMMC_InitSlotIdle     = 0U, /*!< slot init is not started */
+    kSDMMC_InitSlotRunning  = 1U, /*!< slot init is running */
+    kSDMMC_InitSlotComplete = 2U, /*!< slot init complete successfully */
+    kSDMMC_InitSlotFailed   = 3U, /*!< slot init failed, the slot status is the init function return value */
+} sdmmc_init_slot_state_t;
+
+/*!
+ * @brief sdmmc init slot card init function.
+ *
+ * @param card card descriptor, such as sd_card_t or mmc_card_t.
+ */
+typedef status_t (*sdmmc_init_function_t)(void *card);
+
+/*! @brief sdmmc init slot, the slot is allocated by the caller and must stay valid until the service wait return */
+typedef struct _sdmmc_init_slot
+{
+    void *card;                 /*!< card descriptor pass to init function */
+    sdmmc_init_function_t init; /*!< card init function, such as SD_Init or MMC_Init */
+    const char *name;           /*!< slot name, used as the init task name */
+    uint32_t *taskStack;        /*!< init task stack of SDMMC_INIT_TASK_STACK_SIZE bytes, only used when the RTOS
+                                     support static allocation only, NULL otherwise */
+
+    volatile uint8_t state; /*!< slot state, reference sdmmc_init_slot_state_t */
+    status_t status;        /*!< init function return value */
+    uint32_t elapsedTime;   /*!< init elapsed time in millisecond */
+
+    struct _sdmmc_init_service *service; /*!< service which the slot belongs to */
+    sdmmc_osa_event_t event;             /*!< slot init complete event */
+    osa_task_def_t taskDef;              /*!< init task definition */
+    OSA_TASK_HANDLE_DEFINE(taskHandle);  /*!< init task handle */
+} sdmmc_init_slot_t;
+
+/*!
+ * @brief sdmmc init slot complete callback.
+ *
+ * The callback is invoked from the slot init task once the slot init is complete or failed.
+ *
+ * @param slot slot descriptor.
+ * @param userData user data.
+ */
+typedef void (*sdmmc_init_callback_t)(sdmmc_init_slot_t *slot, void *userData);
+
+/*! @brief sdmmc init service */
+typedef struct _sdmmc_init_service
+{
+    sdmmc_init_slot_t *slots;       /*!< slot array */
+    uint32_t slotCount;             /*!< slot count */
+    sdmmc_init_callback_t callback; /*!< slot complete callback */
+    void *userData;                 /*!< slot complete callback user data */
+    uint32_t startTime;             /*!< service start time in millisecond */
+    uint32_t elapsedTime;           /*!< elapsed time of all the slots in millisecond */
+} sdmmc_init_service_t;
+
+/*************************************************************************************************
+ * API
+ ************************************************************************************************/
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*!
+ * @name SDMMC init service Function
+ * @{
+ */
+
+#if (defined(FSL_OSA_TASK_ENABLE) && (FSL_OSA_TASK_ENABLE > 0U))
+/*!
+ * @brief Starts the init of all the slots concurrently.
+ *
+ * Each slot is initialized by a dedicated task, the card init function blocks the slot task only, so the host and card
+ * init of the slots overlap in the power on delay, voltage switch, operation condition polling and tuning, the total
+ * init time is close to the slowest slot instead of the sum of the slots. The slots must use different hosts.
+ * The service is available when the OSA task module is enabled by FSL_OSA_TASK_ENABLE, such as on FreeRTOS.
+ *
+ * Example:
+   @code
+   static status_t SD_SlotInit(void *card)
+   {
+       return SD_Init((sd_card_t *)card);
+   }
+
+   static status_t MMC_SlotInit(void *card)
+   {
+       return MMC_Init((mmc_card_t *)card);
+   }
+
+   slots[0].card = &g_mmc;
+   slots[0].init = MMC_SlotInit;
+   slots[0].name = "eMMC";
+   slots[1].card = &g_sd;
+   slots[1].init = SD_SlotInit;
+   slots[1].name = "SD";
+   SDMMC_InitServiceStart(&service, slots, 2U, NULL, NULL);
+   SDMMC_InitServiceWait(&service, osaWaitForever_c);
+   @endcode
+ *
+ * @param service service descriptor.
+ * @param slots slot array.
+ * @param slotCount slot count.
+ * @param callback optional slot complete callback.
+ * @param userData slot complete callback user data.
+ * @retval kStatus_Success all the slot init tasks are started, the slot which cannot start the task is reported as
+ * failed with kStatus_Fail.
+ * @retval kStatus_InvalidArgument invalid argument.
+ */
+status_t SDMMC_InitServiceStart(sdmmc_init_service_t *service,
+                                sdmmc_init_slot_t *slots,
+                                uint32_t slotCount,
+                                sdmmc_init_callback_t callback,
+                                void *userData);
+
+/*!
+ * @brief Waits the init of all the slots complete.
+ *
+ * The slot init tasks are deleted once their slots are complete, the function can be called again after timeout.
+ *
+ * @param service service descriptor.
+ * @param timeoutMilliseconds timeout value in millisecond, osaWaitForever_c to wait forever.
+ * @retval kStatus_Success all the slots are initialized successfully.
+ * @retval kStatus_Fail one or more slots failed, reference the state and status of each slot.
+ * @retval kStatus_Timeout one or more slots are still running.
+ */
+status_t SDMMC_InitServiceWait(sdmmc_init_service_t *service, uint32_t timeoutMilliseconds);
+#endif
+
+/* @} */
+
+#if defined(__cplusplus)
+}
+#endif
+/*! @} */
+#endif /* _FSL_SDMMC_INIT_H_*/
@@ -26,6 +26,25 @@
 #endif
 /*!@brief power reset delay */
 #define MMC_POWER_RESET_DELAY (500U)
+/*! @brief register snapshot valid magic */
+#define MMC_REGISTER_SNAPSHOT_MAGIC (0x4D4D5253U) /* "MMRS" */
+/*! @brief card flags restored from the register snapshot, the low 8 bits are the card type in extended CSD */
+#define MMC_REGISTER_SNAPSHOT_FLAGS                                                           \
+    (0xFFU | (uint32_t)kMMC_SupportAlternateBootFlag | (uint32_t)kMMC_SupportDDRBootFlag |    \
+     (uint32_t)kMMC_SupportHighSpeedBootFlag | (uint32_t)kMMC_SupportEnhanceHS400StrobeFlag | \
+     (uint32_t)kMMC_SupportCommandQueueFlag | (uint32_t)kMMC_SupportBackgroundOperationFlag | \
+     (uint32_t)kMMC_SupportHighPriorityInterruptFlag)
+/*! @brief data bus width bit in the register snapshot, the strobe mode uses the same bit as 8 bit DDR */
+#define MMC_REGISTER_SNAPSHOT_BUS_WIDTH(width) (1UL << ((uint32_t)(width)&0xFU))
+/*! @brief boot stream chunk complete event */
+#define MMC_BOOT_STREAM_EVENT_CHUNK_COMPLETE (1UL << 0U)
+
+/*! @brief boot stream chunk read context */
+typedef struct _mmc_boot_stream_context
+{
+    sdmmc_osa_event_t event;  /*!< chunk read complete event */
+    volatile status_t status; /*!< chunk read status */
+} mmc_boot_stream_context_t;
 /*******************************************************************************
  * Prototypes
  ******************************************************************************/
@@ -204,6 +223,19 @@ static status_t MMC_ReceiveTestPattern(mmc_card_t *card, uint32_t blockSize, uin
  */
 static status_t MMC_TestDataBusWidth(mmc_card_t *card, mmc_data_bus_width_t width);
 
+/*!
+ * @brief Compare the raw register content with the register snapshot and update the snapshot.
+ *
+ * The snapshot is invalidated if the content is different.
+ *
+ * @param snapshot register snapshot.
+ * @param snapshotRegister register content in the snapshot.
+ * @param rawRegister raw register content of the card.
+ */
+static void MMC_UpdateSnapshotRegister(mmc_register_snapshot_t *snapshot,
+                                       uint32_t *snapshotRegister,
+                                       const uint8_t *rawRegister);
+
 /*!
  * @brief Send SET_BUS_WIDTH command to set the bus width.
  *
@@ -256,6 +288,25 @@ static status_t MMC_SwitchHSTiming(mmc_card_t *card, uint8_t timing, uint8_t dri
  */
 static status_t MMC_SwitchToHS400(mmc_card_t *card);
 
+/*!
+ * @brief switch to HS400 enhanced strobe mode, the HS200 mode and tuning are not needed.
+ *
+ * @param card Card descriptor.
+ * @retval kStatus_SDMMC_ConfigureExtendedCsdFailed Configure extended CSD failed.
+ * @retval kStatus_SDMMC_SwitchBusTimingFailed switch bus timing fail.
+ * @retval kStatus_SDMMC_SetDataBusWidthFailed switch bus width fail.
+ * @retval kStatus_Success Operate successfully.
+ */
+static status_t MMC_SwitchToHS400EnhancedStrobe(mmc_card_t *card);
+
+/*!
+ * @brief Get HS400 mode bus frequency supported by the host source clock.
+ *
+ * @param card Card descriptor.
+ * @return HS400 bus frequency, the card clock is half of it.
+ */
+static uint32_t MMC_GetHS400Freq(mmc_card_t *card);
+
 /*!
  * @brief switch to HS200 mode.
  *
@@ -335,6 +386,69 @@ static status_t MMC_CheckEraseGroupRange(mmc_card_t *card, uint32_t startGroup,
  * @retval kStatus_SDMMC_TransferFailed transfer fail
  */
 static inline status_t MMC_ExecuteTuning(mmc_card_t *card);
+
+/*!
+ * @brief Execute the re-tuning requested by the host before the next request.
+ *
+ * The tuning is executed between the requests instead of after the transfer rejected by the host, the transfer error
+ * recovery will retry and re-tune again if the tuning fails.
+ *
+ * @param card Card descriptor.
+ */
+static void MMC_ScheduleReTuning(mmc_card_t *card);
+
+/*!
+ * @brief Switch the bus clock to the bus speed governor target level before the next request.
+ *
+ * @param card Card descriptor.
+ */
+static void MMC_BusGovernorApply(mmc_card_t *card);
+
+/*!
+ * @brief Polling the card status busy and record the busy latency.
+ *
+ * @param card Card descriptor.
+ * @param checkStatus True to check the card status by CMD13 after DAT0 is released.
+ * @param timeoutMs Polling timeout in ms.
+ * @param histogram Busy latency histogram, NULL if the latency is not recorded.
+ * @retval kStatus_SDMMC_CardStatusIdle Card is idle.
+ * @retval kStatus_SDMMC_CardStatusBusy Card is busy.
+ * @retval kStatus_SDMMC_TransferFailed Command transfer failed.
+ * @retval kStatus_SDMMC_SwitchFailed Status command reports switch error.
+ */
+static status_t MMC_PollingCardStatusLatency(mmc_card_t *card,
+                                             bool checkStatus,
+                                             uint32_t timeoutMs,
+                                             sdmmc_latency_histogram_t *histogram);
+
+/*!
+ * @brief Send the high priority interrupt to stop the card programming or background operations.
+ *
+ * @param card Card descriptor.
+ * @retval kStatus_SDMMC_TransferFailed Transfer failed.
+ * @retval kStatus_SDMMC_PollingCardIdleFailed Card is not out of interrupt in OUT_OF_INTERRUPT_TIME.
+ * @retval kStatus_Success Operate successfully.
+ */
+static status_t MMC_HighPriorityInterrupt(mmc_card_t *card);
+
+/*!
+ * @brief Stop the manual background operations started by the idle hook before the next request.
+ *
+ * The background operations are interrupted by HPI if it is enabled, otherwise the next request waits for them.
+ *
+ * @param card Card descriptor.
+ */
+static void MMC_InterruptBackgroundOperation(mmc_card_t *card);
+
+/*!
+ * @brief Yield the card lock to the pending read requests between the write chunks.
+ *
+ * @param card Card descriptor.
+ * @param interruptProgram True to stop the programming of the last chunk by HPI before yielding.
+ * @retval true The programming of the last chunk is interrupted, the chunk should be written again.
+ * @retval false The last chunk is written.
+ */
+static bool MMC_WriteYield(mmc_card_t *card, bool interruptProgram);
 /*!
  * @brief Read data from specific MMC card
  *
@@ -361,14 +475,59 @@ static status_t MMC_Read(
  * @param startBlock Start block to write.
  * @param blockSize Block size.
  * @param blockCount Block count to write.
+ * @param blockCountFlags CMD23 flags of the write, such as MMC_SET_BLOCK_COUNT_FORCED_PROGRAMMING_MASK, the write is
+ * always closed-ended by CMD23 if any flag is set.
  * @retval kStatus_SDMMC_CardNotSupport Card doesn't support.
  * @retval kStatus_SDMMC_SetBlockCountFailed Set block count failed.
  * @retval kStatus_SDMMC_TransferFailed Transfer failed.
  * @retval kStatus_SDMMC_StopTransmissionFailed Stop transmission failed.
  * @retval kStatus_Success Operate successfully.
  */
-static status_t MMC_Write(
-    mmc_card_t *card, const uint8_t *buffer, uint32_t startBlock, uint32_t blockSize, uint32_t blockCount);
+static status_t MMC_Write(mmc_card_t *card,
+                          const uint8_t *buffer,
+                          uint32_t startBlock,
+                          uint32_t blockSize,
+                          uint32_t blockCount,
+                          uint32_t blockCountFlags);
+
+/*!
+ * @brief Write data blocks with CMD23 flags.
+ *
+ * @param card Card descriptor.
+ * @param buffer Buffer to hold the data to write.
+ * @param startBlock Start block to write.
+ * @param blockCount Block count to write.
+ * @param blockCountFlags CMD23 flags of each write command.
+ * @retval kStatus_InvalidArgument Invalid argument.
+ * @retval kStatus_SDMMC_TransferFailed Transfer failed.
+ * @retval kStatus_Success Operate successfully.
+ */
+static status_t MMC_WriteBlocksWithFlags(
+    mmc_card_t *card, const uint8_t *buffer, uint32_t startBlock, uint32_t blockCount, uint32_t blockCountFlags);
+
+/*!
+ * @brief Get the block count of the next reliable write command.
+ *
+ * @param card Card descriptor.
+ * @param startBlock Start block of the command.
+ * @param blockLeft Block count left to write.
+ * @param reliableBlocks Reliable write sector count.
+ * @return The block count written atomically by the next command.
+ */
+static uint32_t MMC_GetReliableWriteBlocks(mmc_card_t *card,
+                                           uint32_t startBlock,
+                                           uint32_t blockLeft,
+                                           uint32_t reliableBlocks);
+
+/*!
+ * @brief Flush the cached data to the nonvolatile storage.
+ *
+ * @param card Card descriptor.
+ * @retval kStatus_SDMMC_NotSupportYet Cache is not supported or not enabled.
+ * @retval kStatus_SDMMC_ConfigureExtendedCsdFailed Flush failed.
+ * @retval kStatus_Success Operate successfully.
+ */
+static status_t MMC_Flush(mmc_card_t *card);
 
 /*!
  * @brief MMC card erase function
@@ -376,10 +535,29 @@ static status_t MMC_Write(
  * @param card Card descriptor.
  * @param startGroupAddress start erase group address.
  * @param endGroupAddress end erase group address.
+ * @param argument erase command argument, reference mmc_erase_argument_t.
+ * @retval kStatus_SDMMC_TransferFailed Transfer failed.
+ * @retval kStatus_Success Operate successfully.
+ */
+static status_t MMC_Erase(mmc_card_t *card, uint32_t startGroupAddress, uint32_t endGroupAddress, uint32_t argument);
+
+/*!
+ * @brief MMC card trim or discard the write blocks.
+ *
+ * @param card Card descriptor.
+ * @param startBlock start block.
+ * @param blockCount block count.
+ * @param argument kMMC_TrimArgument or kMMC_DiscardArgument.
+ * @retval kStatus_SDMMC_NotSupportYet Trim or discard is not supported.
+ * @retval kStatus_InvalidArgument Invalid argument.
+ * @retval kStatus_SDMMC_PollingCardIdleFailed Polling card idle failed.
  * @retval kStatus_SDMMC_TransferFailed Transfer failed.
  * @retval kStatus_Success Operate successfully.
  */
-static status_t MMC_Erase(mmc_card_t *card, uint32_t startGroupAddress, uint32_t endGroupAddress);
+static status_t MMC_EraseWriteBlocks(mmc_card_t *card,
+                                     uint32_t startBlock,
+                                     uint32_t blockCount,
+                                     mmc_erase_argument_t argument);
 
 /*!
  * @brief card transfer function wrapper
@@ -394,6 +572,24 @@ static status_t MMC_Erase(mmc_card_t *card, uint32_t startGroupAddress, uint32_t
  */
 static status_t MMC_Transfer(mmc_card_t *card, sdmmchost_transfer_t *content, uint32_t retry);
 
+/*!
+ * @brief card closed-ended transfer function.
+ * The SET_BLOCK_COUNT command only applies to the data command following it, so it is sent before each attempt of the
+ * data command, including the retry.
+ * @param card Card descriptor.
+ * @param content Transfer content.
+ * @param blockCountArgument SET_BLOCK_COUNT argument, the block count and the CMD23 flags.
+ * @param retry Retry times.
+ * @retval kStatus_SDMMC_SetBlockCountFailed set block count fail
+ * @retval kStatus_SDMMC_TransferFailed transfer fail
+ * @retval kStatus_SDMMC_TuningFail tuning fail
+ * @retval kStatus_Success transfer success
+ */
+static status_t MMC_TransferClosedEnded(mmc_card_t *card,
+                                        sdmmchost_transfer_t *content,
+                                        uint32_t blockCountArgument,
+                                        uint32_t retry);
+
 /*!
  * @brief card validate operation voltage
  * This function is used to validate the operation voltage bettwen host and card
@@ -405,6 +601,128 @@ static status_t MMC_Transfer(mmc_card_t *card, sdmmchost_transfer_t *content, ui
  */
 static status_t MMC_ValidateOperationVoltage(mmc_card_t *card, uint32_t *opcode);
 
+/*!
+ * @brief Queue one task to the card by CMD44 and CMD45.
+ *
+ * @param card Card descriptor.
+ * @param taskId Task ID.
+ * @param task Task to queue.
+ * @retval kStatus_SDMMC_TransferFailed Transfer failed.
+ * @retval kStatus_Success Operate successfully.
+ */
+static status_t MMC_QueueTask(mmc_card_t *card, uint32_t taskId, const mmc_cmdq_task_t *task);
+
+/*!
+ * @brief Polling the queue status register until any of the queued tasks is ready for execution.
+ *
+ * @param card Card descriptor.
+ * @param queuedTasks Bitmap of the queued tasks.
+ * @param readyTasks Bitmap of the tasks ready for execution.
+ * @retval kStatus_SDMMC_TransferFailed Transfer failed.
+ * @retval kStatus_SDMMC_PollingCardIdleFailed No task is ready before timeout.
+ * @retval kStatus_Success Operate successfully.
+ */
+static status_t MMC_PollingQueueStatus(mmc_card_t *card, uint32_t queuedTasks, uint32_t *readyTasks);
+
+/*!
+ * @brief Execute one ready task by CMD46 or CMD47.
+ *
+ * @param card Card descriptor.
+ * @param taskId Task ID.
+ * @param task Task to execute.
+ * @retval kStatus_SDMMC_PollingCardIdleFailed Wait card idle failed.
+ * @retval kStatus_SDMMC_TransferFailed Transfer failed.
+ * @retval kStatus_Success Operate successfully.
+ */
+static status_t MMC_ExecuteTask(mmc_card_t *card, uint32_t taskId, const mmc_cmdq_task_t *task);
+
+/*!
+ * @brief Discard the entire command queue by CMD48.
+ *
+ * @param card Card descriptor.
+ * @retval kStatus_SDMMC_TransferFailed Transfer failed.
+ * @retval kStatus_Success Operate successfully.
+ */
+static status_t MMC_DiscardQueue(mmc_card_t *card);
+
+/*!
+ * @brief Transfer the tasks through the command queue.
+ *
+ * @param card Card descriptor.
+ * @param task Task array.
+ * @param taskCount Task count.
+ * @retval kStatus_InvalidArgument Invalid task argument.
+ * @retval kStatus_SDMMC_TransferFailed Transfer failed.
+ * @retval kStatus_SDMMC_PollingCardIdleFailed Polling queue status timeout.
+ * @retval kStatus_Success Operate successfully.
+ */
+static status_t MMC_CommandQueueExecute(mmc_card_t *card, mmc_cmdq_task_t *task, uint32_t taskCount);
+
+/*!
+ * @brief Switch the command queue mode of the card.
+ *
+ * @param card Card descriptor.
+ * @param enable True is enabling the command queue, false is disabling the command queue.
+ * @retval kStatus_SDMMC_ConfigureExtendedCsdFailed Switch failed.
+ * @retval kStatus_Success Operate successfully.
+ */
+static status_t MMC_SwitchCommandQueue(mmc_card_t *card, bool enable);
+
+/*!
+ * @brief Validate the packed entries and build the packed command header.
+ *
+ * @param card Card descriptor.
+ * @param entry Entry array.
+ * @param entryCount Entry count.
+ * @param packedBuffer Packed buffer, the header is built in the first block.
+ * @param packedBufferSize Packed buffer size.
+ * @param isWrite True is packed write, false is packed read.
+ * @param dataBlocks Total data block count of all the entries.
+ * @retval kStatus_SDMMC_NotSupportYet The card doesn't support the packed command.
+ * @retval kStatus_InvalidArgument Invalid entry argument.
+ * @retval kStatus_Success Operate successfully.
+ */
+static status_t MMC_BuildPackedHeader(mmc_card_t *card,
+                                      mmc_packed_entry_t *entry,
+                                      uint32_t entryCount,
+                                      uint8_t *packedBuffer,
+                                      uint32_t packedBufferSize,
+                                      bool isWrite,
+                                      uint32_t *dataBlocks);
+
+/*!
+ * @brief Send CMD23 with packed flag then transfer the packed data with CMD25 or CMD18.
+ *
+ * @param card Card descriptor.
+ * @param buffer Data buffer.
+ * @param startBlock Start block of the first packed entry.
+ * @param blockCount Block count.
+ * @param isWrite True is CMD25, false is CMD18.
+ * @retval kStatus_SDMMC_SetBlockCountFailed Set block count failed.
+ * @retval kStatus_SDMMC_TransferFailed Transfer failed.
+ * @retval kStatus_Success Operate successfully.
+ */
+static status_t MMC_PackedTransfer(
+    mmc_card_t *card, uint8_t *buffer, uint32_t startBlock, uint32_t blockCount, bool isWrite);
+
+/*!
+ * @brief Read the packed command status and set the status of the entries complete before the failure.
+ *
+ * @param card Card descriptor.
+ * @param entry Entry array.
+ * @param entryCount Entry count.
+ */
+static void MMC_PackedCommandError(mmc_card_t *card, mmc_packed_entry_t *entry, uint32_t entryCount);
+
+/*!
+ * @brief Boot stream chunk read complete callback.
+ *
+ * @param host Host handler.
+ * @param status Chunk read status.
+ * @param userData Boot stream chunk read context.
+ */
+static void MMC_BootStreamChunkComplete(sdmmchost_t *host, status_t status, void *userData);
+
 /*******************************************************************************
  * Variables
  ******************************************************************************/
@@ -450,6 +768,7 @@ static status_t MMC_ExecuteTuning(mmc_card_t *card)
     assert(card != NULL);
 
     uint32_t blockSize = 0U;
+    status_t error;
 
     if (card->busWidth == kMMC_DataBusWidth4bit)
     {
@@ -465,26 +784,95 @@ static status_t MMC_ExecuteTuning(mmc_card_t *card)
         return kStatus_Success;
     }
 
-    return SDMMCHOST_ExecuteTuning(card->host, (uint32_t)kMMC_SendTuningBlock,
-                                   (uint32_t *)FSL_SDMMC_CARD_INTERNAL_BUFFER_ALIGN_ADDR(card->internalBuffer),
-                                   blockSize);
+    /* the card ID of the key is set when reading CID */
+    card->host->tuningKey.busMode     = (uint32_t)card->busTiming;
+    card->host->tuningKey.busClock_Hz = card->busClock_Hz;
+
+    SDMMC_INSTRUMENT_COUNT(&card->instrument, tuningEvents);
+    error = SDMMCHOST_ExecuteTuning(card->host, (uint32_t)kMMC_SendTuningBlock,
+                                    (uint32_t *)FSL_SDMMC_CARD_INTERNAL_BUFFER_ALIGN_ADDR(card->internalBuffer),
+                                    blockSize);
+    if (error != kStatus_Success)
+    {
+        SDMMC_INSTRUMENT_COUNT(&card->instrument, tuningErrors);
+    }
+
+    return error;
+}
+
+static void MMC_ScheduleReTuning(mmc_card_t *card)
+{
+    /* HS400 is tuned in HS200 timing during the init only */
+    if ((card->busTiming != kMMC_HighSpeed200Timing) || (!SDMMCHOST_IsReTuningRequest(card->host)))
+    {
+        return;
+    }
+
+    if (MMC_ExecuteTuning(card) != kStatus_Success)
+    {
+        SDMMC_LOG("\r\nWarning: scheduled retuning failed.\r\n");
+        return;
+    }
+
+    card->reTuningStatistics.avoidedRetries++;
+}
+
+static void MMC_BusGovernorApply(mmc_card_t *card)
+{
+    sdmmc_bus_governor_t *governor = &card->busGovernor;
+    uint32_t retry                 = SDMMC_BUS_GOVERNOR_LEVEL_COUNT;
+
+    /* the tuning failure of the probed level steps down again */
+    while ((governor->level != governor->targetLevel) && (retry-- != 0U))
+    {
+        SDMMC_LOG("\r\nlog: bus governor switch to level %d.\r\n", governor->targetLevel);
+        card->busClock_Hz =
+            SDMMCHOST_SetCardClock(card->host, SDMMC_BUS_GOVERNOR_LEVEL_CLOCK(governor, governor->targetLevel));
+        SDMMC_BusGovernorSetLevel(governor, governor->targetLevel);
+
+        if ((card->busTiming == kMMC_HighSpeed200Timing) && (MMC_ExecuteTuning(card) != kStatus_Success))
+        {
+            SDMMC_BusGovernorUpdate(governor, (uint32_t)kSDMMC_BusGovernorTuningError);
+        }
+    }
 }
 
 static status_t MMC_Transfer(mmc_card_t *card, sdmmchost_transfer_t *content, uint32_t retry)
+{
+    return MMC_TransferClosedEnded(card, content, 0U, retry);
+}
+
+static status_t MMC_TransferClosedEnded(mmc_card_t *card,
+                                        sdmmchost_transfer_t *content,
+                                        uint32_t blockCountArgument,
+                                        uint32_t retry)
 {
     assert(content != NULL);
     status_t error;
     uint32_t retuningCount = 3U;
+    uint32_t startCycles   = 0U;
 
     do
     {
-        error = SDMMCHOST_TransferFunction(card->host, content);
+        if ((blockCountArgument != 0U) && (kStatus_Success != MMC_SetBlockCount(card, blockCountArgument)))
+        {
+            error = kStatus_SDMMC_SetBlockCountFailed;
+            break;
+        }
+
+        startCycles = SDMMC_INSTRUMENT_TIMESTAMP();
+        error       = SDMMCHOST_TransferFunction(card->host, content);
+        SDMMC_INSTRUMENT_TRANSFER(&card->instrument, content, error, startCycles);
 
         if (error == kStatus_Success)
         {
+            SDMMC_BusGovernorUpdate(&card->busGovernor, (uint32_t)kSDMMC_BusGovernorTransferSuccess);
             break;
         }
 
+        SDMMC_BusGovernorUpdate(&card->busGovernor, content->data != NULL ? (uint32_t)kSDMMC_BusGovernorDataError :
+                                                                             (uint32_t)kSDMMC_BusGovernorCommandError);
+
         if (((retry == 0U) && (content->data != NULL)) || (error == kStatus_SDMMC_ReTuningRequest))
         {
             /* abort previous transfer firstly */
@@ -496,10 +884,14 @@ static status_t MMC_Transfer(mmc_card_t *card, sdmmchost_transfer_t *content, ui
                 {
                     break;
                 }
+                card->reTuningStatistics.errorTuning++;
+                card->reTuningStatistics.transferRetries++;
+                SDMMC_INSTRUMENT_COUNT(&card->instrument, retries);
                 /* perform retuning */
                 if (MMC_ExecuteTuning(card) != kStatus_Success)
                 {
                     error = kStatus_SDMMC_TuningFail;
+                    SDMMC_BusGovernorUpdate(&card->busGovernor, (uint32_t)kSDMMC_BusGovernorTuningError);
                     SDMMC_LOG("\r\nError: retuning failed.");
                     break;
                 }
@@ -514,6 +906,8 @@ static status_t MMC_Transfer(mmc_card_t *card, sdmmchost_transfer_t *content, ui
         if (retry != 0U)
         {
             retry--;
+            card->reTuningStatistics.transferRetries++;
+            SDMMC_INSTRUMENT_COUNT(&card->instrument, retries);
         }
         else
         {
@@ -560,6 +954,14 @@ static status_t MMC_SendStatus(mmc_card_t *card, uint32_t *status)
 }
 
 status_t MMC_PollingCardStatusBusy(mmc_card_t *card, bool checkStatus, uint32_t timeoutMs)
+{
+    return MMC_PollingCardStatusLatency(card, checkStatus, timeoutMs, NULL);
+}
+
+static status_t MMC_PollingCardStatusLatency(mmc_card_t *card,
+                                             bool checkStatus,
+                                             uint32_t timeoutMs,
+                                             sdmmc_latency_histogram_t *histogram)
 {
     assert(card != NULL);
 
@@ -567,6 +969,7 @@ status_t MMC_PollingCardStatusBusy(mmc_card_t *card, bool checkStatus, uint32_t
     bool cardBusy            = false;
     status_t error           = kStatus_SDMMC_CardStatusBusy;
     uint32_t status          = 0U;
+    uint32_t startCycles     = SDMMC_INSTRUMENT_TIMESTAMP();
 
     do
     {
@@ -619,6 +1022,12 @@ status_t MMC_PollingCardStatusBusy(mmc_card_t *card, bool checkStatus, uint32_t
 
     } while (statusTimeoutUs != 0U);
 
+    if (histogram != NULL)
+    {
+        SDMMC_LatencyHistogramRecord(histogram, (timeoutMs * 1000U) - statusTimeoutUs);
+    }
+    SDMMC_INSTRUMENT_BUSY_WAIT(&card->instrument, startCycles);
+
     return error;
 }
 
@@ -647,56 +1056,151 @@ static status_t MMC_StopTransmission(mmc_card_t *card)
     return kStatus_Success;
 }
 
-static status_t MMC_SendOperationCondition(mmc_card_t *card, uint32_t arg)
+static status_t MMC_HighPriorityInterrupt(mmc_card_t *card)
 {
     assert(card != NULL);
 
-    sdmmchost_cmd_t command      = {0};
     sdmmchost_transfer_t content = {0};
-    status_t error;
-    uint32_t i = MMC_CMD1_RETRY_TIMES;
+    sdmmchost_cmd_t command      = {0};
+    /* OUT_OF_INTERRUPT_TIME is united in 10ms */
+    uint32_t timeoutMs = (uint32_t)card->extendedCsd.outOfInterruptBusyTiming * 10U;
+    uint32_t status    = 0U;
+    status_t error     = kStatus_Success;
 
-    /* Send CMD1 with the intended voltage range in the argument(either 0x00FF8000 or 0x00000080) */
-    command.index        = (uint32_t)kMMC_SendOperationCondition;
-    command.argument     = arg;
-    command.responseType = kCARD_ResponseTypeR3;
+    command.index = (uint32_t)kSDMMC_SendStatus;
+    if ((card->extendedCsd.hpiFeature & MMC_HPI_FEATURE_CMD12_MASK) != 0U)
+    {
+        command.index = (uint32_t)kSDMMC_StopTransmission;
+    }
+    command.argument     = (card->relativeAddress << 16U) | MMC_HPI_ARGUMENT_MASK;
+    command.responseType = kCARD_ResponseTypeR1;
 
     content.command = &command;
     content.data    = NULL;
-    do
+    error           = SDMMCHOST_TransferFunction(card->host, &content);
+    if (kStatus_Success != error)
     {
-        error = SDMMCHOST_TransferFunction(card->host, &content);
-
-        if (error == kStatus_Success)
-        {
-            /* record OCR register */
-            card->ocr = command.response[0U];
+        return kStatus_SDMMC_TransferFailed;
+    }
 
-            if ((arg == 0U) && (command.response[0U] != 0U))
-            {
-                error = kStatus_Success;
-            }
-            /* Repeat CMD1 until the busy bit is cleared. */
-            else if (0U == (command.response[0U] & MMC_OCR_BUSY_MASK))
-            {
-                error = kStatus_Timeout;
-            }
-            else
-            {
-                error = kStatus_Success;
-                if (((card->ocr & MMC_OCR_ACCESS_MODE_MASK) >> MMC_OCR_ACCESS_MODE_SHIFT) ==
-                    (uint32_t)kMMC_AccessModeSector)
-                {
-                    card->flags |= (uint32_t)kMMC_SupportHighCapacityFlag;
-                }
-            }
-        }
+    error = MMC_PollingCardStatusLatency(card, false, timeoutMs == 0U ? MMC_CARD_ACCESS_WAIT_IDLE_TIMEOUT : timeoutMs,
+                                         &card->latencyStatistics.hpiBusy);
+    if (kStatus_SDMMC_CardStatusIdle != error)
+    {
+        return kStatus_SDMMC_PollingCardIdleFailed;
+    }
 
-        SDMMC_OSADelay(10U);
+    /* the HPI reaching the card after the operation complete is an illegal command, the error is reported and cleared
+     * by the next command, so the card status is read once here */
+    error = MMC_SendStatus(card, &status);
+    if (kStatus_Success != error)
+    {
+        return kStatus_SDMMC_TransferFailed;
+    }
 
-    } while ((0U != i--) && (error != kStatus_Success));
+    if (card->isBkopsRunning)
+    {
+        card->isBkopsRunning = false;
+        card->latencyStatistics.bkopsInterrupted++;
+    }
 
-    return error;
+    return kStatus_Success;
+}
+
+static void MMC_InterruptBackgroundOperation(mmc_card_t *card)
+{
+    if (!card->isBkopsRunning)
+    {
+        return;
+    }
+
+    if (SDMMCHOST_IsCardBusy(card->host) && (card->extendedCsd.hpiManagementEn == MMC_HPI_MANAGEMENT_ENABLE))
+    {
+        if (MMC_HighPriorityInterrupt(card) != kStatus_Success)
+        {
+            SDMMC_LOG("\r\nWarning: background operations interrupt failed.");
+        }
+    }
+
+    /* the request waits for the background operations if they are not interrupted */
+    card->isBkopsRunning = false;
+}
+
+static bool MMC_WriteYield(mmc_card_t *card, bool interruptProgram)
+{
+    bool isInterrupted = false;
+
+    if (card->pendingReads == 0U)
+    {
+        return false;
+    }
+
+    /* HPI is illegal in command queue mode */
+    if (interruptProgram && (card->extendedCsd.hpiManagementEn == MMC_HPI_MANAGEMENT_ENABLE) &&
+        (card->extendedCsd.cmdqModeEnable != MMC_CMDQ_MODE_ENABLE) && SDMMCHOST_IsCardBusy(card->host))
+    {
+        isInterrupted = MMC_HighPriorityInterrupt(card) == kStatus_Success;
+    }
+
+    (void)SDMMC_OSAMutexUnlock(&card->lock);
+    SDMMC_WaitPendingReads(&card->pendingReads);
+    (void)SDMMC_OSAMutexLock(&card->lock, osaWaitForever_c);
+
+    card->latencyStatistics.writeYields++;
+
+    return isInterrupted;
+}
+
+static status_t MMC_SendOperationCondition(mmc_card_t *card, uint32_t arg)
+{
+    assert(card != NULL);
+
+    sdmmchost_cmd_t command      = {0};
+    sdmmchost_transfer_t content = {0};
+    status_t error;
+    uint32_t i = MMC_CMD1_RETRY_TIMES;
+
+    /* Send CMD1 with the intended voltage range in the argument(either 0x00FF8000 or 0x00000080) */
+    command.index        = (uint32_t)kMMC_SendOperationCondition;
+    command.argument     = arg;
+    command.responseType = kCARD_ResponseTypeR3;
+
+    content.command = &command;
+    content.data    = NULL;
+    do
+    {
+        error = SDMMCHOST_TransferFunction(card->host, &content);
+
+        if (error == kStatus_Success)
+        {
+            /* record OCR register */
+            card->ocr = command.response[0U];
+
+            if ((arg == 0U) && (command.response[0U] != 0U))
+            {
+                error = kStatus_Success;
+            }
+            /* Repeat CMD1 until the busy bit is cleared. */
+            else if (0U == (command.response[0U] & MMC_OCR_BUSY_MASK))
+            {
+                error = kStatus_Timeout;
+            }
+            else
+            {
+                error = kStatus_Success;
+                if (((card->ocr & MMC_OCR_ACCESS_MODE_MASK) >> MMC_OCR_ACCESS_MODE_SHIFT) ==
+                    (uint32_t)kMMC_AccessModeSector)
+                {
+                    card->flags |= (uint32_t)kMMC_SupportHighCapacityFlag;
+                }
+            }
+        }
+
+        SDMMC_OSADelay(10U);
+
+    } while ((0U != i--) && (error != kStatus_Success));
+
+    return error;
 }
 
 static status_t MMC_SetRelativeAddress(mmc_card_t *card)
@@ -919,6 +1423,8 @@ static void MMC_DecodeExtendedCsd(mmc_card_t *card, uint32_t *rawExtendedCsd)
     mmc_extended_csd_t *extendedCsd = &(card->extendedCsd);
 
     /* Extended CSD is transferred as a data block from least byte indexed 0. */
+    extendedCsd->writeReliabilityParameter = buffer[166U];
+
     extendedCsd->bootPartitionWP                 = buffer[173U];
     extendedCsd->bootWPStatus                    = buffer[174U];
     extendedCsd->highDensityEraseGroupDefinition = buffer[175U];
@@ -1008,6 +1514,45 @@ static void MMC_DecodeExtendedCsd(mmc_card_t *card, uint32_t *rawExtendedCsd)
 
     extendedCsd->genericCMD6Timeout  = buffer[248U] * 10UL;
     extendedCsd->supportedCommandSet = buffer[504U];
+
+    /* trim and discard */
+    extendedCsd->secureTrimMultiplier  = buffer[229U];
+    extendedCsd->secureEraseMultiplier = buffer[230U];
+    extendedCsd->secureFeatureSupport  = buffer[231U];
+    extendedCsd->trimMultiplier        = buffer[232U];
+    extendedCsd->optimalTrimSize       = buffer[264U];
+
+    /* packed command */
+    extendedCsd->packedCmdFailIndex = buffer[35U];
+    extendedCsd->packedCmdStatus    = buffer[36U];
+    extendedCsd->maxPackedWriteCmd  = buffer[500U];
+    extendedCsd->maxPackedReadCmd   = buffer[501U];
+
+    /* command queue */
+    extendedCsd->cmdqModeEnable = buffer[15U];
+    extendedCsd->cmdqDepth      = buffer[307U];
+    extendedCsd->cmdqSupport    = buffer[308U];
+    if ((extendedCsd->cmdqSupport & 0x1U) != 0U)
+    {
+        card->flags |= (uint32_t)kMMC_SupportCommandQueueFlag;
+        card->cmdqDepth = ((uint32_t)extendedCsd->cmdqDepth & MMC_CMDQ_DEPTH_MASK) + 1U;
+    }
+
+    /* background operations and high priority interrupt */
+    extendedCsd->hpiManagementEn          = buffer[161U];
+    extendedCsd->bkOpsEnable              = buffer[163U];
+    extendedCsd->outOfInterruptBusyTiming = buffer[198U];
+    extendedCsd->bkOpsStatus              = buffer[246U];
+    extendedCsd->bkOpsSupport             = buffer[502U];
+    extendedCsd->hpiFeature               = buffer[503U];
+    if ((extendedCsd->bkOpsSupport & MMC_BKOPS_SUPPORT_MASK) != 0U)
+    {
+        card->flags |= (uint32_t)kMMC_SupportBackgroundOperationFlag;
+    }
+    if ((extendedCsd->hpiFeature & MMC_HPI_FEATURE_SUPPORT_MASK) != 0U)
+    {
+        card->flags |= (uint32_t)kMMC_SupportHighPriorityInterruptFlag;
+    }
 }
 
 static status_t MMC_SendExtendedCsd(mmc_card_t *card, uint8_t *targetAddr, uint32_t byteIndex)
@@ -1108,7 +1653,8 @@ static status_t MMC_SetPowerClass(mmc_card_t *card)
                     /* intentional empty */
                 }
             }
-            else if (card->busTiming == kMMC_HighSpeed400Timing)
+            else if ((card->busTiming == kMMC_HighSpeed400Timing) ||
+                     (card->busTiming == kMMC_EnhanceHighSpeed400Timing))
             {
                 powerClass = ((card->extendedCsd.powerClass200MHZDDR360V) & mask);
             }
@@ -1248,6 +1794,14 @@ static status_t MMC_TestDataBusWidth(mmc_card_t *card, mmc_data_bus_width_t widt
     uint32_t *tempPattern    = (uint32_t *)FSL_SDMMC_CARD_INTERNAL_BUFFER_ALIGN_ADDR(card->internalBuffer);
     uint32_t xorMask         = 0U;
     uint32_t xorResult       = 0U;
+    uint32_t widthMask       = MMC_REGISTER_SNAPSHOT_BUS_WIDTH(width);
+
+    /* the bus width passed the test in the init which fills the snapshot */
+    if (((card->flags & (uint32_t)kMMC_RegisterSnapshotRestoredFlag) != 0U) &&
+        ((card->registerSnapshot->busWidthMask & widthMask) != 0U))
+    {
+        return kStatus_Success;
+    }
 
     /* For 8 data lines the data block would be (MSB to LSB): 0x0000_0000_0000_AA55,
     For 4 data lines the data block would be (MSB to LSB): 0x0000_005A,
@@ -1294,9 +1848,25 @@ static status_t MMC_TestDataBusWidth(mmc_card_t *card, mmc_data_bus_width_t widt
         return kStatus_Fail;
     }
 
+    if ((card->registerSnapshot != NULL) && ((card->flags & (uint32_t)kMMC_RegisterSnapshotRestoredFlag) == 0U))
+    {
+        card->registerSnapshot->busWidthMask |= widthMask;
+    }
+
     return kStatus_Success;
 }
 
+static void MMC_UpdateSnapshotRegister(mmc_register_snapshot_t *snapshot,
+                                       uint32_t *snapshotRegister,
+                                       const uint8_t *rawRegister)
+{
+    if (memcmp(snapshotRegister, rawRegister, 16U) != 0)
+    {
+        snapshot->magic = 0U;
+        (void)memcpy(snapshotRegister, rawRegister, 16U);
+    }
+}
+
 static status_t MMC_SetDataBusWidth(mmc_card_t *card, mmc_data_bus_width_t width)
 {
     assert(card != NULL);
@@ -1567,19 +2137,11 @@ static status_t MMC_SwitchToHS200(mmc_card_t *card, uint32_t freq)
     return kStatus_Success;
 }
 
-static status_t MMC_SwitchToHS400(mmc_card_t *card)
+static uint32_t MMC_GetHS400Freq(mmc_card_t *card)
 {
     assert(card != NULL);
 
-    uint32_t status    = 0U;
     uint32_t hs400Freq = FSL_SDMMC_CARD_MAX_BUS_FREQ(card->usrParam.maxFreq, MMC_CLOCK_HS400);
-    status_t error     = kStatus_Fail;
-
-    if ((card->hostVoltageWindowVCCQ != kMMC_VoltageWindow170to195) &&
-        (card->hostVoltageWindowVCCQ != kMMC_VoltageWindow120))
-    {
-        return kStatus_SDMMC_InvalidVoltage;
-    }
 
     if (card->host->hostController.sourceClock_Hz < MMC_CLOCK_HS400)
     {
@@ -1592,6 +2154,24 @@ static status_t MMC_SwitchToHS400(mmc_card_t *card)
         hs400Freq = card->host->hostController.sourceClock_Hz /
                     (card->host->hostController.sourceClock_Hz / MMC_CLOCK_HS400 + 1U);
     }
+
+    return hs400Freq;
+}
+
+static status_t MMC_SwitchToHS400(mmc_card_t *card)
+{
+    assert(card != NULL);
+
+    uint32_t status    = 0U;
+    uint32_t hs400Freq = MMC_GetHS400Freq(card);
+    status_t error     = kStatus_Fail;
+
+    if ((card->hostVoltageWindowVCCQ != kMMC_VoltageWindow170to195) &&
+        (card->hostVoltageWindowVCCQ != kMMC_VoltageWindow120))
+    {
+        return kStatus_SDMMC_InvalidVoltage;
+    }
+
     /* HS400 mode support 8 bit data bus only */
     card->busWidth = kMMC_DataBusWidth8bit;
     /* switch to HS200 perform tuning */
@@ -1667,6 +2247,68 @@ static status_t MMC_SwitchToHS400(mmc_card_t *card)
     return kStatus_Success;
 }
 
+static status_t MMC_SwitchToHS400EnhancedStrobe(mmc_card_t *card)
+{
+    assert(card != NULL);
+
+    uint32_t hs400Freq = MMC_GetHS400Freq(card);
+
+    if ((card->hostVoltageWindowVCCQ != kMMC_VoltageWindow170to195) &&
+        (card->hostVoltageWindowVCCQ != kMMC_VoltageWindow120))
+    {
+        return kStatus_SDMMC_InvalidVoltage;
+    }
+
+    /* switch to high speed first */
+    if (kStatus_Success != MMC_SwitchHSTiming(card, (uint8_t)kMMC_HighSpeedTiming, kMMC_DriverStrength0))
+    {
+        return kStatus_SDMMC_ConfigureExtendedCsdFailed;
+    }
+
+    card->busClock_Hz = SDMMCHOST_SetCardClock(card->host, MMC_CLOCK_52MHZ);
+    /* config io strength */
+    if (card->usrParam.ioStrength != NULL)
+    {
+        card->usrParam.ioStrength(MMC_CLOCK_52MHZ);
+    }
+
+    /* HS400 mode support 8 bit data bus only, the bus is tested in SDR mode since there is no HS200 tuning */
+    SDMMCHOST_SetCardBusWidth(card->host, kSDMMC_BusWdith8Bit);
+    if (kStatus_Success != MMC_TestDataBusWidth(card, kMMC_DataBusWidth8bit))
+    {
+        return kStatus_SDMMC_SetDataBusWidthFailed;
+    }
+    card->busWidth  = kMMC_DataBusWidth8bit;
+    card->busTiming = kMMC_EnhanceHighSpeed400Timing;
+
+    /* switch to 8 bit DDR data bus width with enhanced strobe */
+    if (kStatus_Success != MMC_SetDataBusWidth(card, kMMC_DataBusWidth8bitDDRSTROBE))
+    {
+        return kStatus_SDMMC_SetDataBusWidthFailed;
+    }
+    /* switch to HS400 */
+    if (kStatus_Success != MMC_SwitchHSTiming(card, (uint8_t)kMMC_HighSpeed400Timing, kMMC_DriverStrength0))
+    {
+        return kStatus_SDMMC_SwitchBusTimingFailed;
+    }
+    /* config to target freq */
+    card->busClock_Hz = SDMMCHOST_SetCardClock(card->host, hs400Freq / 2U);
+    /* config io speed and strength */
+    if (card->usrParam.ioStrength != NULL)
+    {
+        card->usrParam.ioStrength(MMC_CLOCK_HS200);
+    }
+    /* enable HS400 mode, both command response and data are sampled by the strobe */
+    SDMMCHOST_EnableHS400Mode(card->host, true);
+    SDMMCHOST_EnableHS400EnhancedStrobe(card->host, true);
+    /* enable DDR mode */
+    SDMMCHOST_EnableDDRMode(card->host, true, 0U);
+    /* config strobe DLL*/
+    SDMMCHOST_EnableStrobeDll(card->host, true);
+
+    return kStatus_Success;
+}
+
 static status_t MMC_SelectBusTiming(mmc_card_t *card)
 {
     assert(card != NULL);
@@ -1682,13 +2324,33 @@ static status_t MMC_SelectBusTiming(mmc_card_t *card)
     {
         if (card->busTiming == kMMC_HighSpeedTimingNone)
         {
-            /* if timing not specified, probe card capability from HS400 mode */
-            card->busTiming = kMMC_HighSpeed400Timing;
+            /* if timing not specified, probe card capability from HS400 enhanced strobe mode */
+            card->busTiming = kMMC_EnhanceHighSpeed400Timing;
         }
 
         if (card->busTiming == kMMC_EnhanceHighSpeed400Timing)
         {
-            return kStatus_SDMMC_NotSupportYet;
+            if (((card->host->capability &
+                  ((uint32_t)kSDMMCHOST_SupportHS400 | (uint32_t)kSDMMCHOST_SupportHS400EnhancedStrobe |
+                   (uint32_t)kSDMMCHOST_Support8BitDataWidth)) ==
+                 ((uint32_t)kSDMMCHOST_SupportHS400 | (uint32_t)kSDMMCHOST_SupportHS400EnhancedStrobe |
+                  (uint32_t)kSDMMCHOST_Support8BitDataWidth)) &&
+                ((card->usrParam.capability & (uint32_t)kSDMMC_Support8BitWidth) != 0U) &&
+                ((card->hostVoltageWindowVCCQ == kMMC_VoltageWindow170to195) ||
+                 (card->hostVoltageWindowVCCQ == kMMC_VoltageWindow120)) &&
+                ((card->flags & (uint32_t)kMMC_SupportEnhanceHS400StrobeFlag) != 0U) &&
+                ((card->flags &
+                  ((uint32_t)kMMC_SupportHS400DDR200MHZ180VFlag | (uint32_t)kMMC_SupportHS400DDR200MHZ120VFlag)) != 0U))
+            {
+                /* switch to HS400 enhanced strobe */
+                if (kStatus_Success != MMC_SwitchToHS400EnhancedStrobe(card))
+                {
+                    return kStatus_SDMMC_SwitchBusTimingFailed;
+                }
+                break;
+            }
+
+            card->busTiming = kMMC_HighSpeed400Timing;
         }
 
         if (card->busTiming == kMMC_HighSpeed400Timing)
@@ -1785,6 +2447,7 @@ static status_t MMC_AllSendCid(mmc_card_t *card)
     if (kStatus_Success == error)
     {
         (void)memcpy(card->internalBuffer, (uint8_t *)command.response, 16U);
+        (void)memcpy(card->host->tuningKey.cardId, (uint8_t *)command.response, 16U);
         MMC_DecodeCid(card, command.response);
 
         return kStatus_Success;
@@ -1918,6 +2581,8 @@ static status_t MMC_Read(
     sdmmchost_cmd_t command      = {0};
     sdmmchost_data_t data        = {0};
     sdmmchost_transfer_t content = {0};
+    mmc_cmdq_task_t task         = {0};
+    uint32_t blockCountArgument  = 0U;
     status_t error;
 
     if ((((card->flags & (uint32_t)kMMC_SupportHighCapacityFlag) != 0U) && (blockSize != 512U)) ||
@@ -1926,12 +2591,40 @@ static status_t MMC_Read(
         return kStatus_SDMMC_CardNotSupport;
     }
 
-    error = MMC_PollingCardStatusBusy(card, true, MMC_CARD_ACCESS_WAIT_IDLE_TIMEOUT);
-    if (kStatus_SDMMC_CardStatusIdle != error)
+    /* CMD17/CMD18 is illegal in command queue mode */
+    if (card->extendedCsd.cmdqModeEnable == MMC_CMDQ_MODE_ENABLE)
     {
-        SDMMC_LOG("Error : read failed with wrong card status\r\n");
-        return kStatus_SDMMC_PollingCardIdleFailed;
+        task.buffer     = buffer;
+        task.startBlock = startBlock;
+        task.blockCount = blockCount;
+        task.isWrite    = false;
+
+        return MMC_CommandQueueExecute(card, &task, 1U);
+    }
+
+    MMC_InterruptBackgroundOperation(card);
+
+    /* the card cannot enter programming state by read, so the CMD13 polling is skipped when no other command is sent
+     * since the last read and DAT0 is not busy */
+    if ((!card->isReadIdle) || (card->readIdleSequence != card->host->transferSequence) ||
+        SDMMCHOST_IsCardBusy(card->host))
+    {
+        error = MMC_PollingCardStatusLatency(card, true, MMC_CARD_ACCESS_WAIT_IDLE_TIMEOUT,
+                                             &card->latencyStatistics.readBusy);
+        if (kStatus_SDMMC_CardStatusIdle != error)
+        {
+            SDMMC_LOG("Error : read failed with wrong card status\r\n");
+            return kStatus_SDMMC_PollingCardIdleFailed;
+        }
     }
+    else
+    {
+        SDMMC_LatencyHistogramRecord(&card->latencyStatistics.readBusy, 0U);
+    }
+    card->isReadIdle = false;
+
+    MMC_BusGovernorApply(card);
+    MMC_ScheduleReTuning(card);
 
     data.blockSize           = blockSize;
     data.blockCount          = blockCount;
@@ -1948,10 +2641,7 @@ static status_t MMC_Read(
         {
             data.enableAutoCommand12 = false;
             /* If enabled the pre-define count read/write feature of the card, need to set block count firstly. */
-            if (kStatus_Success != MMC_SetBlockCount(card, blockCount))
-            {
-                return kStatus_SDMMC_SetBlockCountFailed;
-            }
+            blockCountArgument = blockCount;
         }
     }
     command.argument = startBlock;
@@ -1966,7 +2656,7 @@ static status_t MMC_Read(
     content.data    = &data;
 
     /* should check tuning error during every transfer */
-    error = MMC_Transfer(card, &content, 3U);
+    error = MMC_TransferClosedEnded(card, &content, blockCountArgument, 3U);
     if (kStatus_Success != error)
     {
         return error;
@@ -1982,11 +2672,18 @@ static status_t MMC_Read(
         }
     }
 
+    card->isReadIdle       = true;
+    card->readIdleSequence = card->host->transferSequence;
+
     return kStatus_Success;
 }
 
-static status_t MMC_Write(
-    mmc_card_t *card, const uint8_t *buffer, uint32_t startBlock, uint32_t blockSize, uint32_t blockCount)
+static status_t MMC_Write(mmc_card_t *card,
+                          const uint8_t *buffer,
+                          uint32_t startBlock,
+                          uint32_t blockSize,
+                          uint32_t blockCount,
+                          uint32_t blockCountFlags)
 {
     assert(card != NULL);
     assert(buffer != NULL);
@@ -1997,6 +2694,9 @@ static status_t MMC_Write(
     sdmmchost_cmd_t command      = {0};
     sdmmchost_data_t data        = {0};
     sdmmchost_transfer_t content = {0};
+    mmc_cmdq_task_t task         = {0};
+    bool closedEnded             = card->enablePreDefinedBlockCount || (blockCountFlags != 0U);
+    uint32_t blockCountArgument  = 0U;
     status_t error;
 
     /* Check address range */
@@ -2006,34 +2706,51 @@ static status_t MMC_Write(
         return kStatus_SDMMC_CardNotSupport;
     }
 
+    /* CMD24/CMD25 is illegal in command queue mode */
+    if (card->extendedCsd.cmdqModeEnable == MMC_CMDQ_MODE_ENABLE)
+    {
+        task.buffer              = (uint8_t *)(uint32_t)buffer;
+        task.startBlock          = startBlock;
+        task.blockCount          = blockCount;
+        task.isWrite             = true;
+        task.isForcedProgramming = (blockCountFlags & MMC_SET_BLOCK_COUNT_FORCED_PROGRAMMING_MASK) != 0U;
+        task.isReliableWrite     = (blockCountFlags & MMC_SET_BLOCK_COUNT_RELIABLE_WRITE_MASK) != 0U;
+
+        return MMC_CommandQueueExecute(card, &task, 1U);
+    }
+
+    MMC_InterruptBackgroundOperation(card);
+
     /* send CMD13 to make sure card is ready for data */
-    error = MMC_PollingCardStatusBusy(card, true, MMC_CARD_ACCESS_WAIT_IDLE_TIMEOUT);
+    error = MMC_PollingCardStatusLatency(card, true, MMC_CARD_ACCESS_WAIT_IDLE_TIMEOUT,
+                                         &card->latencyStatistics.writeBusy);
     if (kStatus_SDMMC_CardStatusIdle != error)
     {
         SDMMC_LOG("Error : write card busy with wrong card status\r\n");
         return kStatus_SDMMC_PollingCardIdleFailed;
     }
 
+    MMC_BusGovernorApply(card);
+    MMC_ScheduleReTuning(card);
+
     data.blockSize           = blockSize;
     data.blockCount          = blockCount;
     data.txData              = (const uint32_t *)(uint32_t)buffer;
     data.enableAutoCommand12 = true;
 
     command.index = (uint32_t)kSDMMC_WriteMultipleBlock;
-    if (data.blockCount == 1U)
+    /* the CMD23 flags only apply to CMD25, so single block write with flags is sent by CMD25 too */
+    if ((data.blockCount == 1U) && (blockCountFlags == 0U))
     {
         command.index = (uint32_t)kSDMMC_WriteSingleBlock;
     }
     else
     {
-        if (card->enablePreDefinedBlockCount)
+        if (closedEnded)
         {
             data.enableAutoCommand12 = false;
             /* If enabled the pre-define count read/write featue of the card, need to set block count firstly */
-            if (kStatus_Success != MMC_SetBlockCount(card, blockCount))
-            {
-                return kStatus_SDMMC_SetBlockCountFailed;
-            }
+            blockCountArgument = blockCountFlags | blockCount;
         }
     }
     command.argument = startBlock;
@@ -2048,7 +2765,7 @@ static status_t MMC_Write(
     content.data    = &data;
 
     /* should check tuning error during every transfer */
-    error = MMC_Transfer(card, &content, 3U);
+    error = MMC_TransferClosedEnded(card, &content, blockCountArgument, 3U);
     if (kStatus_Success != error)
     {
         return error;
@@ -2056,7 +2773,7 @@ static status_t MMC_Write(
 
     /* When host's AUTO_COMMAND12 feature isn't enabled and PRE_DEFINED_COUNT command isn't enabled in multiple
     blocks transmission, sends STOP_TRANSMISSION command. */
-    if ((blockCount > 1U) && (!(data.enableAutoCommand12)) && (!card->enablePreDefinedBlockCount))
+    if ((blockCount > 1U) && (!(data.enableAutoCommand12)) && (!closedEnded))
     {
         if (kStatus_Success != MMC_StopTransmission(card))
         {
@@ -2067,48 +2784,438 @@ static status_t MMC_Write(
     return kStatus_Success;
 }
 
-static status_t MMC_ValidateOperationVoltage(mmc_card_t *card, uint32_t *opcode)
+static status_t MMC_QueueTask(mmc_card_t *card, uint32_t taskId, const mmc_cmdq_task_t *task)
 {
-    status_t status = kStatus_Fail;
+    assert(card != NULL);
+    assert(task != NULL);
 
-    if (card->hostVoltageWindowVCC == kMMC_VoltageWindow170to195)
+    sdmmchost_cmd_t command      = {0};
+    sdmmchost_transfer_t content = {0};
+
+    /* task parameter */
+    command.index    = (uint32_t)kMMC_QueuedTaskParameter;
+    command.argument = (task->blockCount & MMC_CMDQ_BLOCK_COUNT_MASK) |
+                       ((taskId << MMC_CMDQ_TASK_ID_SHIFT) & MMC_CMDQ_TASK_ID_MASK);
+    if (!task->isWrite)
     {
-        if ((card->ocr & MMC_OCR_V170TO195_MASK) != 0U)
-        {
-            *opcode |= MMC_OCR_V170TO195_MASK;
-            status = kStatus_Success;
-        }
+        command.argument |= MMC_CMDQ_DATA_DIRECTION_READ_MASK;
     }
-    else if (card->hostVoltageWindowVCC == kMMC_VoltageWindows270to360)
+    else
     {
-        if ((card->ocr & MMC_OCR_V270TO360_MASK) != 0U)
+        if (task->isForcedProgramming)
         {
-            *opcode |= MMC_OCR_V270TO360_MASK;
-            status = kStatus_Success;
+            command.argument |= MMC_CMDQ_FORCED_PROGRAMMING_MASK;
+        }
+        if (task->isReliableWrite)
+        {
+            command.argument |= MMC_CMDQ_RELIABLE_WRITE_MASK;
         }
     }
-    else
+    if (task->isHighPriority)
     {
-        /* Intentional empty */
+        command.argument |= MMC_CMDQ_PRIORITY_MASK;
     }
+    command.responseType       = kCARD_ResponseTypeR1;
+    command.responseErrorFlags = SDMMC_R1_ALL_ERROR_FLAG;
 
-    return status;
-}
-
-static status_t mmccard_init(mmc_card_t *card)
-{
-    assert(card != NULL);
-    assert((card->hostVoltageWindowVCC != kMMC_VoltageWindowNone) &&
-           (card->hostVoltageWindowVCC != kMMC_VoltageWindow120));
-    assert(card->hostVoltageWindowVCCQ != kMMC_VoltageWindowNone);
+    content.command = &command;
+    content.data    = NULL;
+    if (kStatus_Success != MMC_Transfer(card, &content, 2U))
+    {
+        return kStatus_SDMMC_TransferFailed;
+    }
 
-    uint32_t opcode = 0U;
-    status_t error  = kStatus_Success;
+    /* task start address */
+    command.index    = (uint32_t)kMMC_QueuedTaskAddress;
+    command.argument = task->startBlock;
+    if (0U == (card->flags & (uint32_t)kMMC_SupportHighCapacityFlag))
+    {
+        command.argument *= FSL_SDMMC_DEFAULT_BLOCK_SIZE;
+    }
+    if (kStatus_Success != MMC_Transfer(card, &content, 2U))
+    {
+        return kStatus_SDMMC_TransferFailed;
+    }
+
+    return kStatus_Success;
+}
+
+static status_t MMC_PollingQueueStatus(mmc_card_t *card, uint32_t queuedTasks, uint32_t *readyTasks)
+{
+    assert(card != NULL);
+    assert(readyTasks != NULL);
+
+    sdmmchost_cmd_t command      = {0};
+    sdmmchost_transfer_t content = {0};
+    uint32_t statusTimeoutUs     = MMC_CARD_ACCESS_WAIT_IDLE_TIMEOUT * 1000U;
+
+    /* CMD13 with SQS bit set, the response is the queue status register instead of card status */
+    command.index        = (uint32_t)kSDMMC_SendStatus;
+    command.argument     = (card->relativeAddress << 16U) | MMC_CMDQ_SEND_QUEUE_STATUS_MASK;
+    command.responseType = kCARD_ResponseTypeR1;
+
+    content.command = &command;
+    content.data    = NULL;
+
+    do
+    {
+        if (kStatus_Success != MMC_Transfer(card, &content, 2U))
+        {
+            return kStatus_SDMMC_TransferFailed;
+        }
+
+        *readyTasks = command.response[0U] & queuedTasks;
+        if (*readyTasks != 0U)
+        {
+            return kStatus_Success;
+        }
+
+        /* Delay 125us to throttle the polling rate */
+        statusTimeoutUs -= statusTimeoutUs > 125U ? SDMMC_OSADelayUs(125U) : statusTimeoutUs;
+    } while (statusTimeoutUs != 0U);
+
+    return kStatus_SDMMC_PollingCardIdleFailed;
+}
+
+static status_t MMC_ExecuteTask(mmc_card_t *card, uint32_t taskId, const mmc_cmdq_task_t *task)
+{
+    assert(card != NULL);
+    assert(task != NULL);
+
+    sdmmchost_cmd_t command      = {0};
+    sdmmchost_data_t data        = {0};
+    sdmmchost_transfer_t content = {0};
+
+    /* the previous write task may still be programming */
+    if (kStatus_SDMMC_CardStatusIdle != MMC_PollingCardStatusBusy(card, false, MMC_CARD_ACCESS_WAIT_IDLE_TIMEOUT))
+    {
+        return kStatus_SDMMC_PollingCardIdleFailed;
+    }
+
+    data.blockSize  = FSL_SDMMC_DEFAULT_BLOCK_SIZE;
+    data.blockCount = task->blockCount;
+    /* the transfer length is defined by CMD44, no stop command is needed */
+    data.enableAutoCommand12 = false;
+    if (task->isWrite)
+    {
+        data.txData   = (const uint32_t *)(uint32_t)task->buffer;
+        command.index = (uint32_t)kMMC_ExecuteWriteTask;
+    }
+    else
+    {
+        data.rxData   = (uint32_t *)(uint32_t)task->buffer;
+        command.index = (uint32_t)kMMC_ExecuteReadTask;
+    }
+    command.argument           = (taskId << MMC_CMDQ_TASK_ID_SHIFT) & MMC_CMDQ_TASK_ID_MASK;
+    command.responseType       = kCARD_ResponseTypeR1;
+    command.responseErrorFlags = SDMMC_R1_ALL_ERROR_FLAG;
+
+    content.command = &command;
+    content.data    = &data;
+
+    /* the task is removed from the queue once executed, so it cannot be retried */
+    if (kStatus_Success != SDMMCHOST_TransferFunction(card->host, &content))
+    {
+        return kStatus_SDMMC_TransferFailed;
+    }
+
+    return kStatus_Success;
+}
+
+static status_t MMC_DiscardQueue(mmc_card_t *card)
+{
+    assert(card != NULL);
+
+    sdmmchost_cmd_t command      = {0};
+    sdmmchost_transfer_t content = {0};
+
+    command.index        = (uint32_t)kMMC_CmdqTaskManagement;
+    command.argument     = MMC_CMDQ_DISCARD_ENTIRE_QUEUE;
+    command.responseType = kCARD_ResponseTypeR1b;
+
+    content.command = &command;
+    content.data    = NULL;
+    if (kStatus_Success != MMC_Transfer(card, &content, 1U))
+    {
+        return kStatus_SDMMC_TransferFailed;
+    }
+
+    if (kStatus_SDMMC_CardStatusIdle != MMC_PollingCardStatusBusy(card, false, MMC_CARD_ACCESS_WAIT_IDLE_TIMEOUT))
+    {
+        return kStatus_SDMMC_PollingCardIdleFailed;
+    }
+
+    return kStatus_Success;
+}
+
+static status_t MMC_CommandQueueExecute(mmc_card_t *card, mmc_cmdq_task_t *task, uint32_t taskCount)
+{
+    assert(card != NULL);
+    assert(task != NULL);
+
+    uint32_t slotTask[MMC_CMDQ_MAX_DEPTH]; /* task array index queued in each task ID */
+    uint32_t queuedTasks = 0U;             /* bitmap of the queued task ID */
+    uint32_t readyTasks  = 0U;             /* bitmap of the task ID ready for execution */
+    uint32_t depth       = card->cmdqDepth > MMC_CMDQ_MAX_DEPTH ? MMC_CMDQ_MAX_DEPTH : card->cmdqDepth;
+    uint32_t nextTask    = 0U;
+    uint32_t taskId      = 0U;
+    uint32_t i           = 0U;
+    status_t error       = kStatus_Success;
+
+    for (i = 0U; i < taskCount; i++)
+    {
+        if ((task[i].buffer == NULL) || (task[i].blockCount == 0U) ||
+            (task[i].blockCount > MMC_CMDQ_BLOCK_COUNT_MASK) || (task[i].blockCount > card->host->maxBlockCount) ||
+            (kStatus_Success != MMC_CheckBlockRange(card, task[i].startBlock, task[i].blockCount)))
+        {
+            return kStatus_InvalidArgument;
+        }
+        task[i].status = kStatus_Busy;
+    }
+
+    /* the read after command queue transfer should poll the card status again */
+    card->isReadIdle = false;
+
+    while ((error == kStatus_Success) && ((nextTask < taskCount) || (queuedTasks != 0U)))
+    {
+        /* refill the free task ID */
+        for (taskId = 0U; (taskId < depth) && (nextTask < taskCount); taskId++)
+        {
+            if ((queuedTasks & (1UL << taskId)) == 0U)
+            {
+                error = MMC_QueueTask(card, taskId, &task[nextTask]);
+                if (kStatus_Success != error)
+                {
+                    break;
+                }
+                slotTask[taskId] = nextTask++;
+                queuedTasks |= 1UL << taskId;
+            }
+        }
+
+        if (kStatus_Success == error)
+        {
+            error = MMC_PollingQueueStatus(card, queuedTasks, &readyTasks);
+        }
+
+        /* execute all the ready tasks */
+        for (taskId = 0U; (kStatus_Success == error) && (taskId < depth); taskId++)
+        {
+            if ((readyTasks & (1UL << taskId)) != 0U)
+            {
+                error = MMC_ExecuteTask(card, taskId, &task[slotTask[taskId]]);
+                task[slotTask[taskId]].status = error;
+                queuedTasks &= ~(1UL << taskId);
+            }
+        }
+    }
+
+    if (kStatus_Success != error)
+    {
+        SDMMC_LOG("\r\nError: command queue transfer failed %d.", error);
+        if (queuedTasks != 0U)
+        {
+            (void)MMC_DiscardQueue(card);
+        }
+
+        for (i = 0U; i < taskCount; i++)
+        {
+            if (task[i].status == kStatus_Busy)
+            {
+                task[i].status = error;
+            }
+        }
+    }
+
+    return error;
+}
+
+static status_t MMC_BuildPackedHeader(mmc_card_t *card,
+                                      mmc_packed_entry_t *entry,
+                                      uint32_t entryCount,
+                                      uint8_t *packedBuffer,
+                                      uint32_t packedBufferSize,
+                                      bool isWrite,
+                                      uint32_t *dataBlocks)
+{
+    uint32_t maxEntry = isWrite ? card->extendedCsd.maxPackedWriteCmd : card->extendedCsd.maxPackedReadCmd;
+    uint32_t address  = 0U;
+    uint32_t i        = 0U;
+    uint8_t *header   = packedBuffer;
+
+    /* packed command is supported since MMC4.5, CMD25/CMD18 is illegal in command queue mode */
+    if ((card->extendedCsd.extendecCsdVersion < (uint8_t)kMMC_ExtendedCsdRevision16) || (maxEntry == 0U) ||
+        (card->extendedCsd.cmdqModeEnable == MMC_CMDQ_MODE_ENABLE))
+    {
+        return kStatus_SDMMC_NotSupportYet;
+    }
+
+    /* each entry takes 8 bytes after the 8 bytes header in one block */
+    if ((entryCount == 0U) || (entryCount > maxEntry) || (entryCount >= (FSL_SDMMC_DEFAULT_BLOCK_SIZE / 8U)))
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    *dataBlocks = 0U;
+    (void)memset(header, 0, FSL_SDMMC_DEFAULT_BLOCK_SIZE);
+    header[0U] = MMC_PACKED_COMMAND_VERSION;
+    header[1U] = isWrite ? MMC_PACKED_COMMAND_WRITE : MMC_PACKED_COMMAND_READ;
+    header[2U] = (uint8_t)entryCount;
+
+    for (i = 0U; i < entryCount; i++)
+    {
+        if ((entry[i].buffer == NULL) || (entry[i].blockCount == 0U) ||
+            (kStatus_Success != MMC_CheckBlockRange(card, entry[i].startBlock, entry[i].blockCount)))
+        {
+            return kStatus_InvalidArgument;
+        }
+
+        address = entry[i].startBlock;
+        if (0U == (card->flags & (uint32_t)kMMC_SupportHighCapacityFlag))
+        {
+            address *= FSL_SDMMC_DEFAULT_BLOCK_SIZE;
+        }
+
+        /* CMD23 argument and CMD25/CMD18 argument of the entry, little endian */
+        header[8U * (i + 1U)]      = (uint8_t)entry[i].blockCount;
+        header[8U * (i + 1U) + 1U] = (uint8_t)(entry[i].blockCount >> 8U);
+        header[8U * (i + 1U) + 4U] = (uint8_t)address;
+        header[8U * (i + 1U) + 5U] = (uint8_t)(address >> 8U);
+        header[8U * (i + 1U) + 6U] = (uint8_t)(address >> 16U);
+        header[8U * (i + 1U) + 7U] = (uint8_t)(address >> 24U);
+
+        *dataBlocks += entry[i].blockCount;
+        entry[i].status = kStatus_SDMMC_TransferFailed;
+    }
+
+    /* header block and data blocks are transferred in one command */
+    if (((*dataBlocks + 1U) > card->host->maxBlockCount) ||
+        (((*dataBlocks + 1U) * FSL_SDMMC_DEFAULT_BLOCK_SIZE) > packedBufferSize))
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    return kStatus_Success;
+}
+
+static status_t MMC_PackedTransfer(
+    mmc_card_t *card, uint8_t *buffer, uint32_t startBlock, uint32_t blockCount, bool isWrite)
+{
+    sdmmchost_cmd_t command      = {0};
+    sdmmchost_data_t data        = {0};
+    sdmmchost_transfer_t content = {0};
+    status_t error;
+
+    data.blockSize           = FSL_SDMMC_DEFAULT_BLOCK_SIZE;
+    data.blockCount          = blockCount;
+    data.enableAutoCommand12 = false;
+    if (isWrite)
+    {
+        data.txData   = (const uint32_t *)(uint32_t)buffer;
+        command.index = (uint32_t)kSDMMC_WriteMultipleBlock;
+    }
+    else
+    {
+        data.rxData   = (uint32_t *)(uint32_t)buffer;
+        command.index = (uint32_t)kSDMMC_ReadMultipleBlock;
+    }
+    /* the argument is the address of the first packed entry */
+    command.argument = startBlock;
+    if (0U == (card->flags & (uint32_t)kMMC_SupportHighCapacityFlag))
+    {
+        command.argument *= FSL_SDMMC_DEFAULT_BLOCK_SIZE;
+    }
+    command.responseType       = kCARD_ResponseTypeR1;
+    command.responseErrorFlags = SDMMC_R1_ALL_ERROR_FLAG;
+
+    content.command = &command;
+    content.data    = &data;
+
+    /* the packed command is not retried, the packed CMD23 is only sent again after re-tuning */
+    error = MMC_TransferClosedEnded(card, &content, MMC_SET_BLOCK_COUNT_PACKED_MASK | blockCount, 0U);
+    if ((kStatus_Success != error) && (kStatus_SDMMC_SetBlockCountFailed != error))
+    {
+        return kStatus_SDMMC_TransferFailed;
+    }
+
+    return error;
+}
+
+static void MMC_PackedCommandError(mmc_card_t *card, mmc_packed_entry_t *entry, uint32_t entryCount)
+{
+    uint8_t packedStatus = 0U;
+    uint8_t failureIndex = 0U;
+    uint32_t i           = 0U;
+
+    (void)MMC_PollingCardStatusBusy(card, false, MMC_CARD_ACCESS_WAIT_IDLE_TIMEOUT);
+
+    if (kStatus_Success == MMC_SendExtendedCsd(card, &packedStatus, (uint32_t)kMMC_ExtendedCsdIndexPackedCommandStatus))
+    {
+        /* the failure index is 1 based, the entries before it are complete */
+        if ((packedStatus & MMC_PACKED_COMMAND_STATUS_INDEXED_ERROR_MASK) != 0U)
+        {
+            (void)MMC_SendExtendedCsd(card, &failureIndex, (uint32_t)kMMC_ExtendedCsdIndexPackedFailureIndex);
+        }
+    }
+
+    card->extendedCsd.packedCmdStatus    = packedStatus;
+    card->extendedCsd.packedCmdFailIndex = failureIndex;
+
+    SDMMC_LOG("\r\nError: packed command failed, status %x, failure index %d.", packedStatus, failureIndex);
+
+    for (i = 0U; (i + 1U) < failureIndex; i++)
+    {
+        entry[i].status = kStatus_Success;
+    }
+}
+
+static status_t MMC_ValidateOperationVoltage(mmc_card_t *card, uint32_t *opcode)
+{
+    status_t status = kStatus_Fail;
+
+    if (card->hostVoltageWindowVCC == kMMC_VoltageWindow170to195)
+    {
+        if ((card->ocr & MMC_OCR_V170TO195_MASK) != 0U)
+        {
+            *opcode |= MMC_OCR_V170TO195_MASK;
+            status = kStatus_Success;
+        }
+    }
+    else if (card->hostVoltageWindowVCC == kMMC_VoltageWindows270to360)
+    {
+        if ((card->ocr & MMC_OCR_V270TO360_MASK) != 0U)
+        {
+            *opcode |= MMC_OCR_V270TO360_MASK;
+            status = kStatus_Success;
+        }
+    }
+    else
+    {
+        /* Intentional empty */
+    }
+
+    return status;
+}
+
+static status_t mmccard_init(mmc_card_t *card)
+{
+    assert(card != NULL);
+    assert((card->hostVoltageWindowVCC != kMMC_VoltageWindowNone) &&
+           (card->hostVoltageWindowVCC != kMMC_VoltageWindow120));
+    assert(card->hostVoltageWindowVCCQ != kMMC_VoltageWindowNone);
+
+    uint32_t opcode                   = 0U;
+    status_t error                    = kStatus_Success;
+    mmc_register_snapshot_t *snapshot = card->registerSnapshot;
+    bool isRestore                    = false;
 
     if (!card->isHostReady)
     {
         return kStatus_SDMMC_HostNotReady;
     }
+    card->isReadIdle = false;
+    card->cmdqDepth  = 0U;
+    card->flags &= ~(uint32_t)kMMC_RegisterSnapshotRestoredFlag;
     /* set DATA bus width */
     SDMMCHOST_SetCardBusWidth(card->host, kSDMMC_BusWdith1Bit);
     /* Set clock to 400KHz. */
@@ -2153,6 +3260,11 @@ static status_t mmccard_init(mmc_card_t *card)
         return kStatus_SDMMC_AllSendCidFailed;
     }
 
+    if (snapshot != NULL)
+    {
+        MMC_UpdateSnapshotRegister(snapshot, snapshot->rawCid, card->internalBuffer);
+    }
+
     error = MMC_SetRelativeAddress(card);
     /* Set the card relative address */
     if (kStatus_Success != error)
@@ -2167,6 +3279,13 @@ static status_t mmccard_init(mmc_card_t *card)
         return kStatus_SDMMC_SendCsdFailed;
     }
 
+    if (snapshot != NULL)
+    {
+        MMC_UpdateSnapshotRegister(snapshot, snapshot->rawCsd, card->internalBuffer);
+        isRestore =
+            (snapshot->magic == MMC_REGISTER_SNAPSHOT_MAGIC) && (snapshot->driverVersion == FSL_MMC_DRIVER_VERSION);
+    }
+
     /* Set to maximum speed in normal mode. */
     MMC_SetMaxFrequency(card);
 
@@ -2178,11 +3297,34 @@ static status_t mmccard_init(mmc_card_t *card)
         return kStatus_SDMMC_SelectCardFailed;
     }
 
-    /* Get Extended CSD register content. */
-    error = MMC_SendExtendedCsd(card, NULL, 0U);
-    if (kStatus_Success != error)
+    if (isRestore)
     {
-        return kStatus_SDMMC_SendExtendedCsdFailed;
+        /* the same card is initialized before, restore the Extended CSD from the snapshot */
+        card->extendedCsd         = snapshot->extendedCsd;
+        card->userPartitionBlocks = snapshot->userPartitionBlocks;
+        card->bootPartitionBlocks = snapshot->bootPartitionBlocks;
+        card->cmdqDepth           = snapshot->cmdqDepth;
+        card->flags |= snapshot->flags | (uint32_t)kMMC_RegisterSnapshotRestoredFlag;
+    }
+    else
+    {
+        /* Get Extended CSD register content. */
+        error = MMC_SendExtendedCsd(card, NULL, 0U);
+        if (kStatus_Success != error)
+        {
+            return kStatus_SDMMC_SendExtendedCsdFailed;
+        }
+
+        if (snapshot != NULL)
+        {
+            /* save the Extended CSD before it is changed by the following init steps */
+            snapshot->extendedCsd         = card->extendedCsd;
+            snapshot->userPartitionBlocks = card->userPartitionBlocks;
+            snapshot->bootPartitionBlocks = card->bootPartitionBlocks;
+            snapshot->cmdqDepth           = card->cmdqDepth;
+            snapshot->flags               = card->flags & MMC_REGISTER_SNAPSHOT_FLAGS;
+            snapshot->busWidthMask        = 0U;
+        }
     }
 
     error = MMC_SetMaxEraseUnitSize(card);
@@ -2219,6 +3361,12 @@ static status_t mmccard_init(mmc_card_t *card)
     /* Set card default to access non-boot partition */
     card->currentPartition = kMMC_AccessPartitionUserAera;
 
+    if ((snapshot != NULL) && (!isRestore))
+    {
+        snapshot->driverVersion = FSL_MMC_DRIVER_VERSION;
+        snapshot->magic         = MMC_REGISTER_SNAPSHOT_MAGIC;
+    }
+
     return kStatus_Success;
 }
 
@@ -2231,7 +3379,20 @@ status_t MMC_CardInit(mmc_card_t *card)
     (void)SDMMC_OSAMutexCreate(&card->lock);
     (void)SDMMC_OSAMutexLock(&card->lock, osaWaitForever_c);
 
+    (void)memset(&card->reTuningStatistics, 0, sizeof(card->reTuningStatistics));
+    (void)memset(&card->latencyStatistics, 0, sizeof(card->latencyStatistics));
+    card->isBkopsRunning = false;
+    card->pendingReads   = 0U;
+#if SDMMC_ENABLE_INSTRUMENTATION
+    SDMMC_InstrumentReset(&card->instrument);
+#endif
+    SDMMC_BusGovernorReset(&card->busGovernor, 0U);
     error = mmccard_init(card);
+    if ((error == kStatus_Success) && (card->busTiming == kMMC_HighSpeed200Timing))
+    {
+        /* step the bus clock of the tuned timing down on the repeated errors instead of the retry storm */
+        SDMMC_BusGovernorReset(&card->busGovernor, card->busClock_Hz);
+    }
 
     (void)SDMMC_OSAMutexUnlock(&card->lock);
 
@@ -2390,12 +3551,22 @@ status_t MMC_ReadBlocks(mmc_card_t *card, uint8_t *buffer, uint32_t startBlock,
     uint8_t *nextBuffer;
     bool dataAddrAlign   = true;
     uint8_t *alignBuffer = (uint8_t *)FSL_SDMMC_CARD_INTERNAL_BUFFER_ALIGN_ADDR(card->internalBuffer);
+    uint32_t alignBlocks = 1U;
     status_t error       = kStatus_Success;
 
+    /* the latency bounded write yields the lock to the pending read */
+    SDMMC_UpdatePendingReads(&card->pendingReads, true);
     (void)SDMMC_OSAMutexLock(&card->lock, osaWaitForever_c);
+    SDMMC_UpdatePendingReads(&card->pendingReads, false);
 
-    blockLeft = blockCount;
-    blockDone = 0U;
+    if ((card->alignBuffer != NULL) && (card->alignBufferSize >= FSL_SDMMC_DEFAULT_BLOCK_SIZE))
+    {
+        alignBuffer = card->alignBuffer;
+        alignBlocks = card->alignBufferSize / FSL_SDMMC_DEFAULT_BLOCK_SIZE;
+    }
+
+    blockLeft = blockCount;
+    blockDone = 0U;
     error     = MMC_CheckBlockRange(card, startBlock, blockCount);
     if (kStatus_Success != error)
     {
@@ -2408,9 +3579,14 @@ status_t MMC_ReadBlocks(mmc_card_t *card, uint8_t *buffer, uint32_t startBlock,
             nextBuffer = (uint8_t *)((uint32_t)buffer + blockDone * FSL_SDMMC_DEFAULT_BLOCK_SIZE);
             if (!card->noInteralAlign && (!dataAddrAlign || ((((uint32_t)nextBuffer) & (sizeof(uint32_t) - 1U)) != 0U)))
             {
-                blockLeft--;
-                blockCountOneTime = 1U;
-                (void)memset(alignBuffer, 0, FSL_SDMMC_DEFAULT_BLOCK_SIZE);
+                /* transfer as many blocks as the exchange buffer can hold per command */
+                blockCountOneTime = blockLeft > alignBlocks ? alignBlocks : blockLeft;
+                if (blockCountOneTime > card->host->maxBlockCount)
+                {
+                    blockCountOneTime = card->host->maxBlockCount;
+                }
+                blockLeft -= blockCountOneTime;
+                (void)memset(alignBuffer, 0, blockCountOneTime * FSL_SDMMC_DEFAULT_BLOCK_SIZE);
                 dataAddrAlign = false;
             }
             else
@@ -2439,7 +3615,7 @@ status_t MMC_ReadBlocks(mmc_card_t *card, uint8_t *buffer, uint32_t startBlock,
 
             if (!card->noInteralAlign && (!dataAddrAlign))
             {
-                (void)memcpy(nextBuffer, alignBuffer, FSL_SDMMC_DEFAULT_BLOCK_SIZE);
+                (void)memcpy(nextBuffer, alignBuffer, blockCountOneTime * FSL_SDMMC_DEFAULT_BLOCK_SIZE);
             }
         }
     }
@@ -2449,7 +3625,8 @@ status_t MMC_ReadBlocks(mmc_card_t *card, uint8_t *buffer, uint32_t startBlock,
     return error;
 }
 
-status_t MMC_WriteBlocks(mmc_card_t *card, const uint8_t *buffer, uint32_t startBlock, uint32_t blockCount)
+static status_t MMC_WriteBlocksWithFlags(
+    mmc_card_t *card, const uint8_t *buffer, uint32_t startBlock, uint32_t blockCount, uint32_t blockCountFlags)
 {
     assert(card != NULL);
     assert(buffer != NULL);
@@ -2461,10 +3638,32 @@ status_t MMC_WriteBlocks(mmc_card_t *card, const uint8_t *buffer, uint32_t start
     const uint8_t *nextBuffer;
     bool dataAddrAlign   = true;
     uint8_t *alignBuffer = (uint8_t *)FSL_SDMMC_CARD_INTERNAL_BUFFER_ALIGN_ADDR(card->internalBuffer);
+    uint32_t alignBlocks = 1U;
+    uint32_t maxBlocks   = card->host->maxBlockCount;
+    uint32_t chunkBlocks = card->writeChunkBlocks;
+    bool isRewrite       = false;
     status_t error       = kStatus_Success;
 
     (void)SDMMC_OSAMutexLock(&card->lock, osaWaitForever_c);
 
+    if ((card->alignBuffer != NULL) && (card->alignBufferSize >= FSL_SDMMC_DEFAULT_BLOCK_SIZE))
+    {
+        alignBuffer = card->alignBuffer;
+        alignBlocks = card->alignBufferSize / FSL_SDMMC_DEFAULT_BLOCK_SIZE;
+    }
+
+    /* the reliable write is atomic per command, so it is not split into chunks or interrupted by HPI */
+    if ((blockCountFlags & MMC_SET_BLOCK_COUNT_RELIABLE_WRITE_MASK) != 0U)
+    {
+        chunkBlocks = 0U;
+    }
+
+    /* the latency bounded write caps each command at the chunk */
+    if ((chunkBlocks != 0U) && (chunkBlocks < maxBlocks))
+    {
+        maxBlocks = chunkBlocks;
+    }
+
     blockLeft = blockCount;
     blockDone = 0U;
 
@@ -2480,17 +3679,22 @@ status_t MMC_WriteBlocks(mmc_card_t *card, const uint8_t *buffer, uint32_t start
             nextBuffer = (uint8_t *)((uint32_t)buffer + blockDone * FSL_SDMMC_DEFAULT_BLOCK_SIZE);
             if (!card->noInteralAlign && (!dataAddrAlign || (0U != (((uint32_t)nextBuffer) & (sizeof(uint32_t) - 1U)))))
             {
-                blockLeft--;
-                blockCountOneTime = 1U;
-                (void)memcpy(alignBuffer, nextBuffer, FSL_SDMMC_DEFAULT_BLOCK_SIZE);
+                /* transfer as many blocks as the exchange buffer can hold per command */
+                blockCountOneTime = blockLeft > alignBlocks ? alignBlocks : blockLeft;
+                if (blockCountOneTime > maxBlocks)
+                {
+                    blockCountOneTime = maxBlocks;
+                }
+                blockLeft -= blockCountOneTime;
+                (void)memcpy(alignBuffer, nextBuffer, blockCountOneTime * FSL_SDMMC_DEFAULT_BLOCK_SIZE);
                 dataAddrAlign = false;
             }
             else
             {
-                if (blockLeft > card->host->maxBlockCount)
+                if (blockLeft > maxBlocks)
                 {
-                    blockLeft         = (blockLeft - card->host->maxBlockCount);
-                    blockCountOneTime = card->host->maxBlockCount;
+                    blockLeft         = (blockLeft - maxBlocks);
+                    blockCountOneTime = maxBlocks;
                 }
                 else
                 {
@@ -2499,17 +3703,26 @@ status_t MMC_WriteBlocks(mmc_card_t *card, const uint8_t *buffer, uint32_t start
                 }
             }
             error = MMC_Write(card, dataAddrAlign ? nextBuffer : (uint8_t *)alignBuffer, (startBlock + blockDone),
-                              FSL_SDMMC_DEFAULT_BLOCK_SIZE, blockCountOneTime);
+                              FSL_SDMMC_DEFAULT_BLOCK_SIZE, blockCountOneTime, blockCountFlags);
             if (kStatus_Success != error)
             {
                 error = kStatus_SDMMC_TransferFailed;
                 break;
             }
 
+            /* the chunk interrupted by HPI is written again once without interrupt to keep the write going */
+            if ((chunkBlocks != 0U) && (blockLeft != 0U) && MMC_WriteYield(card, !isRewrite))
+            {
+                blockLeft += blockCountOneTime;
+                isRewrite = true;
+                continue;
+            }
+            isRewrite = false;
+
             blockDone += blockCountOneTime;
             if (!card->noInteralAlign && (!dataAddrAlign))
             {
-                (void)memset(alignBuffer, 0, FSL_SDMMC_DEFAULT_BLOCK_SIZE);
+                (void)memset(alignBuffer, 0, blockCountOneTime * FSL_SDMMC_DEFAULT_BLOCK_SIZE);
             }
         }
     }
@@ -2519,6 +3732,127 @@ status_t MMC_WriteBlocks(mmc_card_t *card, const uint8_t *buffer, uint32_t start
     return error;
 }
 
+status_t MMC_WriteBlocks(mmc_card_t *card, const uint8_t *buffer, uint32_t startBlock, uint32_t blockCount)
+{
+    return MMC_WriteBlocksWithFlags(card, buffer, startBlock, blockCount, 0U);
+}
+
+status_t MMC_WriteBlocksForceUnitAccess(mmc_card_t *card,
+                                        const uint8_t *buffer,
+                                        uint32_t startBlock,
+                                        uint32_t blockCount)
+{
+    assert(card != NULL);
+
+    uint32_t blockCountFlags = 0U;
+
+    /* the written data is in the nonvolatile storage when the write complete if the cache is disabled */
+    if ((card->extendedCsd.cacheSize != 0U) && (card->extendedCsd.cacheCtrl == MMC_CACHE_CONTROL_ENABLE))
+    {
+        blockCountFlags = MMC_SET_BLOCK_COUNT_FORCED_PROGRAMMING_MASK;
+    }
+
+    return MMC_WriteBlocksWithFlags(card, buffer, startBlock, blockCount, blockCountFlags);
+}
+
+static uint32_t MMC_GetReliableWriteBlocks(mmc_card_t *card,
+                                           uint32_t startBlock,
+                                           uint32_t blockLeft,
+                                           uint32_t reliableBlocks)
+{
+    uint32_t blockCountOneTime;
+
+    if ((card->extendedCsd.writeReliabilityParameter & MMC_WRITE_RELIABILITY_PARAMETER_EN_REL_WR_MASK) != 0U)
+    {
+        /* enhanced reliable write, any block count within the reliable write sector boundary */
+        blockCountOneTime = reliableBlocks - (startBlock % reliableBlocks);
+    }
+    else
+    {
+        /* legacy reliable write, single block or the aligned reliable write sector count */
+        blockCountOneTime = 1U;
+        if (((startBlock % reliableBlocks) == 0U) && (blockLeft >= reliableBlocks))
+        {
+            blockCountOneTime = reliableBlocks;
+        }
+    }
+
+    return blockCountOneTime > blockLeft ? blockLeft : blockCountOneTime;
+}
+
+status_t MMC_WriteBlocksReliable(mmc_card_t *card, const uint8_t *buffer, uint32_t startBlock, uint32_t blockCount)
+{
+    assert(card != NULL);
+    assert(buffer != NULL);
+    assert(blockCount != 0U);
+
+    uint32_t reliableBlocks = card->extendedCsd.reliableWriteSectorCount;
+    uint32_t maxBlocks      = card->host->maxBlockCount;
+    uint32_t alignBlocks    = 0U;
+    uint32_t blockLeft      = blockCount;
+    uint32_t blockDone      = 0U;
+    uint32_t blockCountOneTime;
+    const uint8_t *nextBuffer;
+    status_t error = kStatus_Success;
+
+    if (kStatus_Success != MMC_CheckBlockRange(card, startBlock, blockCount))
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    if (reliableBlocks == 0U)
+    {
+        reliableBlocks = 1U;
+    }
+
+    /* the unaligned buffer is written through the exchange buffer, at most as many blocks as it holds per command */
+    if (!card->noInteralAlign && ((((uint32_t)buffer) & (sizeof(uint32_t) - 1U)) != 0U))
+    {
+        alignBlocks = 1U;
+        if ((card->alignBuffer != NULL) && (card->alignBufferSize >= FSL_SDMMC_DEFAULT_BLOCK_SIZE))
+        {
+            alignBlocks = card->alignBufferSize / FSL_SDMMC_DEFAULT_BLOCK_SIZE;
+        }
+        if (alignBlocks < maxBlocks)
+        {
+            maxBlocks = alignBlocks;
+        }
+    }
+
+    /* each reliable write unit must be written by one command to be atomic, reject the request before writing any
+     * block if a unit would be split */
+    while (blockLeft != 0U)
+    {
+        blockCountOneTime = MMC_GetReliableWriteBlocks(card, startBlock + blockDone, blockLeft, reliableBlocks);
+        if (blockCountOneTime > maxBlocks)
+        {
+            return kStatus_InvalidArgument;
+        }
+        blockDone += blockCountOneTime;
+        blockLeft -= blockCountOneTime;
+    }
+
+    blockLeft = blockCount;
+    blockDone = 0U;
+    while (blockLeft != 0U)
+    {
+        blockCountOneTime = MMC_GetReliableWriteBlocks(card, startBlock + blockDone, blockLeft, reliableBlocks);
+
+        nextBuffer = (const uint8_t *)((uint32_t)buffer + blockDone * FSL_SDMMC_DEFAULT_BLOCK_SIZE);
+        error      = MMC_WriteBlocksWithFlags(card, nextBuffer, startBlock + blockDone, blockCountOneTime,
+                                              MMC_SET_BLOCK_COUNT_RELIABLE_WRITE_MASK);
+        if (kStatus_Success != error)
+        {
+            break;
+        }
+
+        blockDone += blockCountOneTime;
+        blockLeft -= blockCountOneTime;
+    }
+
+    return error;
+}
+
 status_t MMC_EnableCacheControl(mmc_card_t *card, bool enable)
 {
     assert(card != NULL);
@@ -2555,217 +3889,809 @@ status_t MMC_EnableCacheControl(mmc_card_t *card, bool enable)
     return kStatus_Success;
 }
 
+static status_t MMC_Flush(mmc_card_t *card)
+{
+    assert(card != NULL);
+
+    mmc_extended_csd_config_t extendedCsdconfig;
+    status_t error = kStatus_Success;
+
+    /* check the target driver strength support or not */
+    if ((card->extendedCsd.cacheSize == 0U) || (card->extendedCsd.cacheCtrl != MMC_CACHE_CONTROL_ENABLE))
+    {
+        SDMMC_LOG("The cache is not supported or not enabled, please check\r\n");
+        error = kStatus_SDMMC_NotSupportYet;
+    }
+
+    else
+    {
+        /* Switch to high speed timing. */
+        extendedCsdconfig.accessMode = kMMC_ExtendedCsdAccessModeWriteBits;
+        extendedCsdconfig.ByteIndex  = (uint8_t)kMMC_ExtendedCsdIndexFlushCache;
+        extendedCsdconfig.ByteValue  = MMC_CACHE_TRIGGER_FLUSH;
+        extendedCsdconfig.commandSet = kMMC_CommandSetStandard;
+        if (kStatus_Success != MMC_SetExtendedCsdConfig(card, &extendedCsdconfig, 0U))
+        {
+            SDMMC_LOG("cache flush failed\r\n");
+            error = kStatus_SDMMC_ConfigureExtendedCsdFailed;
+        }
+    }
+
+    return error;
+}
+
 status_t MMC_FlushCache(mmc_card_t *card)
 {
     assert(card != NULL);
 
+    status_t error     = kStatus_Success;
+    bool isCmdqEnabled = false;
+
+    (void)SDMMC_OSAMutexLock(&card->lock, osaWaitForever_c);
+
+    /* nothing to flush, the command queue is not switched for it */
+    if ((card->extendedCsd.cacheSize == 0U) || (card->extendedCsd.cacheCtrl != MMC_CACHE_CONTROL_ENABLE))
+    {
+        (void)SDMMC_OSAMutexUnlock(&card->lock);
+        return kStatus_SDMMC_NotSupportYet;
+    }
+
+    /* the flush is a legacy CMD6, so the command queue is disabled around it, the queue is always empty here */
+    isCmdqEnabled = card->extendedCsd.cmdqModeEnable == MMC_CMDQ_MODE_ENABLE;
+    if (isCmdqEnabled)
+    {
+        error = MMC_SwitchCommandQueue(card, false);
+    }
+
+    if (kStatus_Success == error)
+    {
+        error = MMC_Flush(card);
+        if (isCmdqEnabled && (kStatus_Success != MMC_SwitchCommandQueue(card, true)))
+        {
+            error = kStatus_SDMMC_ConfigureExtendedCsdFailed;
+        }
+    }
+
+    (void)SDMMC_OSAMutexUnlock(&card->lock);
+
+    return error;
+}
+
+status_t MMC_SetSleepAwake(mmc_card_t *card, mmc_sleep_awake_t state)
+{
+    assert(card != NULL);
+    status_t error = kStatus_Success;
+
+    sdmmchost_cmd_t command      = {0};
+    sdmmchost_transfer_t content = {0};
+
+    if (card->extendedCsd.extendecCsdVersion <=
+        (uint32_t)kMMC_ExtendedCsdRevision13) /* V4.3 or above version card support boot mode */
+    {
+        return kStatus_SDMMC_NotSupportYet;
+    }
+
+    error = MMC_PollingCardStatusBusy(card, false, MMC_CARD_ACCESS_WAIT_IDLE_TIMEOUT);
+    if (kStatus_SDMMC_CardStatusIdle != error)
+    {
+        return kStatus_SDMMC_PollingCardIdleFailed;
+    }
+
+    /* deselect the card before enter into sleep state */
+    if (state == kMMC_Sleep)
+    {
+        if (MMC_SelectCard(card, false) != kStatus_Success)
+        {
+            return kStatus_SDMMC_DeselectCardFailed;
+        }
+    }
+
+    command.index        = (uint32_t)kMMC_SleepAwake;
+    command.argument     = ((uint32_t)state << 15U) | (card->relativeAddress << 16U);
+    command.responseType = kCARD_ResponseTypeR1b;
+
+    content.command = &command;
+    content.data    = NULL;
+
+    error = MMC_Transfer(card, &content, 0U);
+    if (kStatus_Success != error)
+    {
+        return kStatus_SDMMC_TransferFailed;
+    }
+
+    /* Sleep awake timeout value 100ns * 2^sleepAwakeTimeout */
+    error = MMC_PollingCardStatusBusy(card, false, (1UL << card->extendedCsd.sleepAwakeTimeout) / 10000U);
+    if (kStatus_SDMMC_CardStatusIdle != error)
+    {
+        return kStatus_SDMMC_PollingCardIdleFailed;
+    }
+
+    /* select the card after wake up */
+    if (state == kMMC_Awake)
+    {
+        if (MMC_SelectCard(card, true) != kStatus_Success)
+        {
+            return kStatus_SDMMC_SelectCardFailed;
+        }
+    }
+
+    return kStatus_Success;
+}
+
+static status_t MMC_SwitchCommandQueue(mmc_card_t *card, bool enable)
+{
     mmc_extended_csd_config_t extendedCsdconfig;
+
+    extendedCsdconfig.accessMode = kMMC_ExtendedCsdAccessModeWriteBits;
+    extendedCsdconfig.ByteIndex  = (uint8_t)kMMC_ExtendedCsdIndexCmdqModeEnable;
+    extendedCsdconfig.ByteValue  = enable ? MMC_CMDQ_MODE_ENABLE : 0U;
+    extendedCsdconfig.commandSet = kMMC_CommandSetStandard;
+    if (kStatus_Success != MMC_SetExtendedCsdConfig(card, &extendedCsdconfig, 0U))
+    {
+        SDMMC_LOG("command queue switch failed\r\n");
+        return kStatus_SDMMC_ConfigureExtendedCsdFailed;
+    }
+
+    card->extendedCsd.cmdqModeEnable = extendedCsdconfig.ByteValue;
+
+    return kStatus_Success;
+}
+
+status_t MMC_EnableCommandQueue(mmc_card_t *card, bool enable)
+{
+    assert(card != NULL);
+
+    status_t error = kStatus_Success;
+
+    if ((card->flags & (uint32_t)kMMC_SupportCommandQueueFlag) == 0U)
+    {
+        SDMMC_LOG("The command queue is not supported by the mmc device\r\n");
+        return kStatus_SDMMC_NotSupportYet;
+    }
+
+    (void)SDMMC_OSAMutexLock(&card->lock, osaWaitForever_c);
+
+    error = MMC_SwitchCommandQueue(card, enable);
+
+    (void)SDMMC_OSAMutexUnlock(&card->lock);
+
+    return error;
+}
+
+status_t MMC_CommandQueueTransfer(mmc_card_t *card, mmc_cmdq_task_t *task, uint32_t taskCount)
+{
+    assert(card != NULL);
+    assert(task != NULL);
+    assert(taskCount != 0U);
+
     status_t error = kStatus_Success;
 
-    /* check the target driver strength support or not */
-    if ((card->extendedCsd.cacheSize == 0U) || (card->extendedCsd.cacheCtrl != MMC_CACHE_CONTROL_ENABLE))
+    (void)SDMMC_OSAMutexLock(&card->lock, osaWaitForever_c);
+
+    if (card->extendedCsd.cmdqModeEnable != MMC_CMDQ_MODE_ENABLE)
+    {
+        error = kStatus_SDMMC_NotSupportYet;
+    }
+    else
+    {
+        error = MMC_CommandQueueExecute(card, task, taskCount);
+    }
+
+    (void)SDMMC_OSAMutexUnlock(&card->lock);
+
+    return error;
+}
+
+status_t MMC_PackedWriteBlocks(mmc_card_t *card,
+                               mmc_packed_entry_t *entry,
+                               uint32_t entryCount,
+                               uint8_t *packedBuffer,
+                               uint32_t packedBufferSize)
+{
+    assert(card != NULL);
+    assert(entry != NULL);
+    assert(packedBuffer != NULL);
+
+    uint32_t dataBlocks = 0U;
+    uint32_t offset     = FSL_SDMMC_DEFAULT_BLOCK_SIZE;
+    uint32_t i          = 0U;
+    status_t error      = kStatus_Success;
+
+    (void)SDMMC_OSAMutexLock(&card->lock, osaWaitForever_c);
+
+    error = MMC_BuildPackedHeader(card, entry, entryCount, packedBuffer, packedBufferSize, true, &dataBlocks);
+    if (kStatus_Success == error)
+    {
+        /* the data of the entries follows the header block */
+        for (i = 0U; i < entryCount; i++)
+        {
+            (void)memcpy(&packedBuffer[offset], entry[i].buffer, entry[i].blockCount * FSL_SDMMC_DEFAULT_BLOCK_SIZE);
+            offset += entry[i].blockCount * FSL_SDMMC_DEFAULT_BLOCK_SIZE;
+        }
+
+        if (kStatus_SDMMC_CardStatusIdle != MMC_PollingCardStatusBusy(card, true, MMC_CARD_ACCESS_WAIT_IDLE_TIMEOUT))
+        {
+            error = kStatus_SDMMC_PollingCardIdleFailed;
+        }
+        else
+        {
+            error = MMC_PackedTransfer(card, packedBuffer, entry[0U].startBlock, dataBlocks + 1U, true);
+            /* the individual write failure is reported after programming */
+            if ((kStatus_Success == error) &&
+                (kStatus_SDMMC_CardStatusIdle !=
+                 MMC_PollingCardStatusBusy(card, true, MMC_CARD_ACCESS_WAIT_IDLE_TIMEOUT)))
+            {
+                error = kStatus_SDMMC_TransferFailed;
+            }
+
+            if (kStatus_SDMMC_TransferFailed == error)
+            {
+                MMC_PackedCommandError(card, entry, entryCount);
+            }
+        }
+
+        for (i = 0U; (kStatus_Success == error) && (i < entryCount); i++)
+        {
+            entry[i].status = kStatus_Success;
+        }
+    }
+
+    (void)SDMMC_OSAMutexUnlock(&card->lock);
+
+    return error;
+}
+
+status_t MMC_PackedReadBlocks(mmc_card_t *card,
+                              mmc_packed_entry_t *entry,
+                              uint32_t entryCount,
+                              uint8_t *packedBuffer,
+                              uint32_t packedBufferSize)
+{
+    assert(card != NULL);
+    assert(entry != NULL);
+    assert(packedBuffer != NULL);
+
+    uint32_t dataBlocks = 0U;
+    uint32_t offset     = FSL_SDMMC_DEFAULT_BLOCK_SIZE;
+    uint32_t i          = 0U;
+    status_t error      = kStatus_Success;
+
+    (void)SDMMC_OSAMutexLock(&card->lock, osaWaitForever_c);
+
+    error = MMC_BuildPackedHeader(card, entry, entryCount, packedBuffer, packedBufferSize, false, &dataBlocks);
+    if (kStatus_Success == error)
+    {
+        if (kStatus_SDMMC_CardStatusIdle != MMC_PollingCardStatusBusy(card, true, MMC_CARD_ACCESS_WAIT_IDLE_TIMEOUT))
+        {
+            error = kStatus_SDMMC_PollingCardIdleFailed;
+        }
+        else
+        {
+            /* write the packed command header, then read the data of all the entries */
+            error = MMC_PackedTransfer(card, packedBuffer, entry[0U].startBlock, 1U, true);
+            if (kStatus_Success == error)
+            {
+                error = MMC_PackedTransfer(card, &packedBuffer[FSL_SDMMC_DEFAULT_BLOCK_SIZE], entry[0U].startBlock,
+                                           dataBlocks, false);
+            }
+
+            if (kStatus_SDMMC_TransferFailed == error)
+            {
+                MMC_PackedCommandError(card, entry, entryCount);
+            }
+        }
+
+        for (i = 0U; i < entryCount; i++)
+        {
+            if (kStatus_Success == error)
+            {
+                entry[i].status = kStatus_Success;
+            }
+
+            if (entry[i].status == kStatus_Success)
+            {
+                (void)memcpy(entry[i].buffer, &packedBuffer[offset],
+                             entry[i].blockCount * FSL_SDMMC_DEFAULT_BLOCK_SIZE);
+            }
+            offset += entry[i].blockCount * FSL_SDMMC_DEFAULT_BLOCK_SIZE;
+        }
+    }
+
+    (void)SDMMC_OSAMutexUnlock(&card->lock);
+
+    return error;
+}
+
+static status_t MMC_Erase(mmc_card_t *card, uint32_t startGroupAddress, uint32_t endGroupAddress, uint32_t argument)
+{
+    sdmmchost_cmd_t command      = {0};
+    sdmmchost_transfer_t content = {0};
+    status_t error               = kStatus_Success;
+
+    /* Set the start erase group address */
+    command.index              = (uint32_t)kMMC_EraseGroupStart;
+    command.argument           = startGroupAddress;
+    command.responseType       = kCARD_ResponseTypeR1;
+    command.responseErrorFlags = SDMMC_R1_ALL_ERROR_FLAG;
+
+    content.command = &command;
+    content.data    = NULL;
+    error           = MMC_Transfer(card, &content, 0U);
+    if (kStatus_Success != error)
+    {
+        return kStatus_SDMMC_TransferFailed;
+    }
+
+    /* Set the end erase group address */
+    command.index    = (uint32_t)kMMC_EraseGroupEnd;
+    command.argument = endGroupAddress;
+
+    content.command = &command;
+    content.data    = NULL;
+    error           = MMC_Transfer(card, &content, 0U);
+    if (kStatus_Success != error)
+    {
+        return kStatus_SDMMC_TransferFailed;
+    }
+
+    /* Start the erase process */
+    command.index              = (uint32_t)kSDMMC_Erase;
+    command.argument           = argument;
+    command.responseType       = kCARD_ResponseTypeR1b;
+    command.responseErrorFlags = SDMMC_R1_ALL_ERROR_FLAG;
+
+    content.command = &command;
+    content.data    = NULL;
+    error           = MMC_Transfer(card, &content, 0U);
+    if (kStatus_Success != error)
+    {
+        return kStatus_SDMMC_TransferFailed;
+    }
+
+    return kStatus_Success;
+}
+
+status_t MMC_EraseGroups(mmc_card_t *card, uint32_t startGroup, uint32_t endGroup)
+{
+    assert(card != NULL);
+
+    uint32_t startGroupAddress;
+    uint32_t endGroupAddress;
+    status_t error        = kStatus_Success;
+    uint32_t eraseTimeout = MMC_CARD_ACCESS_WAIT_IDLE_TIMEOUT;
+
+    /* CMD35/CMD36/CMD38 is illegal in command queue mode */
+    if (card->extendedCsd.cmdqModeEnable == MMC_CMDQ_MODE_ENABLE)
+    {
+        return kStatus_SDMMC_NotSupportYet;
+    }
+
+    (void)SDMMC_OSAMutexLock(&card->lock, osaWaitForever_c);
+
+    error = MMC_CheckEraseGroupRange(card, startGroup, endGroup);
+    if (kStatus_Success != error)
+    {
+        error = kStatus_InvalidArgument;
+    }
+    else
+    {
+        error = MMC_PollingCardStatusBusy(card, true, 0U);
+        if (error != kStatus_SDMMC_CardStatusIdle)
+        {
+            error = kStatus_SDMMC_PollingCardIdleFailed;
+        }
+    }
+
+    if (error == kStatus_SDMMC_CardStatusIdle)
+    {
+        /* Calculate the start group address and end group address */
+        startGroupAddress = startGroup;
+        endGroupAddress   = endGroup;
+        if ((card->flags & (uint32_t)kMMC_SupportHighCapacityFlag) != 0U)
+        {
+            /* The implementation of a higher than 2GB of density of memory will not be backwards compatible with the
+            lower densities.First of all the address argument for higher than 2GB of density of memory is changed to
+            be sector address (512B sectors) instead of byte address */
+            startGroupAddress = (startGroupAddress * (card->eraseGroupBlocks));
+            endGroupAddress   = (endGroupAddress * (card->eraseGroupBlocks));
+        }
+        else
+        {
+            /* The address unit is byte when card capacity is lower than 2GB */
+            startGroupAddress = (startGroupAddress * (card->eraseGroupBlocks) * FSL_SDMMC_DEFAULT_BLOCK_SIZE);
+            endGroupAddress   = (endGroupAddress * (card->eraseGroupBlocks) * FSL_SDMMC_DEFAULT_BLOCK_SIZE);
+        }
+
+        error = MMC_Erase(card, startGroupAddress, endGroupAddress, (uint32_t)kMMC_EraseArgument);
+        if (error == kStatus_Success)
+        {
+            if ((0U != (card->flags & (uint32_t)kMMC_SupportHighCapacityFlag)) &&
+                (card->extendedCsd.highCapacityEraseTimeout != 0U))
+            {
+                eraseTimeout =
+                    (uint32_t)card->extendedCsd.highCapacityEraseTimeout * 300U * (endGroup - startGroup + 1U);
+            }
+
+            error = MMC_PollingCardStatusBusy(card, true, eraseTimeout);
+            if (kStatus_SDMMC_CardStatusIdle != error)
+            {
+                error = kStatus_SDMMC_PollingCardIdleFailed;
+            }
+            else
+            {
+                error = kStatus_Success;
+            }
+        }
+    }
+
+    (void)SDMMC_OSAMutexUnlock(&card->lock);
+
+    return error;
+}
+
+static status_t MMC_EraseWriteBlocks(mmc_card_t *card,
+                                     uint32_t startBlock,
+                                     uint32_t blockCount,
+                                     mmc_erase_argument_t argument)
+{
+    uint32_t startAddress = startBlock;
+    uint32_t endAddress   = startBlock + blockCount - 1U;
+    uint32_t eraseTimeout = MMC_CARD_ACCESS_WAIT_IDLE_TIMEOUT;
+    uint32_t eraseGroups  = 0U;
+    status_t error        = kStatus_Success;
+
+    /* discard is supported since MMC4.5, the erase commands are illegal in command queue mode */
+    if (((card->extendedCsd.secureFeatureSupport & MMC_SEC_FEATURE_SUPPORT_GB_CL_EN_MASK) == 0U) ||
+        ((argument == kMMC_DiscardArgument) &&
+         (card->extendedCsd.extendecCsdVersion < (uint8_t)kMMC_ExtendedCsdRevision16)) ||
+        (card->extendedCsd.cmdqModeEnable == MMC_CMDQ_MODE_ENABLE))
+    {
+        return kStatus_SDMMC_NotSupportYet;
+    }
+
+    if ((blockCount == 0U) || (kStatus_Success != MMC_CheckBlockRange(card, startBlock, blockCount)))
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    if (kStatus_SDMMC_CardStatusIdle != MMC_PollingCardStatusBusy(card, true, 0U))
+    {
+        return kStatus_SDMMC_PollingCardIdleFailed;
+    }
+
+    /* trim and discard use the write block address instead of the erase group address */
+    if (0U == (card->flags & (uint32_t)kMMC_SupportHighCapacityFlag))
+    {
+        startAddress *= FSL_SDMMC_DEFAULT_BLOCK_SIZE;
+        endAddress *= FSL_SDMMC_DEFAULT_BLOCK_SIZE;
+    }
+
+    error = MMC_Erase(card, startAddress, endAddress, (uint32_t)argument);
+    if (kStatus_Success != error)
+    {
+        return error;
+    }
+
+    /* trim/discard timeout is 300ms * TRIM_MULT for each erase group touched */
+    if ((card->extendedCsd.trimMultiplier != 0U) && (card->eraseGroupBlocks != 0U))
+    {
+        eraseGroups = ((startBlock + blockCount - 1U) / card->eraseGroupBlocks) -
+                      (startBlock / card->eraseGroupBlocks) + 1U;
+        eraseTimeout = (uint32_t)card->extendedCsd.trimMultiplier * 300U * eraseGroups;
+    }
+
+    if (kStatus_SDMMC_CardStatusIdle != MMC_PollingCardStatusBusy(card, true, eraseTimeout))
+    {
+        return kStatus_SDMMC_PollingCardIdleFailed;
+    }
+
+    return kStatus_Success;
+}
+
+status_t MMC_TrimBlocks(mmc_card_t *card, uint32_t startBlock, uint32_t blockCount)
+{
+    assert(card != NULL);
+
+    status_t error = kStatus_Success;
+
+    (void)SDMMC_OSAMutexLock(&card->lock, osaWaitForever_c);
+
+    error = MMC_EraseWriteBlocks(card, startBlock, blockCount, kMMC_TrimArgument);
+
+    (void)SDMMC_OSAMutexUnlock(&card->lock);
+
+    return error;
+}
+
+status_t MMC_DiscardBlocks(mmc_card_t *card, uint32_t startBlock, uint32_t blockCount)
+{
+    assert(card != NULL);
+
+    status_t error = kStatus_Success;
+
+    (void)SDMMC_OSAMutexLock(&card->lock, osaWaitForever_c);
+
+    error = MMC_EraseWriteBlocks(card, startBlock, blockCount, kMMC_DiscardArgument);
+
+    (void)SDMMC_OSAMutexUnlock(&card->lock);
+
+    return error;
+}
+
+status_t MMC_Sanitize(mmc_card_t *card, uint32_t timeoutMs)
+{
+    assert(card != NULL);
+
+    mmc_extended_csd_config_t extendedCsdconfig;
+    status_t error = kStatus_Success;
+
+    if ((card->extendedCsd.secureFeatureSupport & MMC_SEC_FEATURE_SUPPORT_SANITIZE_MASK) == 0U)
+    {
+        SDMMC_LOG("The sanitize is not supported by the mmc device\r\n");
+        return kStatus_SDMMC_NotSupportYet;
+    }
+
+    /* the sanitize holds the card busy and cannot be queued, it is rejected in command queue mode */
+    if (card->extendedCsd.cmdqModeEnable == MMC_CMDQ_MODE_ENABLE)
+    {
+        return kStatus_SDMMC_NotSupportYet;
+    }
+
+    (void)SDMMC_OSAMutexLock(&card->lock, osaWaitForever_c);
+
+    extendedCsdconfig.accessMode = kMMC_ExtendedCsdAccessModeWriteBits;
+    extendedCsdconfig.ByteIndex  = (uint8_t)kMMC_ExtendedCsdIndexSanitizeStart;
+    extendedCsdconfig.ByteValue  = MMC_SANITIZE_START;
+    extendedCsdconfig.commandSet = kMMC_CommandSetStandard;
+    if (kStatus_Success != MMC_SetExtendedCsdConfig(card, &extendedCsdconfig, timeoutMs))
+    {
+        SDMMC_LOG("sanitize failed\r\n");
+        error = kStatus_SDMMC_ConfigureExtendedCsdFailed;
+    }
+
+    (void)SDMMC_OSAMutexUnlock(&card->lock);
+
+    return error;
+}
+
+status_t MMC_EnableBackgroundOperation(mmc_card_t *card, uint32_t mode)
+{
+    assert(card != NULL);
+
+    mmc_extended_csd_config_t extendedCsdconfig;
+    status_t error = kStatus_Success;
+
+    if (((card->flags & (uint32_t)kMMC_SupportBackgroundOperationFlag) == 0U) ||
+        (((mode & (uint32_t)kMMC_BkopsAuto) != 0U) &&
+         (card->extendedCsd.extendecCsdVersion <= (uint32_t)kMMC_ExtendedCsdRevision17)))
+    {
+        SDMMC_LOG("The background operations are not supported by the mmc device\r\n");
+        return kStatus_SDMMC_NotSupportYet;
+    }
+
+    if (card->extendedCsd.cmdqModeEnable == MMC_CMDQ_MODE_ENABLE)
+    {
+        return kStatus_SDMMC_NotSupportYet;
+    }
+
+    (void)SDMMC_OSAMutexLock(&card->lock, osaWaitForever_c);
+
+    /* the manual enable bit cannot be cleared once set, so only set bits is used */
+    extendedCsdconfig.accessMode = kMMC_ExtendedCsdAccessModeSetBits;
+    extendedCsdconfig.ByteIndex  = (uint8_t)kMMC_ExtendedCsdIndexBkopsEnable;
+    extendedCsdconfig.ByteValue  = (uint8_t)mode;
+    extendedCsdconfig.commandSet = kMMC_CommandSetStandard;
+    if (kStatus_Success != MMC_SetExtendedCsdConfig(card, &extendedCsdconfig, 0U))
     {
-        SDMMC_LOG("The cache is not supported or not enabled, please check\r\n");
-        error = kStatus_SDMMC_NotSupportYet;
+        SDMMC_LOG("background operations enable failed\r\n");
+        error = kStatus_SDMMC_ConfigureExtendedCsdFailed;
     }
     else
     {
-        /* Switch to high speed timing. */
-        extendedCsdconfig.accessMode = kMMC_ExtendedCsdAccessModeWriteBits;
-        extendedCsdconfig.ByteIndex  = (uint8_t)kMMC_ExtendedCsdIndexFlushCache;
-        extendedCsdconfig.ByteValue  = MMC_CACHE_TRIGGER_FLUSH;
-        extendedCsdconfig.commandSet = kMMC_CommandSetStandard;
-        if (kStatus_Success != MMC_SetExtendedCsdConfig(card, &extendedCsdconfig, 0U))
+        card->extendedCsd.bkOpsEnable |= (uint8_t)mode;
+        /* the enable bits are kept by the card after power cycle */
+        if (card->registerSnapshot != NULL)
         {
-            SDMMC_LOG("cache flush failed\r\n");
-            error = kStatus_SDMMC_ConfigureExtendedCsdFailed;
+            card->registerSnapshot->extendedCsd.bkOpsEnable |= (uint8_t)mode;
         }
     }
 
+    (void)SDMMC_OSAMutexUnlock(&card->lock);
+
     return error;
 }
 
-status_t MMC_SetSleepAwake(mmc_card_t *card, mmc_sleep_awake_t state)
+status_t MMC_GetBackgroundOperationStatus(mmc_card_t *card, mmc_bkops_status_t *status)
 {
     assert(card != NULL);
-    status_t error = kStatus_Success;
+    assert(status != NULL);
 
-    sdmmchost_cmd_t command      = {0};
-    sdmmchost_transfer_t content = {0};
+    status_t error = kStatus_Success;
 
-    if (card->extendedCsd.extendecCsdVersion <=
-        (uint32_t)kMMC_ExtendedCsdRevision13) /* V4.3 or above version card support boot mode */
+    if (((card->flags & (uint32_t)kMMC_SupportBackgroundOperationFlag) == 0U) ||
+        (card->extendedCsd.cmdqModeEnable == MMC_CMDQ_MODE_ENABLE))
     {
         return kStatus_SDMMC_NotSupportYet;
     }
 
-    error = MMC_PollingCardStatusBusy(card, false, MMC_CARD_ACCESS_WAIT_IDLE_TIMEOUT);
+    (void)SDMMC_OSAMutexLock(&card->lock, osaWaitForever_c);
+
+    error = MMC_PollingCardStatusBusy(card, true, MMC_CARD_ACCESS_WAIT_IDLE_TIMEOUT);
     if (kStatus_SDMMC_CardStatusIdle != error)
     {
-        return kStatus_SDMMC_PollingCardIdleFailed;
+        error = kStatus_SDMMC_PollingCardIdleFailed;
     }
-
-    /* deselect the card before enter into sleep state */
-    if (state == kMMC_Sleep)
+    else
     {
-        if (MMC_SelectCard(card, false) != kStatus_Success)
-        {
-            return kStatus_SDMMC_DeselectCardFailed;
-        }
+        card->isBkopsRunning = false;
+
+        error   = MMC_SendExtendedCsd(card, &card->extendedCsd.bkOpsStatus, (uint32_t)kMMC_ExtendedCsdIndexBkopsStatus);
+        *status = (mmc_bkops_status_t)(uint32_t)(card->extendedCsd.bkOpsStatus & MMC_BKOPS_STATUS_OUTSTANDING_MASK);
     }
 
-    command.index        = (uint32_t)kMMC_SleepAwake;
-    command.argument     = ((uint32_t)state << 15U) | (card->relativeAddress << 16U);
-    command.responseType = kCARD_ResponseTypeR1b;
+    (void)SDMMC_OSAMutexUnlock(&card->lock);
 
-    content.command = &command;
-    content.data    = NULL;
+    return error;
+}
 
-    error = MMC_Transfer(card, &content, 0U);
-    if (kStatus_Success != error)
+status_t MMC_BackgroundOperationIdle(mmc_card_t *card, mmc_bkops_status_t threshold)
+{
+    assert(card != NULL);
+
+    sdmmchost_transfer_t content = {0};
+    sdmmchost_cmd_t command      = {0};
+    status_t error               = kStatus_Success;
+    uint32_t parameter           = 0U;
+
+    if (((card->extendedCsd.bkOpsEnable & (uint8_t)kMMC_BkopsManual) == 0U) ||
+        (card->extendedCsd.cmdqModeEnable == MMC_CMDQ_MODE_ENABLE))
     {
-        return kStatus_SDMMC_TransferFailed;
+        return kStatus_SDMMC_NotSupportYet;
     }
 
-    /* Sleep awake timeout value 100ns * 2^sleepAwakeTimeout */
-    error = MMC_PollingCardStatusBusy(card, false, (1UL << card->extendedCsd.sleepAwakeTimeout) / 10000U);
-    if (kStatus_SDMMC_CardStatusIdle != error)
+    (void)SDMMC_OSAMutexLock(&card->lock, osaWaitForever_c);
+
+    /* nothing to do while the card is programming or the background operations are running */
+    if (SDMMCHOST_IsCardBusy(card->host))
     {
-        return kStatus_SDMMC_PollingCardIdleFailed;
+        (void)SDMMC_OSAMutexUnlock(&card->lock);
+        return kStatus_Success;
     }
 
-    /* select the card after wake up */
-    if (state == kMMC_Awake)
+    card->isBkopsRunning = false;
+
+    error = MMC_SendExtendedCsd(card, &card->extendedCsd.bkOpsStatus, (uint32_t)kMMC_ExtendedCsdIndexBkopsStatus);
+    if ((kStatus_Success == error) &&
+        ((card->extendedCsd.bkOpsStatus & MMC_BKOPS_STATUS_OUTSTANDING_MASK) >= (uint8_t)threshold))
     {
-        if (MMC_SelectCard(card, true) != kStatus_Success)
+        parameter |= ((uint32_t)kMMC_CommandSetStandard << MMC_SWITCH_COMMAND_SET_SHIFT);
+        parameter |= ((uint32_t)MMC_BKOPS_START << MMC_SWITCH_VALUE_SHIFT);
+        parameter |= ((uint32_t)kMMC_ExtendedCsdIndexBkopsStart << MMC_SWITCH_BYTE_INDEX_SHIFT);
+        parameter |= ((uint32_t)kMMC_ExtendedCsdAccessModeWriteBits << MMC_SWITCH_ACCESS_MODE_SHIFT);
+        command.index    = (uint32_t)kMMC_Switch;
+        command.argument = parameter;
+        /* the busy is not waited, the next request interrupts the background operations by HPI or waits for them */
+        command.responseType       = kCARD_ResponseTypeR1;
+        command.responseErrorFlags = SDMMC_R1_ALL_ERROR_FLAG | SDMMC_MASK(kSDMMC_R1SwitchErrorFlag);
+
+        content.command = &command;
+        content.data    = NULL;
+        error           = MMC_Transfer(card, &content, 2U);
+        if (kStatus_Success != error)
         {
-            return kStatus_SDMMC_SelectCardFailed;
+            SDMMC_LOG("background operations start failed\r\n");
+            error = kStatus_SDMMC_ConfigureExtendedCsdFailed;
+        }
+        else
+        {
+            card->isBkopsRunning = true;
+            card->latencyStatistics.bkopsStarted++;
         }
     }
 
-    return kStatus_Success;
+    (void)SDMMC_OSAMutexUnlock(&card->lock);
+
+    return error;
 }
 
-static status_t MMC_Erase(mmc_card_t *card, uint32_t startGroupAddress, uint32_t endGroupAddress)
+status_t MMC_EnableHighPriorityInterrupt(mmc_card_t *card, bool enable)
 {
-    sdmmchost_cmd_t command      = {0};
-    sdmmchost_transfer_t content = {0};
-    status_t error               = kStatus_Success;
+    assert(card != NULL);
 
-    /* Set the start erase group address */
-    command.index              = (uint32_t)kMMC_EraseGroupStart;
-    command.argument           = startGroupAddress;
-    command.responseType       = kCARD_ResponseTypeR1;
-    command.responseErrorFlags = SDMMC_R1_ALL_ERROR_FLAG;
+    mmc_extended_csd_config_t extendedCsdconfig;
+    status_t error  = kStatus_Success;
+    uint8_t hpiMgmt = enable ? (uint8_t)MMC_HPI_MANAGEMENT_ENABLE : 0U;
 
-    content.command = &command;
-    content.data    = NULL;
-    error           = MMC_Transfer(card, &content, 0U);
-    if (kStatus_Success != error)
+    if ((card->flags & (uint32_t)kMMC_SupportHighPriorityInterruptFlag) == 0U)
     {
-        return kStatus_SDMMC_TransferFailed;
+        SDMMC_LOG("The HPI is not supported by the mmc device\r\n");
+        return kStatus_SDMMC_NotSupportYet;
     }
 
-    /* Set the end erase group address */
-    command.index    = (uint32_t)kMMC_EraseGroupEnd;
-    command.argument = endGroupAddress;
-
-    content.command = &command;
-    content.data    = NULL;
-    error           = MMC_Transfer(card, &content, 0U);
-    if (kStatus_Success != error)
+    if (card->extendedCsd.cmdqModeEnable == MMC_CMDQ_MODE_ENABLE)
     {
-        return kStatus_SDMMC_TransferFailed;
+        return kStatus_SDMMC_NotSupportYet;
     }
 
-    /* Start the erase process */
-    command.index              = (uint32_t)kSDMMC_Erase;
-    command.argument           = 0U;
-    command.responseType       = kCARD_ResponseTypeR1b;
-    command.responseErrorFlags = SDMMC_R1_ALL_ERROR_FLAG;
+    (void)SDMMC_OSAMutexLock(&card->lock, osaWaitForever_c);
 
-    content.command = &command;
-    content.data    = NULL;
-    error           = MMC_Transfer(card, &content, 0U);
-    if (kStatus_Success != error)
+    extendedCsdconfig.accessMode = kMMC_ExtendedCsdAccessModeWriteBits;
+    extendedCsdconfig.ByteIndex  = (uint8_t)kMMC_ExtendedCsdIndexHpiManagement;
+    extendedCsdconfig.ByteValue  = hpiMgmt;
+    extendedCsdconfig.commandSet = kMMC_CommandSetStandard;
+    if (kStatus_Success != MMC_SetExtendedCsdConfig(card, &extendedCsdconfig, 0U))
     {
-        return kStatus_SDMMC_TransferFailed;
+        SDMMC_LOG("HPI enable failed\r\n");
+        error = kStatus_SDMMC_ConfigureExtendedCsdFailed;
+    }
+    else
+    {
+        card->extendedCsd.hpiManagementEn = hpiMgmt;
     }
 
-    return kStatus_Success;
+    (void)SDMMC_OSAMutexUnlock(&card->lock);
+
+    return error;
 }
 
-status_t MMC_EraseGroups(mmc_card_t *card, uint32_t startGroup, uint32_t endGroup)
+status_t MMC_SendHighPriorityInterrupt(mmc_card_t *card)
 {
     assert(card != NULL);
 
-    uint32_t startGroupAddress;
-    uint32_t endGroupAddress;
-    status_t error        = kStatus_Success;
-    uint32_t eraseTimeout = MMC_CARD_ACCESS_WAIT_IDLE_TIMEOUT;
+    status_t error = kStatus_Success;
+
+    if ((card->extendedCsd.hpiManagementEn != MMC_HPI_MANAGEMENT_ENABLE) ||
+        (card->extendedCsd.cmdqModeEnable == MMC_CMDQ_MODE_ENABLE))
+    {
+        return kStatus_SDMMC_NotSupportYet;
+    }
 
     (void)SDMMC_OSAMutexLock(&card->lock, osaWaitForever_c);
 
-    error = MMC_CheckEraseGroupRange(card, startGroup, endGroup);
-    if (kStatus_Success != error)
+    /* HPI is only legal in the programming state */
+    if (SDMMCHOST_IsCardBusy(card->host))
     {
-        error = kStatus_InvalidArgument;
+        error = MMC_HighPriorityInterrupt(card);
     }
     else
     {
-        error = MMC_PollingCardStatusBusy(card, true, 0U);
-        if (error != kStatus_SDMMC_CardStatusIdle)
-        {
-            error = kStatus_SDMMC_PollingCardIdleFailed;
-        }
+        card->isBkopsRunning = false;
     }
 
-    if (error == kStatus_SDMMC_CardStatusIdle)
-    {
-        /* Calculate the start group address and end group address */
-        startGroupAddress = startGroup;
-        endGroupAddress   = endGroup;
-        if ((card->flags & (uint32_t)kMMC_SupportHighCapacityFlag) != 0U)
-        {
-            /* The implementation of a higher than 2GB of density of memory will not be backwards compatible with the
-            lower densities.First of all the address argument for higher than 2GB of density of memory is changed to
-            be sector address (512B sectors) instead of byte address */
-            startGroupAddress = (startGroupAddress * (card->eraseGroupBlocks));
-            endGroupAddress   = (endGroupAddress * (card->eraseGroupBlocks));
-        }
-        else
-        {
-            /* The address unit is byte when card capacity is lower than 2GB */
-            startGroupAddress = (startGroupAddress * (card->eraseGroupBlocks) * FSL_SDMMC_DEFAULT_BLOCK_SIZE);
-            endGroupAddress   = (endGroupAddress * (card->eraseGroupBlocks) * FSL_SDMMC_DEFAULT_BLOCK_SIZE);
-        }
+    (void)SDMMC_OSAMutexUnlock(&card->lock);
 
-        error = MMC_Erase(card, startGroupAddress, endGroupAddress);
-        if (error == kStatus_Success)
-        {
-            if ((0U != (card->flags & (uint32_t)kMMC_SupportHighCapacityFlag)) &&
-                (card->extendedCsd.highCapacityEraseTimeout != 0U))
-            {
-                eraseTimeout =
-                    (uint32_t)card->extendedCsd.highCapacityEraseTimeout * 300U * (endGroup - startGroup + 1U);
-            }
+    return error;
+}
 
-            error = MMC_PollingCardStatusBusy(card, true, eraseTimeout);
-            if (kStatus_SDMMC_CardStatusIdle != error)
-            {
-                error = kStatus_SDMMC_PollingCardIdleFailed;
-            }
-            else
-            {
-                error = kStatus_Success;
-            }
-        }
-    }
+void MMC_ResetLatencyStatistics(mmc_card_t *card)
+{
+    assert(card != NULL);
+
+    (void)SDMMC_OSAMutexLock(&card->lock, osaWaitForever_c);
+    (void)memset(&card->latencyStatistics, 0, sizeof(card->latencyStatistics));
+    (void)SDMMC_OSAMutexUnlock(&card->lock);
+}
+
+#if SDMMC_ENABLE_INSTRUMENTATION
+void MMC_GetInstrumentation(mmc_card_t *card, sdmmc_instrument_t *instrument)
+{
+    assert(card != NULL);
+    assert(instrument != NULL);
 
+    (void)SDMMC_OSAMutexLock(&card->lock, osaWaitForever_c);
+    (void)memcpy(instrument, &card->instrument, sizeof(sdmmc_instrument_t));
     (void)SDMMC_OSAMutexUnlock(&card->lock);
+}
 
-    return error;
+void MMC_ResetInstrumentation(mmc_card_t *card)
+{
+    assert(card != NULL);
+
+    (void)SDMMC_OSAMutexLock(&card->lock, osaWaitForever_c);
+    SDMMC_InstrumentReset(&card->instrument);
+    (void)SDMMC_OSAMutexUnlock(&card->lock);
 }
+#endif
 
 status_t MMC_SetBootConfigWP(mmc_card_t *card, uint8_t wp)
 {
@@ -2782,6 +4708,11 @@ status_t MMC_SetBootConfigWP(mmc_card_t *card, uint8_t wp)
     }
 
     card->extendedCsd.bootConfigProtect = wp;
+    /* the power-on protection is dropped by a power cycle, so the snapshot can not mirror it */
+    if (card->registerSnapshot != NULL)
+    {
+        card->registerSnapshot->magic = 0U;
+    }
 
     return kStatus_Success;
 }
@@ -2801,6 +4732,11 @@ status_t MMC_SetBootPartitionWP(mmc_card_t *card, mmc_boot_partition_wp_t bootPa
     }
 
     card->extendedCsd.bootPartitionWP = (uint8_t)bootPartitionWP;
+    /* the power-on protection is dropped by a power cycle, so the snapshot can not mirror it */
+    if (card->registerSnapshot != NULL)
+    {
+        card->registerSnapshot->magic = 0U;
+    }
 
     return kStatus_Success;
 }
@@ -2837,6 +4773,15 @@ status_t MMC_SetBootConfig(mmc_card_t *card, const mmc_boot_config_t *config)
     }
 
     card->extendedCsd.partitionConfig = bootParameter;
+    /* the boot fields are kept by the card after power cycle, the partition access is not */
+    if (card->registerSnapshot != NULL)
+    {
+        card->registerSnapshot->extendedCsd.partitionConfig &=
+            ~((uint8_t)MMC_PARTITION_CONFIG_BOOT_ACK_MASK | (uint8_t)MMC_PARTITION_CONFIG_PARTITION_ENABLE_MASK);
+        card->registerSnapshot->extendedCsd.partitionConfig |=
+            bootParameter &
+            ((uint8_t)MMC_PARTITION_CONFIG_BOOT_ACK_MASK | (uint8_t)MMC_PARTITION_CONFIG_PARTITION_ENABLE_MASK);
+    }
 
     /* data bus remapping */
     if (bootBusWidth == (uint8_t)kMMC_DataBusWidth1bit)
@@ -2871,6 +4816,10 @@ status_t MMC_SetBootConfig(mmc_card_t *card, const mmc_boot_config_t *config)
     }
 
     card->extendedCsd.bootDataBusConditions = bootParameter;
+    if (card->registerSnapshot != NULL)
+    {
+        card->registerSnapshot->extendedCsd.bootDataBusConditions = bootParameter;
+    }
     /* check and configure the boot config write protect */
     bootParameter = (uint8_t)config->pwrBootConfigProtection | (((uint8_t)config->premBootConfigProtection) << 4U);
     if (bootParameter != (card->extendedCsd.bootConfigProtect))
@@ -2996,3 +4945,87 @@ status_t MMC_StopBoot(mmc_card_t *card, uint32_t bootMode)
 
     return kStatus_Success;
 }
+
+static void MMC_BootStreamChunkComplete(sdmmchost_t *host, status_t status, void *userData)
+{
+    mmc_boot_stream_context_t *context = (mmc_boot_stream_context_t *)userData;
+
+    context->status = status;
+    (void)SDMMC_OSAEventSet(&context->event, MMC_BOOT_STREAM_EVENT_CHUNK_COMPLETE);
+}
+
+status_t MMC_ReadBootStream(mmc_card_t *card,
+                            const mmc_boot_config_t *mmcConfig,
+                            sdmmchost_boot_config_t *hostConfig,
+                            const mmc_boot_stream_t *stream)
+{
+    assert(card != NULL);
+    assert(mmcConfig != NULL);
+    assert(hostConfig != NULL);
+    assert(stream != NULL);
+
+    mmc_boot_stream_context_t context = {0};
+    uint32_t chunkSize                = hostConfig->blockSize * hostConfig->blockCount;
+    uint32_t event                    = 0U;
+    status_t error                    = kStatus_Success;
+    status_t consumerError            = kStatus_Success;
+    uint8_t *chunk                    = NULL;
+    uint32_t i;
+
+    if ((stream->chunkBuffer == NULL) || (stream->chunkBufferCount < 2U) || (stream->chunkCount == 0U) ||
+        (stream->callback == NULL) || (!hostConfig->enableAutoStopAtBlockGap) || (chunkSize == 0U) ||
+        (chunkSize > SDMMCHOST_BOOT_STREAM_MAX_CHUNK_SIZE) ||
+        (card->host->dmaDesBufferWordsNum < SDMMCHOST_BOOT_STREAM_DESCRIPTOR_WORDS(stream->chunkCount)))
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    if (kStatus_Success != SDMMC_OSAEventCreate(&context.event))
+    {
+        return kStatus_Fail;
+    }
+
+    /* the first chunk is received by the boot command */
+    error = MMC_StartBoot(card, mmcConfig, stream->chunkBuffer[0U], hostConfig);
+
+    for (i = 0U; (i < stream->chunkCount) && (error == kStatus_Success); i++)
+    {
+        chunk = stream->chunkBuffer[i % stream->chunkBufferCount];
+
+        /* continue the boot data into the next chunk buffer, it is received while the consumer handles this chunk */
+        if ((i + 1U) < stream->chunkCount)
+        {
+            context.status = kStatus_Success;
+            (void)SDMMC_OSAEventClear(&context.event, MMC_BOOT_STREAM_EVENT_CHUNK_COMPLETE);
+            error = SDMMCHOST_ReadBootDataAsync(card->host, hostConfig,
+                                                stream->chunkBuffer[(i + 1U) % stream->chunkBufferCount],
+                                                MMC_BootStreamChunkComplete, &context);
+            if (kStatus_Success != error)
+            {
+                error = kStatus_SDMMC_TransferFailed;
+                break;
+            }
+        }
+
+        consumerError = stream->callback(chunk, chunkSize, i, stream->userData);
+
+        if ((i + 1U) < stream->chunkCount)
+        {
+            (void)SDMMC_OSAEventWait(&context.event, MMC_BOOT_STREAM_EVENT_CHUNK_COMPLETE, osaWaitForever_c, &event);
+            if (kStatus_Success != context.status)
+            {
+                error = kStatus_SDMMC_TransferFailed;
+            }
+        }
+
+        if (kStatus_Success != consumerError)
+        {
+            error = consumerError;
+        }
+    }
+
+    (void)MMC_StopBoot(card, (uint32_t)mmcConfig->bootMode);
+    (void)SDMMC_OSAEventDestroy(&context.event);
+
+    return error;
+}
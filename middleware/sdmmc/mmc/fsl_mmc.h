@@ -21,7 +21,7 @@
  * Definitions
  ******************************************************************************/
 /*! @brief Middleware mmc version. */
-#define FSL_MMC_DRIVER_VERSION (MAKE_VERSION(2U, 5U, 0U)) /*2.5.0*/
+#define FSL_MMC_DRIVER_VERSION (MAKE_VERSION(2U, 6U, 0U)) /*2.6.0*/
 
 /*! @brief MMC card flags
  * @anchor _mmc_card_flag
@@ -41,6 +41,10 @@ enum
     kMMC_SupportDDRBootFlag                   = (1U << 10U), /*!< support DDR boot flag*/
     kMMC_SupportHighSpeedBootFlag             = (1U << 11U), /*!< support high speed boot flag */
     kMMC_SupportEnhanceHS400StrobeFlag        = (1U << 12U), /*!< support enhance HS400 strobe */
+    kMMC_SupportCommandQueueFlag              = (1U << 13U), /*!< support command queue */
+    kMMC_RegisterSnapshotRestoredFlag         = (1U << 14U), /*!< registers are restored from the register snapshot */
+    kMMC_SupportBackgroundOperationFlag       = (1U << 15U), /*!< support background operations */
+    kMMC_SupportHighPriorityInterruptFlag     = (1U << 16U), /*!< support high priority interrupt */
 };
 
 /*! @brief mmccard sleep/awake state */
@@ -50,6 +54,60 @@ typedef enum _mmc_sleep_awake
     kMMC_Awake = 0U, /*!< MMC card awake */
 } mmc_sleep_awake_t;
 
+/*! @brief mmc command queue task */
+typedef struct _mmc_cmdq_task
+{
+    uint8_t *buffer;          /*!< data buffer, the address should meet the host DMA alignment requirement */
+    uint32_t startBlock;      /*!< start block */
+    uint32_t blockCount;      /*!< block count, should not exceed MMC_CMDQ_BLOCK_COUNT_MASK and host->maxBlockCount */
+    bool isWrite;             /*!< true is write task, false is read task */
+    bool isHighPriority;      /*!< task is marked as high priority to the card */
+    bool isForcedProgramming; /*!< write task bypasses the device cache, ignored for read task */
+    bool isReliableWrite;     /*!< reliable write within the REL_WR_SEC_C boundary, ignored for read task */
+    status_t status;          /*!< task complete status */
+} mmc_cmdq_task_t;
+
+/*! @brief mmc packed command entry */
+typedef struct _mmc_packed_entry
+{
+    uint8_t *buffer;     /*!< data buffer, no alignment requirement since the data is copied to the packed buffer */
+    uint32_t startBlock; /*!< start block */
+    uint32_t blockCount; /*!< block count */
+    status_t status;     /*!< entry complete status */
+} mmc_packed_entry_t;
+
+/*! @brief mmc card register snapshot
+ *
+ * The snapshot holds the decoded register content of the card, it is filled by a full card init and can be saved to
+ * the non-volatile memory as is. The next card init compares the CID and CSD of the card with the snapshot and
+ * restores the extended CSD from the snapshot instead of reading it from the card if they are the same, the data bus
+ * width passed the bus test in the snapshot is selected without the test pattern either.
+ */
+typedef struct _mmc_register_snapshot
+{
+    uint32_t magic;                 /*!< snapshot valid magic, set after a full card init */
+    uint32_t driverVersion;         /*!< driver version which fills the snapshot */
+    uint32_t rawCid[4U];            /*!< raw CID register content */
+    uint32_t rawCsd[4U];            /*!< raw CSD register content */
+    uint32_t flags;                 /*!< card flags decoded from the extended CSD */
+    mmc_extended_csd_t extendedCsd; /*!< Extended CSD */
+    uint32_t userPartitionBlocks;   /*!< Card total block number in user partition */
+    uint32_t bootPartitionBlocks;   /*!< Boot partition size united as block size */
+    uint32_t cmdqDepth;             /*!< command queue depth */
+    uint32_t busWidthMask;          /*!< data bus width passed the bus test, bit n is set for mmc_data_bus_width_t n */
+} mmc_register_snapshot_t;
+
+/*! @brief mmc card background operations and busy latency statistics */
+typedef struct _mmc_latency_statistics
+{
+    uint32_t bkopsStarted;               /*!< manual background operations started by the idle hook */
+    uint32_t bkopsInterrupted;           /*!< manual background operations interrupted by HPI */
+    uint32_t writeYields;                /*!< card lock yielded to the pending read by the latency bounded write */
+    sdmmc_latency_histogram_t readBusy;  /*!< card busy latency before the read command */
+    sdmmc_latency_histogram_t writeBusy; /*!< card busy latency before the write command */
+    sdmmc_latency_histogram_t hpiBusy;   /*!< out of interrupt busy latency after HPI */
+} mmc_latency_statistics_t;
+
 /*! @brief card io strength control */
 typedef void (*mmc_io_strength_t)(uint32_t busFreq);
 
@@ -74,6 +132,9 @@ typedef struct _mmc_card
     bool isHostReady;         /*!< Use this flag to indicate if host re-init needed or not*/
     bool noInteralAlign;      /*!< Use this flag to disable sdmmc align. If disabled, sdmmc will not make sure the
                     data buffer address is word align, otherwise all the transfer are aligned to low level driver. */
+    uint8_t *alignBuffer;     /*!< optional exchange buffer for the unaligned data buffer, the address should meet the
+                                 host DMA and cache line alignment, the internal one block buffer is used if NULL */
+    uint32_t alignBufferSize; /*!< exchange buffer size in byte, multiple blocks are transferred through it at once */
     uint32_t busClock_Hz;     /*!< MMC bus clock united in Hz */
     uint32_t relativeAddress; /*!< Relative address of the card */
     bool enablePreDefinedBlockCount; /*!< Enable PRE-DEFINED block count when read/write */
@@ -93,9 +154,47 @@ typedef struct _mmc_card
     mmc_voltage_window_t hostVoltageWindowVCC;  /*!< application must set this value according to board specific */
     mmc_high_speed_timing_t busTiming;          /*!< indicates the current work timing mode*/
     mmc_data_bus_width_t busWidth;              /*!< indicates the current work bus width */
+    uint32_t cmdqDepth;                         /*!< command queue depth used by the driver */
+    bool isReadIdle;                            /*!< card is known idle after the last read */
+    uint32_t readIdleSequence;                  /*!< host transfer sequence after the last read */
+    mmc_register_snapshot_t *registerSnapshot;  /*!< optional register snapshot for fast init */
     sdmmc_osa_mutex_t lock;                     /*!< card access lock */
+
+    sdmmc_retuning_statistics_t reTuningStatistics; /*!< re-tuning statistics since the card init */
+    sdmmc_bus_governor_t busGovernor;               /*!< bus speed governor of the tuned timing */
+    bool isBkopsRunning;                            /*!< manual background operations started and not stopped */
+    uint32_t writeChunkBlocks;                      /*!< latency bounded write chunk, 0 to write without yielding */
+    volatile uint32_t pendingReads;                 /*!< read requests waiting for the card lock */
+    mmc_latency_statistics_t latencyStatistics;     /*!< busy latency statistics since the card init */
+#if SDMMC_ENABLE_INSTRUMENTATION
+    sdmmc_instrument_t instrument; /*!< transfer instrumentation since the card init */
+#endif
 } mmc_card_t;
 
+/*!
+ * @brief MMC boot stream chunk consumer.
+ *
+ * @param chunk chunk buffer, it is reused for the following chunk once the function return.
+ * @param chunkSize chunk size in byte.
+ * @param chunkIndex chunk index from the start of the boot partition.
+ * @param userData user data.
+ * @retval kStatus_Success to continue the boot stream, other status to stop it and return the status.
+ */
+typedef status_t (*mmc_boot_stream_callback_t)(const uint8_t *chunk,
+                                               uint32_t chunkSize,
+                                               uint32_t chunkIndex,
+                                               void *userData);
+
+/*! @brief MMC boot stream */
+typedef struct _mmc_boot_stream
+{
+    uint8_t **chunkBuffer;               /*!< chunk buffers used in turn, each holds hostConfig->blockCount blocks */
+    uint32_t chunkBufferCount;           /*!< chunk buffer count, 2 at least to overlap the read and the consumer */
+    uint32_t chunkCount;                 /*!< chunk count to read */
+    mmc_boot_stream_callback_t callback; /*!< chunk consumer */
+    void *userData;                      /*!< chunk consumer user data */
+} mmc_boot_stream_t;
+
 /*************************************************************************************************
  * API
  ************************************************************************************************/
@@ -156,6 +255,13 @@ void MMC_Deinit(mmc_card_t *card);
    MMC_CardInit(card);
  * @endcode
  *
+ * If card->registerSnapshot is not NULL, the function restores the extended CSD from the snapshot and skips the data
+ * bus test pattern when the CID and CSD of the card match the snapshot, kMMC_RegisterSnapshotRestoredFlag is set in
+ * card->flags then. Otherwise the registers are read from the card and the snapshot is refilled, application can save
+ * the snapshot after the init to speed up the next init of the same card. MMC_SetBootConfig keeps the snapshot in step
+ * with the boot configuration written to the card, while MMC_SetBootConfigWP and MMC_SetBootPartitionWP invalidate it,
+ * so the snapshot should be saved again after any of them.
+ *
  * @param card Card descriptor.
  *
  * @retval #kStatus_SDMMC_HostNotReady Host is not ready.
@@ -264,6 +370,10 @@ status_t MMC_ReadBlocks(mmc_card_t *card, uint8_t *buffer, uint32_t startBlock,
  * 2. It is an async write function which means that the card status may still be busy after the function returns.
  * Application can call function MMC_PollingCardStatusBusy to wait for the card status to be idle after the write
  * operation.
+ * 3. If writeChunkBlocks in card descriptor is not 0, the write is split into commands of writeChunkBlocks blocks
+ * and the card lock is yielded to the MMC_ReadBlocks waiting for it between the commands, the programming of the last
+ * command is stopped by HPI if it is enabled and the command is written again after the read. Other accesses may
+ * be done between the commands as well. MMC_WriteBlocksReliable is not chunked.
  *
  * @param card Card descriptor.
  * @param buffer The buffer to save data blocks.
@@ -279,6 +389,57 @@ status_t MMC_ReadBlocks(mmc_card_t *card, uint8_t *buffer, uint32_t startBlock,
  */
 status_t MMC_WriteBlocks(mmc_card_t *card, const uint8_t *buffer, uint32_t startBlock, uint32_t blockCount);
 
+/*!
+ * @brief Writes data blocks to the card with reliable write.
+ *
+ * The reliable write request flag is set in CMD23, the old data of the blocks written in one command is kept if the
+ * write is interrupted by power loss, so the update is atomic without read back verification. The request is split on
+ * the reliable write sector count(REL_WR_SEC_C) boundary, in legacy reliable write mode the request is split into
+ * single block writes except the aligned REL_WR_SEC_C blocks. The atomicity is per split write only.
+ *
+ * @note
+ * 1. It is a thread safe function.
+ * 2. The buffer should be word aligned. Otherwise it is written through the alignment buffer of the card descriptor,
+ * which must hold the largest split write, or kStatus_InvalidArgument is returned before any block is written, since
+ * a split write divided further would not be atomic.
+ * 3. In command queue mode, the reliable write request flag is set in CMD44 of each queued split write instead.
+ * 4. writeChunkBlocks in card descriptor does not apply, the split writes are neither chunked nor interrupted by HPI.
+ *
+ * @param card Card descriptor.
+ * @param buffer The buffer to save data blocks.
+ * @param startBlock Start block number to write.
+ * @param blockCount Block count.
+ * @retval #kStatus_InvalidArgument Invalid argument.
+ * @retval #kStatus_SDMMC_TransferFailed Transfer failed.
+ * @retval #kStatus_Success Operation succeeded.
+ */
+status_t MMC_WriteBlocksReliable(mmc_card_t *card, const uint8_t *buffer, uint32_t startBlock, uint32_t blockCount);
+
+/*!
+ * @brief Writes data blocks to the card with forced unit access.
+ *
+ * The blocks written by MMC_WriteBlocks go to the device cache if the cache is enabled, this function sets the forced
+ * programming flag in CMD23, so the data is programmed to the nonvolatile storage directly instead of the cache, it is
+ * used for the critical data such as the file system metadata. The blocks written by MMC_WriteBlocks before are not
+ * affected, use MMC_FlushCache as a write barrier for them. If the cache is disabled, it is same as MMC_WriteBlocks.
+ *
+ * @note
+ * 1. It is a thread safe function.
+ * 2. In command queue mode, the forced programming flag is set in CMD44 of the queued task instead.
+ *
+ * @param card Card descriptor.
+ * @param buffer The buffer to save data blocks.
+ * @param startBlock Start block number to write.
+ * @param blockCount Block count.
+ * @retval #kStatus_InvalidArgument Invalid argument.
+ * @retval #kStatus_SDMMC_TransferFailed Transfer failed.
+ * @retval #kStatus_Success Operation succeeded.
+ */
+status_t MMC_WriteBlocksForceUnitAccess(mmc_card_t *card,
+                                        const uint8_t *buffer,
+                                        uint32_t startBlock,
+                                        uint32_t blockCount);
+
 /*!
  * @brief Erases groups of the card.
  *
@@ -293,6 +454,7 @@ status_t MMC_WriteBlocks(mmc_card_t *card, const uint8_t *buffer, uint32_t start
  * @param  card Card descriptor.
  * @param  startGroup Start group number.
  * @param  endGroup End group number.
+ * @retval #kStatus_SDMMC_NotSupportYet Command queue is enabled.
  * @retval #kStatus_InvalidArgument Invalid argument.
  * @retval #kStatus_SDMMC_WaitWriteCompleteFailed Send status failed.
  * @retval #kStatus_SDMMC_TransferFailed Transfer failed.
@@ -300,6 +462,173 @@ status_t MMC_WriteBlocks(mmc_card_t *card, const uint8_t *buffer, uint32_t start
  */
 status_t MMC_EraseGroups(mmc_card_t *card, uint32_t startGroup, uint32_t endGroup);
 
+/*!
+ * @brief Trims blocks of the card.
+ *
+ * Trim is applied to the write blocks instead of the erase groups, the content of the trimmed blocks is set to the
+ * erased value. The trim timeout is 300ms * TRIM_MULT for each erase group in the range.
+ *
+ * @note
+ * 1. It is a thread safe function.
+ * 2. card->extendedCsd.optimalTrimSize is the trim size in 4KB * 2^(OPTIMAL_TRIM_SIZE - 1) unit the card prefers.
+ *
+ * @param  card Card descriptor.
+ * @param  startBlock Start block.
+ * @param  blockCount Block count.
+ * @retval #kStatus_SDMMC_NotSupportYet Trim is not supported by the card, or command queue enabled.
+ * @retval #kStatus_InvalidArgument Invalid argument.
+ * @retval #kStatus_SDMMC_PollingCardIdleFailed Polling card idle failed.
+ * @retval #kStatus_SDMMC_TransferFailed Transfer failed.
+ * @retval #kStatus_Success Operation succeeded.
+ */
+status_t MMC_TrimBlocks(mmc_card_t *card, uint32_t startBlock, uint32_t blockCount);
+
+/*!
+ * @brief Discards blocks of the card.
+ *
+ * Discard is similar to trim, but the content of the discarded blocks is indeterminate, so the card can reclaim the
+ * blocks in the background and the command returns faster. It is used to inform the card the blocks are no longer used,
+ * such as the clusters freed by the file system.
+ *
+ * @note It is a thread safe function.
+ *
+ * @param  card Card descriptor.
+ * @param  startBlock Start block.
+ * @param  blockCount Block count.
+ * @retval #kStatus_SDMMC_NotSupportYet Discard is not supported by the card, or command queue enabled.
+ * @retval #kStatus_InvalidArgument Invalid argument.
+ * @retval #kStatus_SDMMC_PollingCardIdleFailed Polling card idle failed.
+ * @retval #kStatus_SDMMC_TransferFailed Transfer failed.
+ * @retval #kStatus_Success Operation succeeded.
+ */
+status_t MMC_DiscardBlocks(mmc_card_t *card, uint32_t startBlock, uint32_t blockCount);
+
+/*!
+ * @brief Sanitizes the card.
+ *
+ * Sanitize physically removes the data in the unmapped user address space, such as the blocks trimmed, discarded or
+ * erased before.
+ *
+ * @note It is a thread safe function.
+ *
+ * @param  card Card descriptor.
+ * @param  timeoutMs Sanitize timeout in ms, there is no timeout defined by the card, it depends on the unmapped data
+ * size.
+ * @retval #kStatus_SDMMC_NotSupportYet Sanitize is not supported by the card, or command queue enabled.
+ * @retval #kStatus_SDMMC_ConfigureExtendedCsdFailed Sanitize failed.
+ * @retval #kStatus_Success Operation succeeded.
+ */
+status_t MMC_Sanitize(mmc_card_t *card, uint32_t timeoutMs);
+
+/*!
+ * @brief Enables the background operations of the card.
+ *
+ * The card may run the background operations like garbage collection during the write programming when they are not
+ * started by the host, which stalls the write for a long time. With the manual mode the application calls
+ * MMC_BackgroundOperationIdle from the idle hook to start them, with the auto mode the card starts them when idle.
+ *
+ * @note The manual enable bit is one time programmable, it cannot be cleared once set.
+ *
+ * @param card Card descriptor.
+ * @param mode Background operations mode, the combination of @ref mmc_bkops_mode_t.
+ * @retval #kStatus_SDMMC_NotSupportYet The background operations or auto mode are not supported, or command queue
+ * enabled.
+ * @retval #kStatus_SDMMC_ConfigureExtendedCsdFailed Enable failed.
+ * @retval #kStatus_Success Operation succeeded.
+ */
+status_t MMC_EnableBackgroundOperation(mmc_card_t *card, uint32_t mode);
+
+/*!
+ * @brief Gets the background operations status of the card.
+ *
+ * The function waits for the card idle and then reads BKOPS_STATUS from the extended CSD.
+ *
+ * @param card Card descriptor.
+ * @param status Background operations status.
+ * @retval #kStatus_SDMMC_NotSupportYet The background operations are not supported, or command queue enabled.
+ * @retval #kStatus_SDMMC_PollingCardIdleFailed Card is busy.
+ * @retval #kStatus_SDMMC_TransferFailed Read extended CSD failed.
+ * @retval #kStatus_Success Operation succeeded.
+ */
+status_t MMC_GetBackgroundOperationStatus(mmc_card_t *card, mmc_bkops_status_t *status);
+
+/*!
+ * @brief Background operations idle hook.
+ *
+ * The function is called by the application when there is no pending request. It reads BKOPS_STATUS and starts the
+ * manual background operations without waiting for them if the status reaches the threshold. The next read/write
+ * interrupts them by HPI if HPI is enabled, otherwise it waits for them to complete. Nothing is done when the card is
+ * busy.
+ *
+ * @param card Card descriptor.
+ * @param threshold Lowest status to start the background operations.
+ * @retval #kStatus_SDMMC_NotSupportYet The manual background operations are not enabled, or command queue enabled.
+ * @retval #kStatus_SDMMC_TransferFailed Read extended CSD failed.
+ * @retval #kStatus_SDMMC_ConfigureExtendedCsdFailed Start failed.
+ * @retval #kStatus_Success Operation succeeded.
+ */
+status_t MMC_BackgroundOperationIdle(mmc_card_t *card, mmc_bkops_status_t threshold);
+
+/*!
+ * @brief Enables the high priority interrupt of the card.
+ *
+ * @param card Card descriptor.
+ * @param enable True is enabling HPI, false is disabling HPI.
+ * @retval #kStatus_SDMMC_NotSupportYet HPI is not supported, or command queue enabled.
+ * @retval #kStatus_SDMMC_ConfigureExtendedCsdFailed Enable failed.
+ * @retval #kStatus_Success Operation succeeded.
+ */
+status_t MMC_EnableHighPriorityInterrupt(mmc_card_t *card, bool enable);
+
+/*!
+ * @brief Sends the high priority interrupt to stop the card programming.
+ *
+ * The card leaves the programming state within OUT_OF_INTERRUPT_TIME, so a pending high priority read does not wait
+ * for a long program or background operation. The blocks of an interrupted write may be not programmed, the write
+ * should be sent again. Nothing is sent if the card is not busy.
+ *
+ * @param card Card descriptor.
+ * @retval #kStatus_SDMMC_NotSupportYet HPI is not enabled, or command queue enabled.
+ * @retval #kStatus_SDMMC_TransferFailed Transfer failed.
+ * @retval #kStatus_SDMMC_PollingCardIdleFailed Card is not out of interrupt in OUT_OF_INTERRUPT_TIME.
+ * @retval #kStatus_Success Operation succeeded.
+ */
+status_t MMC_SendHighPriorityInterrupt(mmc_card_t *card);
+
+/*!
+ * @brief Resets the busy latency statistics of the card.
+ *
+ * The statistics record the busy latency before each read/write in the histogram, the percentile is got by
+ * SDMMC_LatencyHistogramPercentile.
+ *
+ * @param card Card descriptor.
+ */
+void MMC_ResetLatencyStatistics(mmc_card_t *card);
+
+#if SDMMC_ENABLE_INSTRUMENTATION
+/*!
+ * @brief Gets the transfer instrumentation of the card.
+ *
+ * The instrumentation is enabled by SDMMC_ENABLE_INSTRUMENTATION, the latency percentile of each command is got by
+ * SDMMC_LatencyHistogramPercentile.
+ *
+ * @note It is a thread safe function.
+ *
+ * @param card Card descriptor.
+ * @param instrument Transfer instrumentation copied from the card.
+ */
+void MMC_GetInstrumentation(mmc_card_t *card, sdmmc_instrument_t *instrument);
+
+/*!
+ * @brief Resets the transfer instrumentation of the card.
+ *
+ * @note It is a thread safe function.
+ *
+ * @param card Card descriptor.
+ */
+void MMC_ResetInstrumentation(mmc_card_t *card);
+#endif
+
 /*!
  * @brief Selects the partition to access.
  *
@@ -366,6 +695,31 @@ status_t MMC_ReadBootData(mmc_card_t *card, uint8_t *buffer, sdmmchost_boot_conf
  */
 status_t MMC_StopBoot(mmc_card_t *card, uint32_t bootMode);
 
+/*!
+ * @brief MMC card read the boot partition as a stream of chunks.
+ *
+ * The boot data is received in the chunk buffers in turn, hostConfig->enableAutoStopAtBlockGap must be set to stop the
+ * boot data every hostConfig->blockCount blocks. Each filled chunk is passed to the consumer, such as a hash or a
+ * decompressor, while the next chunk is received, so the peak RAM is the chunk buffers instead of the whole boot image
+ * and the load overlaps the verification with the non_blocking host adapter. The ADMA2 descriptor of each chunk is
+ * appended to the host DMA descriptor table, the table should hold SDMMCHOST_BOOT_STREAM_DESCRIPTOR_WORDS(chunkCount)
+ * words. The function starts the boot by MMC_StartBoot and stops it by MMC_StopBoot.
+ *
+ * @param card Card descriptor.
+ * @param mmcConfig The mmc Boot configuration structure.
+ * @param hostConfig Host boot configurations.
+ * @param stream boot stream.
+ * @retval #kStatus_InvalidArgument Invalid argument.
+ * @retval #kStatus_Fail Failed.
+ * @retval #kStatus_SDMMC_TransferFailed Transfer failed.
+ * @retval #kStatus_Success Operation succeeded.
+ * @retval other the status returned by the consumer.
+ */
+status_t MMC_ReadBootStream(mmc_card_t *card,
+                            const mmc_boot_config_t *mmcConfig,
+                            sdmmchost_boot_config_t *hostConfig,
+                            const mmc_boot_stream_t *stream);
+
 /*!
  * @brief MMC card set boot partition write protect.
  *
@@ -396,7 +750,16 @@ status_t MMC_EnableCacheControl(mmc_card_t *card, bool enable);
  * between partitions). Cached data may be lost in SLEEP state, so host should flush the cache before placing the device
  * into SLEEP state.
  *
+ * It is also the write barrier of the driver, all the blocks written before the function call are in the nonvolatile
+ * memory when the function returns kStatus_Success. If the cache is not supported or not enabled, the written blocks
+ * are already in the nonvolatile memory and kStatus_SDMMC_NotSupportYet is returned.
+ *
+ * @note It is a thread safe function.
+ *
  * @param card Card descriptor.
+ * @retval #kStatus_SDMMC_NotSupportYet The cache is not supported or not enabled.
+ * @retval #kStatus_SDMMC_ConfigureExtendedCsdFailed Flush failed.
+ * @retval #kStatus_Success Operation succeeded.
  */
 status_t MMC_FlushCache(mmc_card_t *card);
 
@@ -420,6 +783,109 @@ status_t MMC_FlushCache(mmc_card_t *card);
  */
 status_t MMC_SetSleepAwake(mmc_card_t *card, mmc_sleep_awake_t state);
 
+/*!
+ * @brief MMC card command queue control function.
+ *
+ * The command queue is disabled by default. While it is enabled, MMC_ReadBlocks/MMC_WriteBlocks are transferred as
+ * one queued task each, and MMC_FlushCache disables the queue around the flush. The erase, trim, discard, sanitize,
+ * packed command, background operations and HPI functions return kStatus_SDMMC_NotSupportYet, and the boot, sleep and
+ * partition functions should not be used until it is disabled again, since the card rejects those commands in command
+ * queue mode.
+ *
+ * @param card Card descriptor.
+ * @param enable True is enabling the command queue, false is disabling the command queue.
+ * @retval kStatus_SDMMC_NotSupportYet Indicates the memory device doesn't support the command queue.
+ * @retval kStatus_SDMMC_ConfigureExtendedCsdFailed Indicates switch command queue mode failed.
+ * @retval kStatus_Success Indicates the command queue mode is switched successfully.
+ */
+status_t MMC_EnableCommandQueue(mmc_card_t *card, bool enable);
+
+/*!
+ * @brief MMC card command queue transfer function.
+ *
+ * The tasks are queued to the card by CMD44/CMD45 up to the command queue depth, the queue status register is polled by
+ * CMD13 and the ready tasks are executed by CMD46/CMD47 in the order the card chooses, then the freed task slots are
+ * refilled with the following tasks until all the tasks are complete. So the card can prepare the data of the queued
+ * tasks in parallel, which reduces the access latency of the random read mainly.
+ *
+ * The entire queue is discarded by CMD48 if any task failed, the status of the task not executed is set to the error
+ * code.
+ *
+ * Please note it is a thread safe function.
+ *
+ * @param card Card descriptor.
+ * @param task Task array.
+ * @param taskCount Task count.
+ * @retval kStatus_SDMMC_NotSupportYet Indicates the command queue is not enabled.
+ * @retval kStatus_InvalidArgument Indicates the task argument is invalid.
+ * @retval kStatus_SDMMC_TransferFailed Indicates command transferred fail.
+ * @retval kStatus_SDMMC_PollingCardIdleFailed Indicates polling queue status timeout.
+ * @retval kStatus_Success Indicates all the tasks are complete successfully.
+ */
+status_t MMC_CommandQueueTransfer(mmc_card_t *card, mmc_cmdq_task_t *task, uint32_t taskCount);
+
+/*!
+ * @brief MMC card packed write function.
+ *
+ * Combines the discontiguous write entries into one packed write, the packed command header and the data of all the
+ * entries are copied into the packed buffer and written by one CMD23 + CMD25 sequence, so the command and programming
+ * overhead of the small writes is paid once.
+ *
+ * If the packed write failed, the packed command status in Extended CSD is read back, the entries before the failure
+ * index reported by the card are complete successfully, and the others are set to kStatus_SDMMC_TransferFailed.
+ *
+ * Please note it is a thread safe function.
+ *
+ * @param card Card descriptor.
+ * @param entry Entry array.
+ * @param entryCount Entry count, should not exceed card->extendedCsd.maxPackedWriteCmd.
+ * @param packedBuffer Packed buffer, the address should meet the host DMA alignment requirement.
+ * @param packedBufferSize Packed buffer size, should be larger than one block plus the data size of all the entries.
+ * @retval kStatus_SDMMC_NotSupportYet Indicates the card doesn't support the packed command, or command queue
+ * enabled.
+ * @retval kStatus_InvalidArgument Indicates the entry argument or packed buffer size is invalid.
+ * @retval kStatus_SDMMC_PollingCardIdleFailed Indicates polling card status failed.
+ * @retval kStatus_SDMMC_SetBlockCountFailed Indicates set block count failed.
+ * @retval kStatus_SDMMC_TransferFailed Indicates the packed write failed, reference the entry status.
+ * @retval kStatus_Success Indicates all the entries are written successfully.
+ */
+status_t MMC_PackedWriteBlocks(mmc_card_t *card,
+                               mmc_packed_entry_t *entry,
+                               uint32_t entryCount,
+                               uint8_t *packedBuffer,
+                               uint32_t packedBufferSize);
+
+/*!
+ * @brief MMC card packed read function.
+ *
+ * Combines the discontiguous read entries into one packed read, the packed command header is written by CMD23 + CMD25
+ * firstly, then the data of all the entries is read by one CMD23 + CMD18 sequence into the packed buffer and copied to
+ * the entry buffers.
+ *
+ * If the packed read failed, the packed command status in Extended CSD is read back, the entries before the failure
+ * index reported by the card are complete successfully, and the others are set to kStatus_SDMMC_TransferFailed.
+ *
+ * Please note it is a thread safe function.
+ *
+ * @param card Card descriptor.
+ * @param entry Entry array.
+ * @param entryCount Entry count, should not exceed card->extendedCsd.maxPackedReadCmd.
+ * @param packedBuffer Packed buffer, the address should meet the host DMA alignment requirement.
+ * @param packedBufferSize Packed buffer size, should be larger than one block plus the data size of all the entries.
+ * @retval kStatus_SDMMC_NotSupportYet Indicates the card doesn't support the packed command, or command queue
+ * enabled.
+ * @retval kStatus_InvalidArgument Indicates the entry argument or packed buffer size is invalid.
+ * @retval kStatus_SDMMC_PollingCardIdleFailed Indicates polling card status failed.
+ * @retval kStatus_SDMMC_SetBlockCountFailed Indicates set block count failed.
+ * @retval kStatus_SDMMC_TransferFailed Indicates the packed read failed, reference the entry status.
+ * @retval kStatus_Success Indicates all the entries are read successfully.
+ */
+status_t MMC_PackedReadBlocks(mmc_card_t *card,
+                              mmc_packed_entry_t *entry,
+                              uint32_t entryCount,
+                              uint8_t *packedBuffer,
+                              uint32_t packedBufferSize);
+
 /*!
  * @brief Polling card idle status.
  *
@@ -273,3 +273,24 @@ uint32_t SDMMC_OSADelayUs(uint32_t microseconds)
     return milliseconds * 1000U;
 #endif
 }
+
+/*!
+ * brief sdmmc enter critical section.
+ * param sr status saved to restore.
+ */
+void SDMMC_OSAEnterCritical(uint32_t *sr)
+{
+    assert(sr != NULL);
+
+    OSA_EnterCritical(sr);
+}
+
+/*!
+ * brief sdmmc exit critical section.
+ * param sr status saved by SDMMC_OSAEnterCritical.
+ */
+void SDMMC_OSAExitCritical(uint32_t sr)
+{
+    __DSB();
+    OSA_ExitCritical(sr);
+}
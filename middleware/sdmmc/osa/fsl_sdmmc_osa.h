@@ -161,6 +161,18 @@ void SDMMC_OSADelay(uint32_t milliseconds);
  */
 uint32_t SDMMC_OSADelayUs(uint32_t microseconds);
 
+/*!
+ * @brief sdmmc enter critical section.
+ * @param sr status saved to restore.
+ */
+void SDMMC_OSAEnterCritical(uint32_t *sr);
+
+/*!
+ * @brief sdmmc exit critical section.
+ * @param sr status saved by SDMMC_OSAEnterCritical.
+ */
+void SDMMC_OSAExitCritical(uint32_t sr);
+
 /* @} */
 
 #if defined(__cplusplus)
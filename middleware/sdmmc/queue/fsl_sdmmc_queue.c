@@ -0,0 +1,342 @@
+/*
+ * Copyright 2020 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <string.h>
+#include "fsl_sdmmc_queue.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+/*!
+ * @brief Check if the pending request can be dispatched.
+ * The request cannot be dispatched before an earlier submitted request which overlap the block range if any of them is
+ * a write request.
+ *
+ * @param queue queue descriptor.
+ * @param request request to check.
+ * @retval true request can be dispatched.
+ */
+static bool SDMMC_QueueIsDispatchable(sdmmc_queue_t *queue, sdmmc_queue_request_t *request);
+
+/*!
+ * @brief Remove the request from the pending list.
+ *
+ * @param queue queue descriptor.
+ * @param request request to remove.
+ */
+static void SDMMC_QueueRemove(sdmmc_queue_t *queue, sdmmc_queue_request_t *request);
+
+/*!
+ * @brief Select the next batch from the pending list in elevator order.
+ *
+ * @param queue queue descriptor.
+ * @return the first request of the batch, the batch requests are linked in ascending block order.
+ */
+static sdmmc_queue_request_t *SDMMC_QueueSelectBatch(sdmmc_queue_t *queue);
+
+/*!
+ * @brief Dispatch one batch to the card.
+ *
+ * @param queue queue descriptor.
+ */
+static void SDMMC_QueueDispatch(sdmmc_queue_t *queue);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+static bool SDMMC_QueueIsDispatchable(sdmmc_queue_t *queue, sdmmc_queue_request_t *request)
+{
+    sdmmc_queue_request_t *earlier = queue->pending;
+
+    while ((earlier != NULL) && (earlier != request))
+    {
+        if ((earlier->sequence < request->sequence) && (earlier->isWrite || request->isWrite) &&
+            (earlier->startBlock < (request->startBlock + request->blockCount)) &&
+            (request->startBlock < (earlier->startBlock + earlier->blockCount)))
+        {
+            return false;
+        }
+        earlier = earlier->next;
+    }
+
+    return true;
+}
+
+static void SDMMC_QueueRemove(sdmmc_queue_t *queue, sdmmc_queue_request_t *request)
+{
+    sdmmc_queue_request_t **link = &queue->pending;
+
+    while (*link != NULL)
+    {
+        if (*link == request)
+        {
+            *link         = request->next;
+            request->next = NULL;
+            break;
+        }
+        link = &((*link)->next);
+    }
+}
+
+static sdmmc_queue_request_t *SDMMC_QueueSelectBatch(sdmmc_queue_t *queue)
+{
+    sdmmc_queue_request_t *request = NULL;
+    sdmmc_queue_request_t *ahead   = NULL;
+    sdmmc_queue_request_t *lowest  = NULL;
+    sdmmc_queue_request_t *first   = NULL;
+    sdmmc_queue_request_t *last    = NULL;
+    bool hasRead                   = false;
+    bool hasWrite                  = false;
+    bool isWrite                   = false;
+    bool merged                    = false;
+    uint32_t batchBlocks           = 0U;
+    uint32_t mergeLimit            = queue->config.maxBlockCount;
+
+    if (queue->config.mergeBuffer == NULL)
+    {
+        mergeLimit = 0U;
+    }
+    else if (queue->config.mergeBufferBlocks < mergeLimit)
+    {
+        mergeLimit = queue->config.mergeBufferBlocks;
+    }
+    else
+    {
+        /* Intentional empty */
+    }
+
+    for (request = queue->pending; request != NULL; request = request->next)
+    {
+        if (SDMMC_QueueIsDispatchable(queue, request))
+        {
+            if (request->isWrite)
+            {
+                hasWrite = true;
+            }
+            else
+            {
+                hasRead = true;
+            }
+        }
+    }
+
+    if ((!hasRead) && (!hasWrite))
+    {
+        return NULL;
+    }
+
+    /* read has priority over write, but write is forced after SDMMC_QUEUE_READ_BATCH_LIMIT read batches */
+    isWrite = (!hasRead) || (hasWrite && (queue->readBatches >= SDMMC_QUEUE_READ_BATCH_LIMIT));
+    if ((!isWrite) && hasWrite)
+    {
+        queue->readBatches++;
+    }
+    else
+    {
+        queue->readBatches = 0U;
+    }
+
+    /* elevator: the lowest block at or after the head, otherwise wrap to the lowest block */
+    for (request = queue->pending; request != NULL; request = request->next)
+    {
+        if ((request->isWrite != isWrite) || (!SDMMC_QueueIsDispatchable(queue, request)))
+        {
+            continue;
+        }
+
+        if ((request->startBlock >= queue->headBlock) && ((ahead == NULL) || (request->startBlock < ahead->startBlock)))
+        {
+            ahead = request;
+        }
+
+        if ((lowest == NULL) || (request->startBlock < lowest->startBlock))
+        {
+            lowest = request;
+        }
+    }
+
+    first = (ahead != NULL) ? ahead : lowest;
+    SDMMC_QueueRemove(queue, first);
+    last        = first;
+    batchBlocks = first->blockCount;
+
+    /* merge the following adjacent requests in the same direction */
+    do
+    {
+        merged = false;
+        for (request = queue->pending; request != NULL; request = request->next)
+        {
+            if ((request->isWrite == isWrite) && (request->startBlock == (last->startBlock + last->blockCount)) &&
+                ((batchBlocks + request->blockCount) <= mergeLimit) && SDMMC_QueueIsDispatchable(queue, request))
+            {
+                SDMMC_QueueRemove(queue, request);
+                last->next = request;
+                last       = request;
+                batchBlocks += request->blockCount;
+                queue->statistics.mergedRequests++;
+                merged = true;
+                break;
+            }
+        }
+    } while (merged);
+
+    return first;
+}
+
+static void SDMMC_QueueDispatch(sdmmc_queue_t *queue)
+{
+    sdmmc_queue_request_t *first   = NULL;
+    sdmmc_queue_request_t *request = NULL;
+    sdmmc_queue_request_t *next    = NULL;
+    uint32_t batchBlocks           = 0U;
+    uint32_t offset                = 0U;
+    status_t error                 = kStatus_Success;
+
+    (void)SDMMC_OSAMutexLock(&queue->listLock, osaWaitForever_c);
+    first = SDMMC_QueueSelectBatch(queue);
+    (void)SDMMC_OSAMutexUnlock(&queue->listLock);
+
+    if (first == NULL)
+    {
+        return;
+    }
+
+    if (first->next == NULL)
+    {
+        /* single request, transfer with the caller buffer directly */
+        batchBlocks = first->blockCount;
+        error       = queue->config.transfer(queue->config.card, first->buffer, first->startBlock, first->blockCount,
+                                       first->isWrite);
+    }
+    else
+    {
+        for (request = first; request != NULL; request = request->next)
+        {
+            if (request->isWrite)
+            {
+                (void)memcpy(&queue->config.mergeBuffer[offset], request->buffer,
+                             request->blockCount * FSL_SDMMC_DEFAULT_BLOCK_SIZE);
+            }
+            offset += request->blockCount * FSL_SDMMC_DEFAULT_BLOCK_SIZE;
+            batchBlocks += request->blockCount;
+        }
+
+        error = queue->config.transfer(queue->config.card, queue->config.mergeBuffer, first->startBlock, batchBlocks,
+                                       first->isWrite);
+
+        if ((error == kStatus_Success) && (!first->isWrite))
+        {
+            offset = 0U;
+            for (request = first; request != NULL; request = request->next)
+            {
+                (void)memcpy(request->buffer, &queue->config.mergeBuffer[offset],
+                             request->blockCount * FSL_SDMMC_DEFAULT_BLOCK_SIZE);
+                offset += request->blockCount * FSL_SDMMC_DEFAULT_BLOCK_SIZE;
+            }
+        }
+    }
+
+    queue->statistics.dispatchedCommands++;
+    queue->headBlock = first->startBlock + batchBlocks;
+
+    request = first;
+    while (request != NULL)
+    {
+        next            = request->next;
+        request->next   = NULL;
+        request->status = error;
+        request->state  = (uint8_t)kSDMMC_QueueRequestComplete;
+        request         = next;
+    }
+}
+
+status_t SDMMC_QueueInit(sdmmc_queue_t *queue, const sdmmc_queue_config_t *config)
+{
+    assert(queue != NULL);
+    assert(config != NULL);
+
+    if ((config->transfer == NULL) || (config->maxBlockCount == 0U))
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    (void)memset(queue, 0, sizeof(sdmmc_queue_t));
+    (void)memcpy(&queue->config, config, sizeof(sdmmc_queue_config_t));
+
+    (void)SDMMC_OSAMutexCreate(&queue->listLock);
+    (void)SDMMC_OSAMutexCreate(&queue->dispatchLock);
+
+    return kStatus_Success;
+}
+
+void SDMMC_QueueDeinit(sdmmc_queue_t *queue)
+{
+    assert(queue != NULL);
+
+    (void)SDMMC_OSAMutexDestroy(&queue->listLock);
+    (void)SDMMC_OSAMutexDestroy(&queue->dispatchLock);
+}
+
+status_t SDMMC_QueueSubmit(sdmmc_queue_t *queue, uint8_t *buffer, uint32_t startBlock, uint32_t blockCount, bool isWrite)
+{
+    assert(queue != NULL);
+
+    sdmmc_queue_request_t request = {0};
+    sdmmc_queue_request_t **tail  = NULL;
+
+    if ((buffer == NULL) || (blockCount == 0U))
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    request.buffer     = buffer;
+    request.startBlock = startBlock;
+    request.blockCount = blockCount;
+    request.isWrite    = isWrite;
+    request.state      = (uint8_t)kSDMMC_QueueRequestPending;
+
+    /* append the request to the pending list in submit order */
+    (void)SDMMC_OSAMutexLock(&queue->listLock, osaWaitForever_c);
+    request.sequence = queue->sequence++;
+    for (tail = &queue->pending; *tail != NULL; tail = &((*tail)->next))
+    {
+    }
+    *tail = &request;
+    queue->statistics.submittedRequests++;
+    (void)SDMMC_OSAMutexUnlock(&queue->listLock);
+
+    /* the task which get the dispatch lock services the pending requests until its own request complete */
+    while (request.state != (uint8_t)kSDMMC_QueueRequestComplete)
+    {
+        (void)SDMMC_OSAMutexLock(&queue->dispatchLock, osaWaitForever_c);
+        if (request.state != (uint8_t)kSDMMC_QueueRequestComplete)
+        {
+            SDMMC_QueueDispatch(queue);
+        }
+        (void)SDMMC_OSAMutexUnlock(&queue->dispatchLock);
+    }
+
+    return request.status;
+}
+
+void SDMMC_QueueGetStatistics(sdmmc_queue_t *queue, sdmmc_queue_statistics_t *statistics)
+{
+    assert(queue != NULL);
+    assert(statistics != NULL);
+
+    (void)SDMMC_OSAMutexLock(&queue->listLock, osaWaitForever_c);
+    (void)memcpy(statistics, &queue->statistics, sizeof(sdmmc_queue_statistics_t));
+    (void)SDMMC_OSAMutexUnlock(&queue->listLock);
+}
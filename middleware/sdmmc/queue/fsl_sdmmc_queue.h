@@ -0,0 +1,176 @@
+/*
+ * Copyright 2020 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _FSL_SDMMC_QUEUE_H_
+#define _FSL_SDMMC_QUEUE_H_
+
+#include "fsl_sdmmc_common.h"
+
+/*!
+ * @addtogroup sdmmc_queue SDMMC request queue
+ * @ingroup card
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief Request queue version. */
+#define FSL_SDMMC_QUEUE_VERSION (MAKE_VERSION(1U, 0U, 0U)) /*1.0.0*/
+
+/*! @brief consecutive read batches dispatched while write is pending before the write batch is forced to avoid write
+ * starvation */
+#ifndef SDMMC_QUEUE_READ_BATCH_LIMIT
+#define SDMMC_QUEUE_READ_BATCH_LIMIT (4U)
+#endif
+
+/*! @brief sdmmc queue request state */
+typedef enum _sdmmc_queue_request_state
+{
+    kSDMMC_QueueRequestPending  = 0U, /*!< request is waiting for dispatch */
+    kSDMMC_QueueRequestComplete = 1U, /*!< request is complete */
+} sdmmc_queue_request_state_t;
+
+/*!
+ * @brief sdmmc queue card transfer function.
+ *
+ * @param card card descriptor, such as sd_card_t or mmc_card_t.
+ * @param buffer data buffer.
+ * @param startBlock start block.
+ * @param blockCount block count.
+ * @param isWrite true is write transfer, false is read transfer.
+ */
+typedef status_t (*sdmmc_queue_transfer_t)(
+    void *card, uint8_t *buffer, uint32_t startBlock, uint32_t blockCount, bool isWrite);
+
+/*! @brief sdmmc queue request, the request is allocated by the caller and must stay valid until the submit return */
+typedef struct _sdmmc_queue_request
+{
+    struct _sdmmc_queue_request *next; /*!< next pending request */
+    uint8_t *buffer;                   /*!< data buffer */
+    uint32_t startBlock;               /*!< start block */
+    uint32_t blockCount;               /*!< block count */
+    uint32_t sequence;                 /*!< submit sequence number */
+    bool isWrite;                      /*!< write request flag */
+    volatile uint8_t state;            /*!< request state, reference sdmmc_queue_request_state_t */
+    status_t status;                   /*!< request complete status */
+} sdmmc_queue_request_t;
+
+/*! @brief sdmmc queue configuration */
+typedef struct _sdmmc_queue_config
+{
+    void *card;                      /*!< card descriptor pass to transfer function */
+    sdmmc_queue_transfer_t transfer; /*!< card transfer function */
+    uint8_t *mergeBuffer;            /*!< buffer used to merge requests with adjacent block range, the buffer
+                                          address should meet the host DMA alignment requirement */
+    uint32_t mergeBufferBlocks;      /*!< merge buffer size in block */
+    uint32_t maxBlockCount;          /*!< max block count per card command, such as host->maxBlockCount */
+} sdmmc_queue_config_t;
+
+/*! @brief sdmmc queue statistics */
+typedef struct _sdmmc_queue_statistics
+{
+    uint32_t submittedRequests;  /*!< request submitted count */
+    uint32_t dispatchedCommands; /*!< card transfer issued count */
+    uint32_t mergedRequests;     /*!< request merged into other request's transfer count */
+} sdmmc_queue_statistics_t;
+
+/*! @brief sdmmc queue */
+typedef struct _sdmmc_queue
+{
+    sdmmc_queue_config_t config;         /*!< queue configuration */
+    sdmmc_queue_request_t *pending;      /*!< pending request list */
+    uint32_t sequence;                   /*!< next submit sequence number */
+    uint32_t headBlock;                  /*!< block address next to the last dispatched transfer */
+    uint32_t readBatches;                /*!< consecutive read batch count while write pending */
+    sdmmc_queue_statistics_t statistics; /*!< queue statistics */
+    sdmmc_osa_mutex_t listLock;          /*!< pending list lock */
+    sdmmc_osa_mutex_t dispatchLock;      /*!< dispatch lock */
+} sdmmc_queue_t;
+
+/*************************************************************************************************
+ * API
+ ************************************************************************************************/
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*!
+ * @name SDMMC request queue Function
+ * @{
+ */
+
+/*!
+ * @brief Initializes the request queue.
+ *
+ * The request queue accepts read/write requests from many tasks, merges the requests with adjacent block range into
+ * one multiple block transfer up to maxBlockCount, dispatches the requests in elevator order and gives read request
+ * priority over write request. There is no dedicated dispatch task, the submitting task which get the dispatch lock
+ * services the pending requests on behalf of the others.
+ *
+ * Example:
+   @code
+   static status_t SD_QueueTransfer(void *card, uint8_t *buffer, uint32_t startBlock, uint32_t blockCount, bool isWrite)
+   {
+       return isWrite ? SD_WriteBlocks((sd_card_t *)card, buffer, startBlock, blockCount) :
+                        SD_ReadBlocks((sd_card_t *)card, buffer, startBlock, blockCount);
+   }
+
+   config.card              = &g_sd;
+   config.transfer          = SD_QueueTransfer;
+   config.mergeBuffer       = s_mergeBuffer;
+   config.mergeBufferBlocks = sizeof(s_mergeBuffer) / FSL_SDMMC_DEFAULT_BLOCK_SIZE;
+   config.maxBlockCount     = g_sd.host->maxBlockCount;
+   SDMMC_QueueInit(&queue, &config);
+   @endcode
+ *
+ * @param queue queue descriptor.
+ * @param config queue configuration.
+ * @retval kStatus_Success init success.
+ * @retval kStatus_InvalidArgument invalid configuration.
+ */
+status_t SDMMC_QueueInit(sdmmc_queue_t *queue, const sdmmc_queue_config_t *config);
+
+/*!
+ * @brief Deinitializes the request queue.
+ *
+ * @param queue queue descriptor.
+ */
+void SDMMC_QueueDeinit(sdmmc_queue_t *queue);
+
+/*!
+ * @brief Submits request to the queue and waits the request complete.
+ *
+ * Please note it is a thread safe function, the request to overlap block range is completed in submit order if any of
+ * them is a write request.
+ *
+ * @param queue queue descriptor.
+ * @param buffer data buffer.
+ * @param startBlock start block.
+ * @param blockCount block count.
+ * @param isWrite true is write request, false is read request.
+ * @retval kStatus_Success request complete successfully.
+ * @retval kStatus_InvalidArgument invalid argument.
+ * @retval other status returned by the card transfer function.
+ */
+status_t SDMMC_QueueSubmit(sdmmc_queue_t *queue, uint8_t *buffer, uint32_t startBlock, uint32_t blockCount, bool isWrite);
+
+/*!
+ * @brief Gets the queue statistics.
+ *
+ * @param queue queue descriptor.
+ * @param statistics statistics pointer.
+ */
+void SDMMC_QueueGetStatistics(sdmmc_queue_t *queue, sdmmc_queue_statistics_t *statistics);
+
+/* @} */
+
+#if defined(__cplusplus)
+}
+#endif
+/*! @} */
+#endif /* _FSL_SDMMC_QUEUE_H_*/
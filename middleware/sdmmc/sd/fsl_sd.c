@@ -17,6 +17,20 @@
 #ifndef SD_CARD_ACCESS_WAIT_IDLE_TIMEOUT
 #define SD_CARD_ACCESS_WAIT_IDLE_TIMEOUT (600U) /* more then 500ms timeout value */
 #endif
+/*! @brief card discard busy timeout value */
+#ifndef SD_CARD_DISCARD_TIMEOUT
+#define SD_CARD_DISCARD_TIMEOUT (500U) /* 250ms busy timeout defined by spec with margin */
+#endif
+/*! @brief card full user area logical erase busy timeout value */
+#ifndef SD_CARD_FULE_TIMEOUT
+#define SD_CARD_FULE_TIMEOUT (1500U) /* 1s busy timeout defined by spec with margin */
+#endif
+/*! @brief register snapshot valid magic */
+#define SD_REGISTER_SNAPSHOT_MAGIC (0x53445253U) /* "SDRS" */
+/*! @brief card flags restored from the register snapshot */
+#define SD_REGISTER_SNAPSHOT_FLAGS                                                    \
+    ((uint32_t)kSD_Support4BitWidthFlag | (uint32_t)kSD_SupportSpeedClassControlCmd | \
+     (uint32_t)kSD_SupportSetBlockCountCmd)
 /*! @brief card cmd13 retry times */
 #ifndef SD_CMD13_RETRY_TIMES
 #define SD_CMD13_RETRY_TIMES (10)
@@ -43,6 +57,17 @@ static status_t SD_SendCardStatus(sd_card_t *card);
  */
 static status_t SD_SendWriteSuccessBlocks(sd_card_t *card, uint32_t *blocks);
 
+/*!
+ * @brief Send SET_WR_BLK_ERASE_COUNT command to pre-erase the blocks of the following multiple block write.
+ *
+ * @param card Card descriptor.
+ * @param blockCount Block count of the following multiple block write.
+ * @retval kStatus_SDMMC_SendApplicationCommandFailed Send application command failed.
+ * @retval kStatus_SDMMC_TransferFailed Transfer failed.
+ * @retval kStatus_Success Operate successfully.
+ */
+static status_t SD_SetWriteBlockEraseCount(sd_card_t *card, uint32_t blockCount);
+
 /*!
  * @brief Send SEND_APPLICATION_COMMAND command.
  *
@@ -105,6 +130,19 @@ static status_t SD_SendRca(sd_card_t *card);
  */
 static status_t SD_SwitchFunction(sd_card_t *card, uint32_t mode, uint32_t group, uint32_t number, uint32_t *status);
 
+/*!
+ * @brief Compare the raw register content with the register snapshot and update the snapshot.
+ *
+ * The snapshot is invalidated if the content is different.
+ *
+ * @param snapshot register snapshot.
+ * @param snapshotRegister register content in the snapshot.
+ * @param rawRegister raw register content of the card.
+ */
+static void SD_UpdateSnapshotRegister(sd_register_snapshot_t *snapshot,
+                                      uint32_t *snapshotRegister,
+                                      const uint8_t *rawRegister);
+
 /*!
  * @brief Decode raw SCR register content in the data blocks.
  *
@@ -284,7 +322,8 @@ static status_t SD_Write(sd_card_t *card,
  * @retval kStatus_SDMMC_TransferFailed Transfer failed.
  * @retval kStatus_Success Operate successfully.
  */
-static status_t SD_Erase(sd_card_t *card, uint32_t startBlock, uint32_t blockCount, uint32_t timeout);
+static status_t SD_Erase(
+    sd_card_t *card, uint32_t startBlock, uint32_t blockCount, uint32_t timeout, sd_erase_argument_t argument);
 
 /*!
  * @brief card transfer function.
@@ -298,6 +337,37 @@ static status_t SD_Erase(sd_card_t *card, uint32_t startBlock, uint32_t blockCou
  */
 static status_t SD_Transfer(sd_card_t *card, sdmmchost_transfer_t *content, uint32_t retry);
 
+/*!
+ * @brief Get the AU size of the card.
+ *
+ * @param card Card descriptor.
+ * @return AU size united as block, 0 if AU size is not available.
+ */
+static uint32_t SD_GetAuBlocks(sd_card_t *card);
+
+/*!
+ * @brief Send SPEED_CLASS_CONTROL command.
+ *
+ * @param card Card descriptor.
+ * @param control Speed class control function.
+ * @retval kStatus_SDMMC_TransferFailed Transfer failed.
+ * @retval kStatus_SDMMC_WaitWriteCompleteFailed Wait card idle failed.
+ * @retval kStatus_Success Operate successfully.
+ */
+static status_t SD_SpeedClassControl(sd_card_t *card, sd_speed_class_control_t control);
+
+/*!
+ * @brief Select the stop method of the multiple block transfer.
+ * The closed-ended transfer is used if the card support CMD23, the SET_BLOCK_COUNT command is sent by host Auto-CMD23
+ * if host support it, otherwise the open-ended transfer stopped by Auto-CMD12 is used.
+ *
+ * @param card Card descriptor.
+ * @param data Transfer data, the block count should be set already.
+ * @retval kStatus_SDMMC_SetBlockCountFailed Set block count failed.
+ * @retval kStatus_Success Operate successfully.
+ */
+static status_t SD_SetTransferStopMode(sd_card_t *card, sdmmchost_data_t *data);
+
 /*!
  * @brief card execute tuning function.
  *
@@ -308,6 +378,79 @@ static status_t SD_Transfer(sd_card_t *card, sdmmchost_transfer_t *content, uint
  */
 static inline status_t SD_ExecuteTuning(sd_card_t *card);
 
+/*!
+ * @brief Execute the re-tuning requested by the host before the next request.
+ *
+ * The tuning is executed between the requests instead of after the transfer rejected by the host, the transfer error
+ * recovery will retry and re-tune again if the tuning fails.
+ *
+ * @param card Card descriptor.
+ */
+static void SD_ScheduleReTuning(sd_card_t *card);
+
+/*!
+ * @brief Switch the bus clock to the bus speed governor target level before the next request.
+ *
+ * @param card Card descriptor.
+ */
+static void SD_BusGovernorApply(sd_card_t *card);
+
+/*!
+ * @brief Yield the card lock to the pending read requests between the write chunks.
+ *
+ * @param card Card descriptor.
+ */
+static void SD_WriteYield(sd_card_t *card);
+
+/*!
+ * @brief Write data blocks to the card with the card lock held by the caller.
+ *
+ * @param card Card descriptor.
+ * @param buffer The buffer to save the data to be written.
+ * @param startBlock The start block index.
+ * @param blockCount The number of blocks to write.
+ * @param enableYield true to yield the card lock to the pending reads between the write chunks.
+ * @retval kStatus_SDMMC_TransferFailed Transfer failed.
+ * @retval kStatus_Success Operate successfully.
+ */
+static status_t SD_WriteDataBlocks(sd_card_t *card,
+                                   const uint8_t *buffer,
+                                   uint32_t startBlock,
+                                   uint32_t blockCount,
+                                   bool enableYield);
+
+/*!
+ * @brief Submit asynchronous read/write transfer to card.
+ *
+ * @param card Card descriptor.
+ * @param rxBuffer Buffer to save data blocks read, NULL for write transfer.
+ * @param txBuffer Buffer to be sent, NULL for read transfer.
+ * @param startBlock Card start block number.
+ * @param blockCount Block count.
+ * @param callback Transfer complete callback.
+ * @param userData User data pass to the callback.
+ * @retval kStatus_InvalidArgument Invalid argument.
+ * @retval kStatus_SDMMC_PollingCardIdleFailed Polling card idle failed.
+ * @retval kStatus_SDMMC_TransferFailed Transfer failed.
+ * @retval kStatus_Success Operate successfully.
+ */
+static status_t SD_TransferAsync(sd_card_t *card,
+                                 uint8_t *rxBuffer,
+                                 const uint8_t *txBuffer,
+                                 uint32_t startBlock,
+                                 uint32_t blockCount,
+                                 sd_transfer_callback_t callback,
+                                 void *userData);
+
+/*!
+ * @brief card asynchronous transfer complete callback.
+ *
+ * @param host host handler.
+ * @param status transfer status.
+ * @param userData card descriptor.
+ */
+static void SD_AsyncTransferCallback(sdmmchost_t *host, status_t status, void *userData);
+
 /*******************************************************************************
  * Variables
  ******************************************************************************/
@@ -338,6 +481,85 @@ static status_t SD_SendApplicationCmd(sd_card_t *card, uint32_t relativeAddress)
     return SDMMC_SendApplicationCommand(card->host, relativeAddress);
 }
 
+static status_t SD_SetTransferStopMode(sd_card_t *card, sdmmchost_data_t *data)
+{
+    assert(card != NULL);
+    assert(data != NULL);
+
+    data->enableAutoCommand12 = true;
+    data->enableAutoCommand23 = false;
+
+    if ((data->blockCount > 1U) && ((card->flags & (uint32_t)kSD_SupportSetBlockCountCmd) != 0U))
+    {
+        data->enableAutoCommand12 = false;
+        if ((card->host->capability & (uint32_t)kSDMMCHOST_SupportAutoCmd23) != 0U)
+        {
+            data->enableAutoCommand23 = true;
+        }
+        else
+        {
+            if (kStatus_Success != SDMMC_SetBlockCount(card->host, data->blockCount))
+            {
+                return kStatus_SDMMC_SetBlockCountFailed;
+            }
+        }
+    }
+
+    return kStatus_Success;
+}
+
+static uint32_t SD_GetAuBlocks(sd_card_t *card)
+{
+    assert(card != NULL);
+
+    /* UHS card should use uhs au size field */
+    if (card->operationVoltage == kSDMMC_OperationVoltage180V)
+    {
+        return s_sdAuSizeMap[card->stat.uhsAuSize == 0U ? card->stat.auSize : card->stat.uhsAuSize] /
+               FSL_SDMMC_DEFAULT_BLOCK_SIZE;
+    }
+
+    return s_sdAuSizeMap[card->stat.auSize] / FSL_SDMMC_DEFAULT_BLOCK_SIZE;
+}
+
+static status_t SD_SpeedClassControl(sd_card_t *card, sd_speed_class_control_t control)
+{
+    assert(card != NULL);
+
+    sdmmchost_transfer_t content = {0};
+    sdmmchost_cmd_t command      = {0};
+    status_t error               = kStatus_Success;
+
+    /* wait card status ready. */
+    error = SD_PollingCardStatusBusy(card, SD_CARD_ACCESS_WAIT_IDLE_TIMEOUT);
+    if (kStatus_SDMMC_CardStatusIdle != error)
+    {
+        return kStatus_SDMMC_WaitWriteCompleteFailed;
+    }
+
+    command.index              = (uint32_t)kSD_SpeedClassControl;
+    command.argument           = (uint32_t)control << 28U;
+    command.responseType       = kCARD_ResponseTypeR1b;
+    command.responseErrorFlags = SDMMC_R1_ALL_ERROR_FLAG;
+
+    content.command = &command;
+    content.data    = NULL;
+    error           = SDMMCHOST_TransferFunction(card->host, &content);
+    if (kStatus_Success != error)
+    {
+        SDMMC_LOG("\r\nError: send CMD20 failed with host error %d, response %x\r\n", error, command.response[0U]);
+        return kStatus_SDMMC_TransferFailed;
+    }
+
+    error = SD_PollingCardStatusBusy(card, SD_CARD_ACCESS_WAIT_IDLE_TIMEOUT);
+    if (kStatus_SDMMC_CardStatusIdle != error)
+    {
+        return kStatus_SDMMC_WaitWriteCompleteFailed;
+    }
+
+    return kStatus_Success;
+}
+
 static status_t SD_GoIdle(sd_card_t *card)
 {
     assert(card != NULL);
@@ -356,8 +578,71 @@ static status_t SD_ExecuteTuning(sd_card_t *card)
 {
     assert(card != NULL);
 
-    return SDMMCHOST_ExecuteTuning(card->host, (uint32_t)kSD_SendTuningBlock,
-                                   (uint32_t *)FSL_SDMMC_CARD_INTERNAL_BUFFER_ALIGN_ADDR(card->internalBuffer), 64U);
+    status_t error;
+
+    /* the card ID of the key is set when reading CID */
+    card->host->tuningKey.busMode     = (uint32_t)card->currentTiming;
+    card->host->tuningKey.busClock_Hz = card->busClock_Hz;
+
+    SDMMC_INSTRUMENT_COUNT(&card->instrument, tuningEvents);
+    error = SDMMCHOST_ExecuteTuning(card->host, (uint32_t)kSD_SendTuningBlock,
+                                    (uint32_t *)FSL_SDMMC_CARD_INTERNAL_BUFFER_ALIGN_ADDR(card->internalBuffer), 64U);
+    if (error != kStatus_Success)
+    {
+        SDMMC_INSTRUMENT_COUNT(&card->instrument, tuningErrors);
+    }
+
+    return error;
+}
+
+static void SD_ScheduleReTuning(sd_card_t *card)
+{
+    if (((card->currentTiming != kSD_TimingSDR50Mode) && (card->currentTiming != kSD_TimingSDR104Mode)) ||
+        (!SDMMCHOST_IsReTuningRequest(card->host)))
+    {
+        return;
+    }
+
+    if (SD_ExecuteTuning(card) != kStatus_Success)
+    {
+        SDMMC_LOG("\r\nWarning: scheduled retuning failed.\r\n");
+        return;
+    }
+
+    card->reTuningStatistics.avoidedRetries++;
+}
+
+static void SD_BusGovernorApply(sd_card_t *card)
+{
+    sdmmc_bus_governor_t *governor = &card->busGovernor;
+    uint32_t retry                 = SDMMC_BUS_GOVERNOR_LEVEL_COUNT;
+
+    /* the tuning failure of the probed level steps down again */
+    while ((governor->level != governor->targetLevel) && (retry-- != 0U))
+    {
+        SDMMC_LOG("\r\nlog: bus governor switch to level %d.\r\n", governor->targetLevel);
+        card->busClock_Hz =
+            SDMMCHOST_SetCardClock(card->host, SDMMC_BUS_GOVERNOR_LEVEL_CLOCK(governor, governor->targetLevel));
+        SDMMC_BusGovernorSetLevel(governor, governor->targetLevel);
+
+        if (((card->currentTiming == kSD_TimingSDR50Mode) || (card->currentTiming == kSD_TimingSDR104Mode)) &&
+            (SD_ExecuteTuning(card) != kStatus_Success))
+        {
+            SDMMC_BusGovernorUpdate(governor, (uint32_t)kSDMMC_BusGovernorTuningError);
+        }
+    }
+}
+
+static void SD_WriteYield(sd_card_t *card)
+{
+    if (card->pendingReads == 0U)
+    {
+        return;
+    }
+
+    (void)SDMMC_OSAMutexUnlock(&card->lock);
+    SDMMC_WaitPendingReads(&card->pendingReads);
+    (void)SDMMC_OSAMutexLock(&card->lock, osaWaitForever_c);
 }
 
 static status_t SD_SwitchIOVoltage(sd_card_t *card, sdmmc_operation_voltage_t voltage)
@@ -487,15 +772,36 @@ static status_t SD_Transfer(sd_card_t *card, sdmmchost_transfer_t *content, uint
     assert(content != NULL);
     status_t error;
     uint32_t retuningCount = 3U;
+    uint32_t startCycles   = 0U;
+    bool isRetry           = false;
 
     do
     {
-        error = SDMMCHOST_TransferFunction(card->host, content);
+        /* the explicit CMD23 only applies to the following data command, send it again before the retry */
+        if (isRetry && (content->data != NULL) && (content->data->blockCount > 1U) &&
+            (!content->data->enableAutoCommand12) && (!content->data->enableAutoCommand23) &&
+            ((card->flags & (uint32_t)kSD_SupportSetBlockCountCmd) != 0U))
+        {
+            if (kStatus_Success != SDMMC_SetBlockCount(card->host, content->data->blockCount))
+            {
+                error = kStatus_SDMMC_SetBlockCountFailed;
+                break;
+            }
+        }
+        isRetry = true;
+
+        startCycles = SDMMC_INSTRUMENT_TIMESTAMP();
+        error       = SDMMCHOST_TransferFunction(card->host, content);
+        SDMMC_INSTRUMENT_TRANSFER(&card->instrument, content, error, startCycles);
         if (error == kStatus_Success)
         {
+            SDMMC_BusGovernorUpdate(&card->busGovernor, (uint32_t)kSDMMC_BusGovernorTransferSuccess);
             break;
         }
 
+        SDMMC_BusGovernorUpdate(&card->busGovernor, content->data != NULL ? (uint32_t)kSDMMC_BusGovernorDataError :
+                                                                             (uint32_t)kSDMMC_BusGovernorCommandError);
+
         /* if transfer data failed, send cmd12 to abort current transfer */
         if (content->data != NULL)
         {
@@ -517,10 +823,14 @@ static status_t SD_Transfer(sd_card_t *card, sdmmchost_transfer_t *content, uint
                 {
                     break;
                 }
+                card->reTuningStatistics.errorTuning++;
+                card->reTuningStatistics.transferRetries++;
+                SDMMC_INSTRUMENT_COUNT(&card->instrument, retries);
                 /* perform retuning */
                 if (SD_ExecuteTuning(card) != kStatus_Success)
                 {
                     error = kStatus_SDMMC_TuningFail;
+                    SDMMC_BusGovernorUpdate(&card->busGovernor, (uint32_t)kSDMMC_BusGovernorTuningError);
                     SDMMC_LOG("\r\nError: retuning failed.\r\n");
                     break;
                 }
@@ -535,6 +845,8 @@ static status_t SD_Transfer(sd_card_t *card, sdmmchost_transfer_t *content, uint
         if (retry != 0U)
         {
             retry--;
+            card->reTuningStatistics.transferRetries++;
+            SDMMC_INSTRUMENT_COUNT(&card->instrument, retries);
         }
         else
         {
@@ -595,6 +907,7 @@ status_t SD_PollingCardStatusBusy(sd_card_t *card, uint32_t timeoutMs)
     uint32_t statusTimeoutUs = timeoutMs * 1000U;
     bool cardBusy            = false;
     status_t error           = kStatus_SDMMC_CardStatusBusy;
+    uint32_t startCycles     = SDMMC_INSTRUMENT_TIMESTAMP();
 
     do
     {
@@ -616,9 +929,32 @@ status_t SD_PollingCardStatusBusy(sd_card_t *card, uint32_t timeoutMs)
 
     } while (statusTimeoutUs != 0U);
 
+    SDMMC_INSTRUMENT_BUSY_WAIT(&card->instrument, startCycles);
+
     return error;
 }
 
+#if SDMMC_ENABLE_INSTRUMENTATION
+void SD_GetInstrumentation(sd_card_t *card, sdmmc_instrument_t *instrument)
+{
+    assert(card != NULL);
+    assert(instrument != NULL);
+
+    (void)SDMMC_OSAMutexLock(&card->lock, osaWaitForever_c);
+    (void)memcpy(instrument, &card->instrument, sizeof(sdmmc_instrument_t));
+    (void)SDMMC_OSAMutexUnlock(&card->lock);
+}
+
+void SD_ResetInstrumentation(sd_card_t *card)
+{
+    assert(card != NULL);
+
+    (void)SDMMC_OSAMutexLock(&card->lock, osaWaitForever_c);
+    SDMMC_InstrumentReset(&card->instrument);
+    (void)SDMMC_OSAMutexUnlock(&card->lock);
+}
+#endif
+
 static status_t SD_SendWriteSuccessBlocks(sd_card_t *card, uint32_t *blocks)
 {
     assert(card != NULL);
@@ -665,6 +1001,36 @@ static status_t SD_SendWriteSuccessBlocks(sd_card_t *card, uint32_t *blocks)
     return error;
 }
 
+static status_t SD_SetWriteBlockEraseCount(sd_card_t *card, uint32_t blockCount)
+{
+    assert(card != NULL);
+
+    sdmmchost_transfer_t content = {0};
+    sdmmchost_cmd_t command      = {0};
+    status_t error               = kStatus_Success;
+
+    if (kStatus_Success != SD_SendApplicationCmd(card, card->relativeAddress))
+    {
+        return kStatus_SDMMC_SendApplicationCommandFailed;
+    }
+
+    command.index              = (uint32_t)kSD_ApplicationSetWriteBlockEraseCount;
+    command.argument           = blockCount & 0x7FFFFFU;
+    command.responseType       = kCARD_ResponseTypeR1;
+    command.responseErrorFlags = SDMMC_R1_ALL_ERROR_FLAG;
+
+    content.command = &command;
+    content.data    = NULL;
+    error           = SDMMCHOST_TransferFunction(card->host, &content);
+    if (kStatus_Success != error)
+    {
+        SDMMC_LOG("\r\nError: send ACMD23 failed with host error %d, response %x\r\n", error, command.response[0U]);
+        return kStatus_SDMMC_TransferFailed;
+    }
+
+    return kStatus_Success;
+}
+
 static status_t SD_SendRca(sd_card_t *card)
 {
     assert(card != NULL);
@@ -724,6 +1090,17 @@ static status_t SD_SwitchFunction(sd_card_t *card, uint32_t mode, uint32_t group
     return error;
 }
 
+static void SD_UpdateSnapshotRegister(sd_register_snapshot_t *snapshot,
+                                      uint32_t *snapshotRegister,
+                                      const uint8_t *rawRegister)
+{
+    if (memcmp(snapshotRegister, rawRegister, 16U) != 0)
+    {
+        snapshot->magic = 0U;
+        (void)memcpy(snapshotRegister, rawRegister, 16U);
+    }
+}
+
 static void SD_DecodeScr(sd_card_t *card, uint32_t *rawScr)
 {
     assert(card != NULL);
@@ -1123,6 +1500,7 @@ static status_t SD_AllSendCid(sd_card_t *card)
     if (kStatus_Success == error)
     {
         (void)memcpy(card->internalBuffer, (uint8_t *)command.response, 16U);
+        (void)memcpy(card->host->tuningKey.cardId, (uint8_t *)command.response, 16U);
         SD_DecodeCid(card, (uint32_t *)(uint32_t)card->internalBuffer);
 
         error = kStatus_Success;
@@ -1369,6 +1747,8 @@ static void SD_DecodeStatus(sd_card_t *card, uint32_t *src)
     card->stat.eraseOffset   = ((uint8_t)((src[3U] & 0x00FF0000U) >> 16U)) & 0x3U;                         /* 401-400 */
     card->stat.uhsSpeedGrade = (((uint8_t)((src[3U] & 0x0000FF00U) >> 8U)) & 0xF0U) >> 4U;                 /* 399-396 */
     card->stat.uhsAuSize     = ((uint8_t)((src[3U] & 0x0000FF00U) >> 8U)) & 0xFU;                          /* 395-392 */
+    card->stat.discardSupport = (uint8_t)((src[6U] & 0x02000000U) >> 25U);                                /* 313 */
+    card->stat.fuleSupport    = (uint8_t)((src[6U] & 0x01000000U) >> 24U);                                /* 312 */
 }
 
 status_t SD_ReadStatus(sd_card_t *card)
@@ -1467,18 +1847,26 @@ static status_t SD_Read(sd_card_t *card, uint8_t *buffer, uint32_t startBlock, u
         return kStatus_SDMMC_CardNotSupport;
     }
 
-    /* read command are not allowed while card is programming */
-    error = SD_PollingCardStatusBusy(card, SD_CARD_ACCESS_WAIT_IDLE_TIMEOUT);
-    if (kStatus_SDMMC_CardStatusIdle != error)
+    /* read command are not allowed while card is programming, but the card cannot enter programming state by read, so
+     * the CMD13 polling is skipped when no other command is sent since the last read and DAT0 is not busy */
+    if ((!card->isReadIdle) || (card->readIdleSequence != card->host->transferSequence) ||
+        SDMMCHOST_IsCardBusy(card->host))
     {
-        SDMMC_LOG("Error : read failed with wrong card busy\r\n");
-        return kStatus_SDMMC_PollingCardIdleFailed;
+        error = SD_PollingCardStatusBusy(card, SD_CARD_ACCESS_WAIT_IDLE_TIMEOUT);
+        if (kStatus_SDMMC_CardStatusIdle != error)
+        {
+            SDMMC_LOG("Error : read failed with wrong card busy\r\n");
+            return kStatus_SDMMC_PollingCardIdleFailed;
+        }
     }
+    card->isReadIdle = false;
 
-    data.blockSize           = blockSize;
-    data.blockCount          = blockCount;
-    data.rxData              = (uint32_t *)(uint32_t)buffer;
-    data.enableAutoCommand12 = true;
+    SD_BusGovernorApply(card);
+    SD_ScheduleReTuning(card);
+
+    data.blockSize  = blockSize;
+    data.blockCount = blockCount;
+    data.rxData     = (uint32_t *)(uint32_t)buffer;
 
     command.index    = (blockCount == 1U) ? (uint32_t)kSDMMC_ReadSingleBlock : (uint32_t)kSDMMC_ReadMultipleBlock;
     command.argument = startBlock;
@@ -1492,12 +1880,21 @@ static status_t SD_Read(sd_card_t *card, uint8_t *buffer, uint32_t startBlock, u
     content.command = &command;
     content.data    = &data;
 
+    error = SD_SetTransferStopMode(card, &data);
+    if (error != kStatus_Success)
+    {
+        return error;
+    }
+
     error = SD_Transfer(card, &content, 3U);
     if (error != kStatus_Success)
     {
         return error;
     }
 
+    card->isReadIdle       = true;
+    card->readIdleSequence = card->host->transferSequence;
+
     return kStatus_Success;
 }
 
@@ -1533,7 +1930,18 @@ static status_t SD_Write(sd_card_t *card,
         return kStatus_SDMMC_PollingCardIdleFailed;
     }
 
-    data.enableAutoCommand12   = true;
+    SD_BusGovernorApply(card);
+    SD_ScheduleReTuning(card);
+
+    /* pre-erase is a hint to the card only, the write continues if the card reject it */
+    if ((blockCount > 1U) && (card->preErasePolicy == kSD_PreEraseMultipleBlock))
+    {
+        if (kStatus_Success != SD_SetWriteBlockEraseCount(card, blockCount))
+        {
+            SDMMC_LOG("\r\nWarning: pre-erase %d blocks failed\r\n", blockCount);
+        }
+    }
+
     data.blockSize             = blockSize;
     command.responseType       = kCARD_ResponseTypeR1;
     command.responseErrorFlags = SDMMC_R1_ALL_ERROR_FLAG;
@@ -1552,6 +1960,12 @@ static status_t SD_Write(sd_card_t *card,
     content.command = &command;
     content.data    = &data;
 
+    error = SD_SetTransferStopMode(card, &data);
+    if (error != kStatus_Success)
+    {
+        return error;
+    }
+
     error = SD_Transfer(card, &content, 3U);
     if (error != kStatus_Success)
     {
@@ -1571,7 +1985,8 @@ static status_t SD_Write(sd_card_t *card,
     return error;
 }
 
-static status_t SD_Erase(sd_card_t *card, uint32_t startBlock, uint32_t blockCount, uint32_t timeout)
+static status_t SD_Erase(
+    sd_card_t *card, uint32_t startBlock, uint32_t blockCount, uint32_t timeout, sd_erase_argument_t argument)
 {
     assert(card != NULL);
     assert(blockCount != 0U);
@@ -1631,7 +2046,7 @@ static status_t SD_Erase(sd_card_t *card, uint32_t startBlock, uint32_t blockCou
 
     /* Send ERASE command to start erase process. */
     command.index              = (uint32_t)kSDMMC_Erase;
-    command.argument           = 0U;
+    command.argument           = (uint32_t)argument;
     command.responseType       = kCARD_ResponseTypeR1b;
     command.responseErrorFlags = SDMMC_R1_ALL_ERROR_FLAG;
 
@@ -1677,9 +2092,19 @@ status_t SD_ReadBlocks(sd_card_t *card, uint8_t *buffer, uint32_t startBlock, ui
     uint8_t *nextBuffer        = buffer;
     bool dataAddrAlign         = true;
     uint8_t *alignBuffer       = (uint8_t *)FSL_SDMMC_CARD_INTERNAL_BUFFER_ALIGN_ADDR(card->internalBuffer);
+    uint32_t alignBlocks       = 1U;
     status_t error             = kStatus_Success;
 
+    /* the latency bounded write yields the lock to the pending read */
+    SDMMC_UpdatePendingReads(&card->pendingReads, true);
     (void)SDMMC_OSAMutexLock(&card->lock, osaWaitForever_c);
+    SDMMC_UpdatePendingReads(&card->pendingReads, false);
+
+    if ((card->alignBuffer != NULL) && (card->alignBufferSize >= FSL_SDMMC_DEFAULT_BLOCK_SIZE))
+    {
+        alignBuffer = card->alignBuffer;
+        alignBlocks = card->alignBufferSize / FSL_SDMMC_DEFAULT_BLOCK_SIZE;
+    }
 
     blockLeft = blockCount;
 
@@ -1688,8 +2113,13 @@ status_t SD_ReadBlocks(sd_card_t *card, uint8_t *buffer, uint32_t startBlock, ui
         nextBuffer = (uint8_t *)((uint32_t)buffer + blockDone * FSL_SDMMC_DEFAULT_BLOCK_SIZE);
         if ((!card->noInteralAlign) && (!dataAddrAlign || ((((uint32_t)nextBuffer) & (sizeof(uint32_t) - 1U)) != 0U)))
         {
-            blockCountOneTime = 1;
-            (void)memset(alignBuffer, 0, FSL_SDMMC_DEFAULT_BLOCK_SIZE);
+            /* transfer as many blocks as the exchange buffer can hold per command */
+            blockCountOneTime = blockLeft > alignBlocks ? alignBlocks : blockLeft;
+            if (blockCountOneTime > card->host->maxBlockCount)
+            {
+                blockCountOneTime = card->host->maxBlockCount;
+            }
+            (void)memset(alignBuffer, 0, blockCountOneTime * FSL_SDMMC_DEFAULT_BLOCK_SIZE);
             dataAddrAlign = false;
             blockLeft -= blockCountOneTime;
         }
@@ -1719,7 +2149,7 @@ status_t SD_ReadBlocks(sd_card_t *card, uint8_t *buffer, uint32_t startBlock, ui
 
         if (!card->noInteralAlign && (!dataAddrAlign))
         {
-            (void)memcpy(nextBuffer, alignBuffer, FSL_SDMMC_DEFAULT_BLOCK_SIZE);
+            (void)memcpy(nextBuffer, alignBuffer, blockCountOneTime * FSL_SDMMC_DEFAULT_BLOCK_SIZE);
         }
     }
 
@@ -1728,22 +2158,33 @@ status_t SD_ReadBlocks(sd_card_t *card, uint8_t *buffer, uint32_t startBlock, ui
     return error;
 }
 
-status_t SD_WriteBlocks(sd_card_t *card, const uint8_t *buffer, uint32_t startBlock, uint32_t blockCount)
+static status_t SD_WriteDataBlocks(sd_card_t *card,
+                                   const uint8_t *buffer,
+                                   uint32_t startBlock,
+                                   uint32_t blockCount,
+                                   bool enableYield)
 {
-    assert(card != NULL);
-    assert(buffer != NULL);
-    assert(blockCount != 0U);
-    assert((blockCount + startBlock) <= card->blockCount);
-
     uint32_t blockCountOneTime   = 0U; /* The block count can be wrote in one time sending WRITE_BLOCKS command. */
     uint32_t blockWrittenOneTime = 0U;
     uint32_t blockLeft           = 0U; /* Left block count to be wrote. */
     const uint8_t *nextBuffer;
     bool dataAddrAlign   = true;
     uint8_t *alignBuffer = (uint8_t *)FSL_SDMMC_CARD_INTERNAL_BUFFER_ALIGN_ADDR(card->internalBuffer);
+    uint32_t alignBlocks = 1U;
+    uint32_t maxBlocks   = card->host->maxBlockCount;
     status_t error       = kStatus_Success;
 
-    (void)SDMMC_OSAMutexLock(&card->lock, osaWaitForever_c);
+    if ((card->alignBuffer != NULL) && (card->alignBufferSize >= FSL_SDMMC_DEFAULT_BLOCK_SIZE))
+    {
+        alignBuffer = card->alignBuffer;
+        alignBlocks = card->alignBufferSize / FSL_SDMMC_DEFAULT_BLOCK_SIZE;
+    }
+
+    /* the latency bounded write caps each command at the chunk */
+    if ((card->writeChunkBlocks != 0U) && (card->writeChunkBlocks < maxBlocks))
+    {
+        maxBlocks = card->writeChunkBlocks;
+    }
 
     blockLeft = blockCount;
     while (blockLeft != 0U)
@@ -1751,15 +2192,20 @@ status_t SD_WriteBlocks(sd_card_t *card, const uint8_t *buffer, uint32_t startBl
         nextBuffer = (uint8_t *)((uint32_t)buffer + (blockCount - blockLeft) * FSL_SDMMC_DEFAULT_BLOCK_SIZE);
         if (!card->noInteralAlign && (!dataAddrAlign || ((((uint32_t)nextBuffer) & (sizeof(uint32_t) - 1U)) != 0U)))
         {
-            blockCountOneTime = 1;
-            (void)memcpy(alignBuffer, nextBuffer, FSL_SDMMC_DEFAULT_BLOCK_SIZE);
+            /* transfer as many blocks as the exchange buffer can hold per command */
+            blockCountOneTime = blockLeft > alignBlocks ? alignBlocks : blockLeft;
+            if (blockCountOneTime > maxBlocks)
+            {
+                blockCountOneTime = maxBlocks;
+            }
+            (void)memcpy(alignBuffer, nextBuffer, blockCountOneTime * FSL_SDMMC_DEFAULT_BLOCK_SIZE);
             dataAddrAlign = false;
         }
         else
         {
-            if (blockLeft > card->host->maxBlockCount)
+            if (blockLeft > maxBlocks)
             {
-                blockCountOneTime = card->host->maxBlockCount;
+                blockCountOneTime = maxBlocks;
             }
             else
             {
@@ -1779,15 +2225,156 @@ status_t SD_WriteBlocks(sd_card_t *card, const uint8_t *buffer, uint32_t startBl
 
         if ((!card->noInteralAlign) && !dataAddrAlign)
         {
-            (void)memset(alignBuffer, 0, FSL_SDMMC_DEFAULT_BLOCK_SIZE);
+            (void)memset(alignBuffer, 0, blockCountOneTime * FSL_SDMMC_DEFAULT_BLOCK_SIZE);
+        }
+
+        if (enableYield && (card->writeChunkBlocks != 0U) && (blockLeft != 0U))
+        {
+            SD_WriteYield(card);
         }
     }
 
+    return error;
+}
+
+status_t SD_WriteBlocks(sd_card_t *card, const uint8_t *buffer, uint32_t startBlock, uint32_t blockCount)
+{
+    assert(card != NULL);
+    assert(buffer != NULL);
+    assert(blockCount != 0U);
+    assert((blockCount + startBlock) <= card->blockCount);
+
+    status_t error = kStatus_Success;
+
+    (void)SDMMC_OSAMutexLock(&card->lock, osaWaitForever_c);
+
+    error = SD_WriteDataBlocks(card, buffer, startBlock, blockCount, true);
+
     (void)SDMMC_OSAMutexUnlock(&card->lock);
 
     return error;
 }
 
+static void SD_AsyncTransferCallback(sdmmchost_t *host, status_t status, void *userData)
+{
+    sd_card_t *card = (sd_card_t *)userData;
+
+    if (card->transferCallback != NULL)
+    {
+        card->transferCallback(card, status == kStatus_Success ? kStatus_Success : kStatus_SDMMC_TransferFailed,
+                               card->transferUserData);
+    }
+}
+
+static status_t SD_TransferAsync(sd_card_t *card,
+                                 uint8_t *rxBuffer,
+                                 const uint8_t *txBuffer,
+                                 uint32_t startBlock,
+                                 uint32_t blockCount,
+                                 sd_transfer_callback_t callback,
+                                 void *userData)
+{
+    const uint8_t *buffer = rxBuffer == NULL ? txBuffer : rxBuffer;
+    status_t error        = kStatus_Success;
+
+    /* there is no internal buffer exchange for asynchronous transfer */
+    if ((blockCount > card->host->maxBlockCount) || ((((uint32_t)buffer) & (sizeof(uint32_t) - 1U)) != 0U))
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    (void)SDMMC_OSAMutexLock(&card->lock, osaWaitForever_c);
+
+    /* polling card status idle, the ongoing asynchronous transfer will be waited in host */
+    error = SD_PollingCardStatusBusy(card, SD_CARD_ACCESS_WAIT_IDLE_TIMEOUT);
+    if (kStatus_SDMMC_CardStatusIdle != error)
+    {
+        SDMMC_LOG("Error : asynchronous transfer failed, card status busy\r\n");
+        error = kStatus_SDMMC_PollingCardIdleFailed;
+    }
+    else
+    {
+        SD_BusGovernorApply(card);
+        SD_ScheduleReTuning(card);
+
+        (void)memset(&card->asyncCommand, 0, sizeof(sdmmchost_cmd_t));
+        (void)memset(&card->asyncData, 0, sizeof(sdmmchost_data_t));
+
+        card->asyncData.blockSize           = FSL_SDMMC_DEFAULT_BLOCK_SIZE;
+        card->asyncData.blockCount          = blockCount;
+        card->asyncData.rxData              = (uint32_t *)(uint32_t)rxBuffer;
+        card->asyncData.txData              = (const uint32_t *)(uint32_t)txBuffer;
+
+        if (rxBuffer != NULL)
+        {
+            card->asyncCommand.index =
+                (blockCount == 1U) ? (uint32_t)kSDMMC_ReadSingleBlock : (uint32_t)kSDMMC_ReadMultipleBlock;
+        }
+        else
+        {
+            card->asyncCommand.index =
+                (blockCount == 1U) ? (uint32_t)kSDMMC_WriteSingleBlock : (uint32_t)kSDMMC_WriteMultipleBlock;
+        }
+        card->asyncCommand.argument = startBlock;
+        if (0U == (card->flags & (uint32_t)kSD_SupportHighCapacityFlag))
+        {
+            card->asyncCommand.argument *= FSL_SDMMC_DEFAULT_BLOCK_SIZE;
+        }
+        card->asyncCommand.responseType       = kCARD_ResponseTypeR1;
+        card->asyncCommand.responseErrorFlags = SDMMC_R1_ALL_ERROR_FLAG;
+
+        card->asyncContent.command = &card->asyncCommand;
+        card->asyncContent.data    = &card->asyncData;
+
+        card->transferCallback = callback;
+        card->transferUserData = userData;
+
+        error = SD_SetTransferStopMode(card, &card->asyncData);
+        if (kStatus_Success == error)
+        {
+            error = SDMMCHOST_TransferAsync(card->host, &card->asyncContent, SD_AsyncTransferCallback, card);
+            if ((kStatus_Success != error) && (kStatus_InvalidArgument != error))
+            {
+                error = kStatus_SDMMC_TransferFailed;
+            }
+        }
+    }
+
+    (void)SDMMC_OSAMutexUnlock(&card->lock);
+
+    return error;
+}
+
+status_t SD_ReadBlocksAsync(sd_card_t *card,
+                            uint8_t *buffer,
+                            uint32_t startBlock,
+                            uint32_t blockCount,
+                            sd_transfer_callback_t callback,
+                            void *userData)
+{
+    assert(card != NULL);
+    assert(buffer != NULL);
+    assert(blockCount != 0U);
+    assert((blockCount + startBlock) <= card->blockCount);
+
+    return SD_TransferAsync(card, buffer, NULL, startBlock, blockCount, callback, userData);
+}
+
+status_t SD_WriteBlocksAsync(sd_card_t *card,
+                             const uint8_t *buffer,
+                             uint32_t startBlock,
+                             uint32_t blockCount,
+                             sd_transfer_callback_t callback,
+                             void *userData)
+{
+    assert(card != NULL);
+    assert(buffer != NULL);
+    assert(blockCount != 0U);
+    assert((blockCount + startBlock) <= card->blockCount);
+
+    return SD_TransferAsync(card, NULL, buffer, startBlock, blockCount, callback, userData);
+}
+
 status_t SD_EraseBlocks(sd_card_t *card, uint32_t startBlock, uint32_t blockCount)
 {
     assert(card != NULL);
@@ -1810,23 +2397,14 @@ status_t SD_EraseBlocks(sd_card_t *card, uint32_t startBlock, uint32_t blockCoun
         /* sdsc card erasable sector is determined by CSD register */
         if ((card->csd.flags & kSD_CsdEraseBlockEnabledFlag) != 0U)
         {
-            error = SD_Erase(card, startBlock, blockCount, 250U * blockCount);
+            error = SD_Erase(card, startBlock, blockCount, 250U * blockCount, kSD_EraseArgument);
         }
         SDMMC_LOG("\r\n erase block directly: total %d, start %d, timeout %d, status %d \r\n", blockCount, startBlock,
                   250U * blockCount, error);
     }
     else
     {
-        /* UHS card should use uhs au size field */
-        if (card->operationVoltage == kSDMMC_OperationVoltage180V)
-        {
-            auBlocks = s_sdAuSizeMap[card->stat.uhsAuSize == 0U ? card->stat.auSize : card->stat.uhsAuSize] /
-                       FSL_SDMMC_DEFAULT_BLOCK_SIZE;
-        }
-        else
-        {
-            auBlocks = s_sdAuSizeMap[card->stat.auSize] / FSL_SDMMC_DEFAULT_BLOCK_SIZE;
-        }
+        auBlocks = SD_GetAuBlocks(card);
 
         auTimeout = (((uint32_t)card->stat.eraseTimeout * 1000U) / (uint32_t)card->stat.eraseSize) +
                     card->stat.eraseOffset * 1000U;
@@ -1834,7 +2412,7 @@ status_t SD_EraseBlocks(sd_card_t *card, uint32_t startBlock, uint32_t blockCoun
         /* erase blocks within one AU */
         if ((startBlock + blockCount) < (startBlock / auBlocks + 1U) * auBlocks)
         {
-            error = SD_Erase(card, startBlock, blockCount, auTimeout + 500U);
+            error = SD_Erase(card, startBlock, blockCount, auTimeout + 500U, kSD_EraseArgument);
 
             SDMMC_LOG("\r\n erase blockS within AU : total %d, start %d, timeout %d, status %d \r\n", blockCount,
                       startBlock, auTimeout + 500U, error);
@@ -1845,7 +2423,7 @@ status_t SD_EraseBlocks(sd_card_t *card, uint32_t startBlock, uint32_t blockCoun
             if ((startBlock % auBlocks) != 0U)
             {
                 blockCountOneTime = (startBlock / auBlocks + 1U) * auBlocks - startBlock;
-                error             = SD_Erase(card, startBlock, blockCountOneTime, auTimeout + 250U);
+                error = SD_Erase(card, startBlock, blockCountOneTime, auTimeout + 250U, kSD_EraseArgument);
 
                 SDMMC_LOG("\r\n erase partially block head : total %d, start %d, timeout %d, status %d \r\n",
                           blockCountOneTime, startBlock, auTimeout + 250U, error);
@@ -1879,7 +2457,8 @@ status_t SD_EraseBlocks(sd_card_t *card, uint32_t startBlock, uint32_t blockCoun
                         blockLeft         = 0U;
                     }
 
-                    error = SD_Erase(card, blockHead, blockCountOneTime, (blockCountOneTime / auBlocks) * auTimeout);
+                    error = SD_Erase(card, blockHead, blockCountOneTime, (blockCountOneTime / auBlocks) * auTimeout,
+                                     kSD_EraseArgument);
                     SDMMC_LOG("\r\n erase AU block head : total %d, start %d, timeout %d, status %d \r\n",
                               blockCountOneTime, blockHead, (blockCountOneTime / auBlocks) * auTimeout, error);
                     if (error != kStatus_Success)
@@ -1894,7 +2473,7 @@ status_t SD_EraseBlocks(sd_card_t *card, uint32_t startBlock, uint32_t blockCoun
             /* Erase partially end block */
             if ((error == kStatus_Success) && (blockTail))
             {
-                error = SD_Erase(card, blockHead, blockTail, auTimeout + 250U);
+                error = SD_Erase(card, blockHead, blockTail, auTimeout + 250U, kSD_EraseArgument);
                 SDMMC_LOG("\r\n erase partially tail block : total %d, start %d, timeout %d, status %d \r\n", blockTail,
                           blockHead, auTimeout + 250U, error);
             }
@@ -1906,6 +2485,166 @@ status_t SD_EraseBlocks(sd_card_t *card, uint32_t startBlock, uint32_t blockCoun
     return error;
 }
 
+status_t SD_DiscardBlocks(sd_card_t *card, uint32_t startBlock, uint32_t blockCount)
+{
+    assert(card != NULL);
+    assert(blockCount != 0U);
+    assert((blockCount + startBlock) <= card->blockCount);
+
+    status_t error = kStatus_Success;
+
+    if (card->stat.discardSupport == 0U)
+    {
+        return kStatus_SDMMC_NotSupportYet;
+    }
+
+    (void)SDMMC_OSAMutexLock(&card->lock, osaWaitForever_c);
+
+    /* the card only marks the blocks as unused, so the busy time doesn't depend on the number of blocks */
+    error = SD_Erase(card, startBlock, blockCount, SD_CARD_DISCARD_TIMEOUT, kSD_DiscardArgument);
+
+    SDMMC_LOG("\r\n discard blocks : total %d, start %d, status %d \r\n", blockCount, startBlock, error);
+
+    (void)SDMMC_OSAMutexUnlock(&card->lock);
+
+    return error;
+}
+
+status_t SD_FullUserAreaLogicalErase(sd_card_t *card)
+{
+    assert(card != NULL);
+
+    status_t error = kStatus_Success;
+
+    if (card->stat.fuleSupport == 0U)
+    {
+        return kStatus_SDMMC_NotSupportYet;
+    }
+
+    (void)SDMMC_OSAMutexLock(&card->lock, osaWaitForever_c);
+
+    /* the erase range is ignored by the card for FULE, set it to the whole user area anyway */
+    error = SD_Erase(card, 0U, card->blockCount, SD_CARD_FULE_TIMEOUT, kSD_FuleArgument);
+
+    (void)SDMMC_OSAMutexUnlock(&card->lock);
+
+    return error;
+}
+
+status_t SD_StartRecording(sd_card_t *card, uint32_t startBlock, uint32_t blockCount)
+{
+    assert(card != NULL);
+    assert(blockCount != 0U);
+    assert((blockCount + startBlock) <= card->blockCount);
+
+    status_t error     = kStatus_Success;
+    uint32_t auBlocks  = 0U;
+    uint32_t areaStart = 0U;
+    uint32_t areaEnd   = 0U;
+
+    (void)SDMMC_OSAMutexLock(&card->lock, osaWaitForever_c);
+
+    auBlocks = SD_GetAuBlocks(card);
+    if (auBlocks == 0U)
+    {
+        error = kStatus_SDMMC_CardNotSupport;
+    }
+    else
+    {
+        /* shrink the recording area to whole AUs */
+        areaStart = ((startBlock + auBlocks - 1U) / auBlocks) * auBlocks;
+        areaEnd   = ((startBlock + blockCount) / auBlocks) * auBlocks;
+        if (areaEnd <= areaStart)
+        {
+            error = kStatus_InvalidArgument;
+        }
+    }
+
+    if ((kStatus_Success == error) && ((card->flags & (uint32_t)kSD_SupportSpeedClassControlCmd) != 0U))
+    {
+        error = SD_SpeedClassControl(card, kSD_SpeedClassStartRecording);
+    }
+
+    if (kStatus_Success == error)
+    {
+        card->recording.startBlock  = areaStart;
+        card->recording.endBlock    = areaEnd;
+        card->recording.auBlocks    = auBlocks;
+        card->recording.writeBlock  = areaStart;
+        card->recording.isRecording = true;
+    }
+
+    (void)SDMMC_OSAMutexUnlock(&card->lock);
+
+    return error;
+}
+
+status_t SD_WriteRecording(sd_card_t *card, const uint8_t *buffer, uint32_t blockCount)
+{
+    assert(card != NULL);
+    assert(buffer != NULL);
+    assert(blockCount != 0U);
+
+    status_t error             = kStatus_Success;
+    uint32_t blockCountOneTime = 0U;
+    uint32_t auLeft            = 0U;
+
+    /* the lock is held for the whole write, so the write pointer is not raced by another writer or the stop */
+    (void)SDMMC_OSAMutexLock(&card->lock, osaWaitForever_c);
+
+    if (!card->recording.isRecording)
+    {
+        error = kStatus_InvalidArgument;
+    }
+    else if ((card->recording.endBlock - card->recording.writeBlock) < blockCount)
+    {
+        error = kStatus_OutOfRange;
+    }
+    else
+    {
+        while (blockCount != 0U)
+        {
+            /* one write command should not cross the AU boundary */
+            auLeft            = card->recording.auBlocks - (card->recording.writeBlock % card->recording.auBlocks);
+            blockCountOneTime = blockCount > auLeft ? auLeft : blockCount;
+
+            error = SD_WriteDataBlocks(card, buffer, card->recording.writeBlock, blockCountOneTime, false);
+            if (kStatus_Success != error)
+            {
+                break;
+            }
+
+            card->recording.writeBlock += blockCountOneTime;
+            buffer += blockCountOneTime * FSL_SDMMC_DEFAULT_BLOCK_SIZE;
+            blockCount -= blockCountOneTime;
+        }
+    }
+
+    (void)SDMMC_OSAMutexUnlock(&card->lock);
+
+    return error;
+}
+
+status_t SD_StopRecording(sd_card_t *card)
+{
+    assert(card != NULL);
+
+    status_t error = kStatus_Success;
+
+    (void)SDMMC_OSAMutexLock(&card->lock, osaWaitForever_c);
+
+    if (card->recording.isRecording && ((card->flags & (uint32_t)kSD_SupportSpeedClassControlCmd) != 0U))
+    {
+        error = SD_SpeedClassControl(card, kSD_SpeedClassEndRecording);
+    }
+
+    card->recording.isRecording = false;
+
+    (void)SDMMC_OSAMutexUnlock(&card->lock);
+
+    return error;
+}
+
 static status_t SD_ProbeBusVoltage(sd_card_t *card)
 {
     assert(card != NULL);
@@ -2008,10 +2747,14 @@ static status_t sdcard_init(sd_card_t *card)
 {
     assert(card != NULL);
     assert(card->isHostReady == true);
-    status_t error = kStatus_Success;
+    status_t error                   = kStatus_Success;
+    sd_register_snapshot_t *snapshot = card->registerSnapshot;
+    bool isRestore                   = false;
 
     /* reset variables */
-    card->flags = 0U;
+    card->flags                 = 0U;
+    card->isReadIdle            = false;
+    card->recording.isRecording = false;
     /* set DATA bus width */
     SDMMCHOST_SetCardBusWidth(card->host, kSDMMC_BusWdith1Bit);
     /*set card freq to 400KHZ*/
@@ -2031,6 +2774,11 @@ static status_t sdcard_init(sd_card_t *card)
         return kStatus_SDMMC_AllSendCidFailed;
     }
 
+    if (snapshot != NULL)
+    {
+        SD_UpdateSnapshotRegister(snapshot, snapshot->rawCid, card->internalBuffer);
+    }
+
     error = SD_SendRca(card);
     if (kStatus_Success != error)
     {
@@ -2043,6 +2791,13 @@ static status_t sdcard_init(sd_card_t *card)
         return kStatus_SDMMC_SendCsdFailed;
     }
 
+    if (snapshot != NULL)
+    {
+        SD_UpdateSnapshotRegister(snapshot, snapshot->rawCsd, card->internalBuffer);
+        isRestore =
+            (snapshot->magic == SD_REGISTER_SNAPSHOT_MAGIC) && (snapshot->driverVersion == FSL_SD_DRIVER_VERSION);
+    }
+
     error = SD_SelectCard(card, true);
     if (kStatus_Success != error)
     {
@@ -2052,10 +2807,21 @@ static status_t sdcard_init(sd_card_t *card)
     /* Set to max frequency in non-high speed mode. */
     card->busClock_Hz = SDMMCHOST_SetCardClock(card->host, SD_CLOCK_25MHZ);
 
-    error = SD_SendScr(card);
-    if (kStatus_Success != error)
+    if (isRestore)
+    {
+        /* the same card is initialized before, restore the SCR and SD status from the snapshot */
+        card->scr     = snapshot->scr;
+        card->stat    = snapshot->stat;
+        card->version = snapshot->version;
+        card->flags |= snapshot->flags | (uint32_t)kSD_RegisterSnapshotRestoredFlag;
+    }
+    else
     {
-        return kStatus_SDMMC_SendScrFailed;
+        error = SD_SendScr(card);
+        if (kStatus_Success != error)
+        {
+            return kStatus_SDMMC_SendScrFailed;
+        }
     }
 
     /* Set to 4-bit data bus mode. */
@@ -2069,11 +2835,14 @@ static status_t sdcard_init(sd_card_t *card)
         SDMMCHOST_SetCardBusWidth(card->host, kSDMMC_BusWdith4Bit);
     }
 
-    /* try to get card current status */
-    error = SD_ReadStatus(card);
-    if (kStatus_Success != error)
+    if (!isRestore)
     {
-        return kStatus_SDMMC_SendScrFailed;
+        /* try to get card current status */
+        error = SD_ReadStatus(card);
+        if (kStatus_Success != error)
+        {
+            return kStatus_SDMMC_SendScrFailed;
+        }
     }
 
     error = SD_SetBlockSize(card, FSL_SDMMC_DEFAULT_BLOCK_SIZE);
@@ -2090,6 +2859,16 @@ static status_t sdcard_init(sd_card_t *card)
         return kStatus_SDMMC_SwitchBusTimingFailed;
     }
 
+    if ((snapshot != NULL) && (!isRestore))
+    {
+        snapshot->scr           = card->scr;
+        snapshot->stat          = card->stat;
+        snapshot->version       = card->version;
+        snapshot->flags         = card->flags & SD_REGISTER_SNAPSHOT_FLAGS;
+        snapshot->driverVersion = FSL_SD_DRIVER_VERSION;
+        snapshot->magic         = SD_REGISTER_SNAPSHOT_MAGIC;
+    }
+
     return kStatus_Success;
 }
 
@@ -2104,7 +2883,19 @@ status_t SD_CardInit(sd_card_t *card)
 
     SD_SetCardPower(card, true);
 
+    (void)memset(&card->reTuningStatistics, 0, sizeof(card->reTuningStatistics));
+    card->pendingReads = 0U;
+#if SDMMC_ENABLE_INSTRUMENTATION
+    SDMMC_InstrumentReset(&card->instrument);
+#endif
+    SDMMC_BusGovernorReset(&card->busGovernor, 0U);
     error = sdcard_init(card);
+    if ((error == kStatus_Success) &&
+        ((card->currentTiming == kSD_TimingSDR50Mode) || (card->currentTiming == kSD_TimingSDR104Mode)))
+    {
+        /* step the bus clock of the tuned timing down on the repeated errors instead of the retry storm */
+        SDMMC_BusGovernorReset(&card->busGovernor, card->busClock_Hz);
+    }
 
     (void)SDMMC_OSAMutexUnlock(&card->lock);
 
@@ -20,28 +20,73 @@
  * Definitions
  ******************************************************************************/
 /*! @brief Driver version. */
-#define FSL_SD_DRIVER_VERSION (MAKE_VERSION(2U, 4U, 2U)) /*2.4.2*/
+#define FSL_SD_DRIVER_VERSION (MAKE_VERSION(2U, 5U, 0U)) /*2.5.0*/
 
 /*! @brief SD card flags
  * @anchor _sd_card_flag
  */
 enum
 {
-    kSD_SupportHighCapacityFlag     = (1U << 1U), /*!< Support high capacity */
-    kSD_Support4BitWidthFlag        = (1U << 2U), /*!< Support 4-bit data width */
-    kSD_SupportSdhcFlag             = (1U << 3U), /*!< Card is SDHC */
-    kSD_SupportSdxcFlag             = (1U << 4U), /*!< Card is SDXC */
-    kSD_SupportVoltage180v          = (1U << 5U), /*!< card support 1.8v voltage*/
-    kSD_SupportSetBlockCountCmd     = (1U << 6U), /*!< card support cmd23 flag*/
-    kSD_SupportSpeedClassControlCmd = (1U << 7U), /*!< card support speed class control flag */
+    kSD_SupportHighCapacityFlag      = (1U << 1U), /*!< Support high capacity */
+    kSD_Support4BitWidthFlag         = (1U << 2U), /*!< Support 4-bit data width */
+    kSD_SupportSdhcFlag              = (1U << 3U), /*!< Card is SDHC */
+    kSD_SupportSdxcFlag              = (1U << 4U), /*!< Card is SDXC */
+    kSD_SupportVoltage180v           = (1U << 5U), /*!< card support 1.8v voltage*/
+    kSD_SupportSetBlockCountCmd      = (1U << 6U), /*!< card support cmd23 flag*/
+    kSD_SupportSpeedClassControlCmd  = (1U << 7U), /*!< card support speed class control flag */
+    kSD_RegisterSnapshotRestoredFlag = (1U << 8U), /*!< card registers are restored from the register snapshot */
 };
 
+/*! @brief SD card pre-erase policy for the multiple block write */
+typedef enum _sd_pre_erase_policy
+{
+    kSD_PreEraseDisable       = 0U, /*!< multiple block write without pre-erase */
+    kSD_PreEraseMultipleBlock = 1U, /*!< send ACMD23 with the block count before each multiple block write, the card
+                                       may erase the blocks in advance to speed up the write */
+} sd_pre_erase_policy_t;
+
+/*! @brief SD card speed class recording state */
+typedef struct _sd_recording
+{
+    bool isRecording;    /*!< recording is started */
+    uint32_t startBlock; /*!< start block of the recording area, aligned to AU */
+    uint32_t endBlock;   /*!< end block of the recording area, the block is not included */
+    uint32_t auBlocks;   /*!< AU size united as block */
+    uint32_t writeBlock; /*!< write pointer, the next block to be written by SD_WriteRecording */
+} sd_recording_t;
+
+/*! @brief SD card register snapshot
+ *
+ * The snapshot holds the decoded register content of the card, it is filled by a full card init and can be saved to
+ * the non-volatile memory as is. The next card init compares the CID and CSD of the card with the snapshot and
+ * restores the SCR and SD status from the snapshot instead of reading them from the card if they are the same.
+ */
+typedef struct _sd_register_snapshot
+{
+    uint32_t magic;         /*!< snapshot valid magic, set after a full card init */
+    uint32_t driverVersion; /*!< driver version which fills the snapshot */
+    uint32_t rawCid[4U];    /*!< raw CID register content */
+    uint32_t rawCsd[4U];    /*!< raw CSD register content */
+    uint32_t version;       /*!< card version */
+    uint32_t flags;         /*!< card flags decoded from the SCR */
+    sd_scr_t scr;           /*!< SCR */
+    sd_status_t stat;       /*!< sd 512 bit status */
+} sd_register_snapshot_t;
+
+/*! @brief SD card descriptor */
+typedef struct _sd_card sd_card_t;
+
+/*! @brief SD card asynchronous read/write complete callback
+ * The callback is invoked from the host interrupt context when using the non_blocking host adapter.
+ */
+typedef void (*sd_transfer_callback_t)(sd_card_t *card, status_t status, void *userData);
+
 /*!
  * @brief SD card state
  *
  * Define the card structure including the necessary fields to identify and describe the card.
  */
-typedef struct _sd_card
+struct _sd_card
 {
     sdmmchost_t *host; /*!< Host configuration */
 
@@ -49,6 +94,9 @@ typedef struct _sd_card
     bool isHostReady;        /*!< use this flag to indicate if need host re-init or not*/
 
     bool noInteralAlign;      /*!< used to enable/disable the functionality of the exchange buffer */
+    uint8_t *alignBuffer;     /*!< optional exchange buffer for the unaligned data buffer, the address should meet the
+                                 host DMA and cache line alignment, the internal one block buffer is used if NULL */
+    uint32_t alignBufferSize; /*!< exchange buffer size in byte, multiple blocks are transferred through it at once */
     uint32_t busClock_Hz;     /*!< SD bus clock frequency united in Hz */
     uint32_t relativeAddress; /*!< Relative address of the card */
     uint32_t version;         /*!< Card version */
@@ -65,8 +113,27 @@ typedef struct _sd_card
     sd_driver_strength_t driverStrength;                         /*!< driver strength */
     sd_max_current_t maxCurrent;                                 /*!< card current limit */
     sdmmc_operation_voltage_t operationVoltage;                  /*!< card operation voltage */
-    sdmmc_osa_mutex_t lock;                                      /*!< card access lock */
-} sd_card_t;
+    sd_pre_erase_policy_t preErasePolicy;                        /*!< pre-erase policy for the multiple block write */
+    sd_recording_t recording;                                    /*!< speed class recording state */
+    bool isReadIdle;                                             /*!< card is known idle after the last read */
+    uint32_t readIdleSequence;                                   /*!< host transfer sequence after the last read */
+    sd_register_snapshot_t *registerSnapshot;                    /*!< optional register snapshot for fast init */
+    sdmmc_retuning_statistics_t reTuningStatistics;              /*!< re-tuning statistics since the card init */
+    sdmmc_bus_governor_t busGovernor;                            /*!< bus speed governor of the tuned timing */
+    uint32_t writeChunkBlocks;                                   /*!< latency bounded write chunk, 0 to not yield */
+    volatile uint32_t pendingReads;                              /*!< read requests waiting for the card lock */
+#if SDMMC_ENABLE_INSTRUMENTATION
+    sdmmc_instrument_t instrument; /*!< transfer instrumentation since the card init */
+#endif
+
+    sd_transfer_callback_t transferCallback; /*!< asynchronous read/write complete callback */
+    void *transferUserData;                  /*!< asynchronous read/write complete callback user data */
+    sdmmchost_transfer_t asyncContent;       /*!< asynchronous read/write transfer content */
+    sdmmchost_cmd_t asyncCommand;            /*!< asynchronous read/write command */
+    sdmmchost_data_t asyncData;              /*!< asynchronous read/write data */
+
+    sdmmc_osa_mutex_t lock; /*!< card access lock */
+};
 
 /*************************************************************************************************
  * API
@@ -132,6 +199,11 @@ void SD_Deinit(sd_card_t *card);
  * SD_CardInit(card);
  * @endcode
  *
+ * If card->registerSnapshot is not NULL, the function restores the SCR and SD status from the snapshot when the CID and
+ * CSD of the card match the snapshot, kSD_RegisterSnapshotRestoredFlag is set in card->flags then. Otherwise the
+ * registers are read from the card and the snapshot is refilled, application can save the snapshot after the init to
+ * speed up the next init of the same card.
+ *
  * @param card Card descriptor.
  * @retval #kStatus_SDMMC_HostNotReady host is not ready.
  * @retval #kStatus_SDMMC_GoIdleFailed Go idle failed.
@@ -274,6 +346,9 @@ status_t SD_ReadBlocks(sd_card_t *card, uint8_t *buffer, uint32_t startBlock, ui
  * 1. It is a thread safe function.
  * 2. It is a async write function which means that the card status may still busy after the function return.
  * Application can call function SD_PollingCardStatusBusy to wait card status idle after the write operation.
+ * 3. If writeChunkBlocks in card descriptor is not 0, the write is split into commands of writeChunkBlocks blocks and
+ * the card lock is yielded to the SD_ReadBlocks waiting for it between the commands. Other accesses may be done
+ * between the commands as well.
  *
  * @param card Card descriptor.
  * @param buffer The buffer holding the data to be written to the card.
@@ -289,6 +364,69 @@ status_t SD_ReadBlocks(sd_card_t *card, uint8_t *buffer, uint32_t startBlock, ui
  */
 status_t SD_WriteBlocks(sd_card_t *card, const uint8_t *buffer, uint32_t startBlock, uint32_t blockCount);
 
+/*!
+ * @brief Reads blocks from the specific card asynchronously.
+ *
+ * This function submits one read transfer and returns without waiting the data, the callback is invoked once the
+ * transfer complete.
+ *
+ * Please note,
+ * 1. It is a thread safe function.
+ * 2. The buffer must be word aligned(cache line size aligned if the host cache line size align transfer enabled) and
+ * blockCount must not exceed the host maximum block count, since there is no internal buffer exchange for the
+ * asynchronous transfer.
+ * 3. The buffer must stay valid until the callback is invoked, a following read/write/erase request will wait the
+ * ongoing asynchronous transfer complete.
+ * 4. Re-tuning and retry is not performed for the asynchronous transfer, application can retry by SD_ReadBlocks.
+ *
+ * @param card Card descriptor.
+ * @param buffer The buffer to save the data read from card.
+ * @param startBlock The start block index.
+ * @param blockCount The number of blocks to read.
+ * @param callback Transfer complete callback.
+ * @param userData User data pass to the callback.
+ * @retval #kStatus_InvalidArgument Invalid argument.
+ * @retval #kStatus_SDMMC_PollingCardIdleFailed Polling card idle failed.
+ * @retval #kStatus_SDMMC_TransferFailed Submit transfer failed, or transfer failed with the blocking host adapter.
+ * @retval #kStatus_Success Transfer submitted successfully.
+ */
+status_t SD_ReadBlocksAsync(sd_card_t *card,
+                            uint8_t *buffer,
+                            uint32_t startBlock,
+                            uint32_t blockCount,
+                            sd_transfer_callback_t callback,
+                            void *userData);
+
+/*!
+ * @brief Writes blocks of data to the specific card asynchronously.
+ *
+ * This function submits one write transfer and returns without waiting the data, the callback is invoked once the
+ * transfer complete.
+ *
+ * Please note,
+ * 1. It is a thread safe function.
+ * 2. The buffer must be word aligned and blockCount must not exceed the host maximum block count.
+ * 3. The buffer must stay valid until the callback is invoked, the card may still be programming when the callback
+ * is invoked, the following request will polling the card status idle firstly.
+ *
+ * @param card Card descriptor.
+ * @param buffer The buffer holding the data to be written to the card.
+ * @param startBlock The start block index.
+ * @param blockCount The number of blocks to write.
+ * @param callback Transfer complete callback.
+ * @param userData User data pass to the callback.
+ * @retval #kStatus_InvalidArgument Invalid argument.
+ * @retval #kStatus_SDMMC_PollingCardIdleFailed Polling card idle failed.
+ * @retval #kStatus_SDMMC_TransferFailed Submit transfer failed, or transfer failed with the blocking host adapter.
+ * @retval #kStatus_Success Transfer submitted successfully.
+ */
+status_t SD_WriteBlocksAsync(sd_card_t *card,
+                             const uint8_t *buffer,
+                             uint32_t startBlock,
+                             uint32_t blockCount,
+                             sd_transfer_callback_t callback,
+                             void *userData);
+
 /*!
  * @brief Erases blocks of the specific card.
  *
@@ -309,6 +447,96 @@ status_t SD_WriteBlocks(sd_card_t *card, const uint8_t *buffer, uint32_t startBl
  */
 status_t SD_EraseBlocks(sd_card_t *card, uint32_t startBlock, uint32_t blockCount);
 
+/*!
+ * @brief Discards blocks of the specific card.
+ *
+ * Discard informs the card the blocks are no longer used, such as the clusters freed by the file system. The card
+ * doesn't erase the blocks physically but reclaims them in the background, so the busy time is short and doesn't
+ * depend on the number of blocks, the content of the discarded blocks is indeterminate. Discard is supported by the
+ * card of SD specification version 5.1 or later, reference the discardSupport field of card->stat.
+ *
+ * @note It is a thread safe function.
+ *
+ * @param card Card descriptor.
+ * @param startBlock The start block index.
+ * @param blockCount The number of blocks to discard.
+ * @retval #kStatus_SDMMC_NotSupportYet Discard is not supported by the card.
+ * @retval #kStatus_SDMMC_PollingCardIdleFailed Polling card idle failed.
+ * @retval #kStatus_SDMMC_TransferFailed Transfer failed.
+ * @retval #kStatus_Success Operate successfully.
+ */
+status_t SD_DiscardBlocks(sd_card_t *card, uint32_t startBlock, uint32_t blockCount);
+
+/*!
+ * @brief Erases the whole user area of the specific card logically.
+ *
+ * Full user area logical erase(FULE) erases the whole user area within 1 second regardless of the card capacity,
+ * reference the fuleSupport field of card->stat.
+ *
+ * @note It is a thread safe function.
+ *
+ * @param card Card descriptor.
+ * @retval #kStatus_SDMMC_NotSupportYet FULE is not supported by the card.
+ * @retval #kStatus_SDMMC_PollingCardIdleFailed Polling card idle failed.
+ * @retval #kStatus_SDMMC_TransferFailed Transfer failed.
+ * @retval #kStatus_Success Operate successfully.
+ */
+status_t SD_FullUserAreaLogicalErase(sd_card_t *card);
+
+/*!
+ * @brief Starts the speed class recording.
+ *
+ * The recording area is shrunk to whole AUs, the AU size is taken from the SD status. The card is informed by CMD20
+ * start recording if it supports the speed class control command, then the data should be written sequentially from
+ * the start of the area by SD_WriteRecording, which keeps the write pointer in card->recording.writeBlock. The
+ * sequential AU write is the condition for the card to guarantee the speed class performance.
+ *
+ * Please note,
+ * 1. It is a thread safe function.
+ * 2. The other read/write functions are still allowed during recording, but they should not access the recording area.
+ *
+ * @param card Card descriptor.
+ * @param startBlock The start block index of the recording area.
+ * @param blockCount The block count of the recording area.
+ * @retval #kStatus_InvalidArgument The area is smaller than one AU.
+ * @retval #kStatus_SDMMC_CardNotSupport AU size is not available.
+ * @retval #kStatus_SDMMC_TransferFailed Transfer failed.
+ * @retval #kStatus_SDMMC_WaitWriteCompleteFailed Wait card idle failed.
+ * @retval #kStatus_Success Operate successfully.
+ */
+status_t SD_StartRecording(sd_card_t *card, uint32_t startBlock, uint32_t blockCount);
+
+/*!
+ * @brief Writes blocks at the recording write pointer.
+ *
+ * The data is written at card->recording.writeBlock, the write is split at the AU boundary so that every write command
+ * stays in one AU, and the write pointer is advanced by the blocks written.
+ *
+ * Please note, it is a thread safe function, the card lock is held for the whole write, so the write is not yielded
+ * to the pending reads between the write chunks as SD_WriteBlocks does.
+ *
+ * @param card Card descriptor.
+ * @param buffer The buffer to save the data to be written.
+ * @param blockCount The number of blocks to write.
+ * @retval #kStatus_InvalidArgument Recording is not started.
+ * @retval #kStatus_OutOfRange The recording area is full.
+ * @retval #kStatus_SDMMC_TransferFailed Transfer failed.
+ * @retval #kStatus_Success Operate successfully.
+ */
+status_t SD_WriteRecording(sd_card_t *card, const uint8_t *buffer, uint32_t blockCount);
+
+/*!
+ * @brief Ends the speed class recording.
+ *
+ * The card is informed by CMD20 end recording if it supports the speed class control command.
+ *
+ * @param card Card descriptor.
+ * @retval #kStatus_SDMMC_TransferFailed Transfer failed.
+ * @retval #kStatus_SDMMC_WaitWriteCompleteFailed Wait card idle failed.
+ * @retval #kStatus_Success Operate successfully.
+ */
+status_t SD_StopRecording(sd_card_t *card);
+
 /*!
  * @brief select card driver strength
  * select card driver strength
@@ -339,6 +567,30 @@ status_t SD_SetMaxCurrent(sd_card_t *card, sd_max_current_t maxCurrent);
  */
 status_t SD_PollingCardStatusBusy(sd_card_t *card, uint32_t timeoutMs);
 
+#if SDMMC_ENABLE_INSTRUMENTATION
+/*!
+ * @brief Gets the transfer instrumentation of the card.
+ *
+ * The instrumentation is enabled by SDMMC_ENABLE_INSTRUMENTATION, the latency percentile of each command is got by
+ * SDMMC_LatencyHistogramPercentile.
+ *
+ * @note It is a thread safe function.
+ *
+ * @param card Card descriptor.
+ * @param instrument Transfer instrumentation copied from the card.
+ */
+void SD_GetInstrumentation(sd_card_t *card, sdmmc_instrument_t *instrument);
+
+/*!
+ * @brief Resets the transfer instrumentation of the card.
+ *
+ * @note It is a thread safe function.
+ *
+ * @param card Card descriptor.
+ */
+void SD_ResetInstrumentation(sd_card_t *card);
+#endif
+
 /* @} */
 
 #if defined(__cplusplus)
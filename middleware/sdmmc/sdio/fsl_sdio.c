@@ -80,6 +80,13 @@ static status_t SDIO_SetMaxDataBusWidth(sdio_card_t *card);
  */
 static status_t SDIO_ExecuteTuning(sdio_card_t *card);
 
+/*!
+ * @brief sdio card transfer, the transfer is recorded in the instrumentation.
+ * @param card Card descriptor.
+ * @param content Transfer content.
+ */
+static status_t SDIO_Transfer(sdio_card_t *card, sdmmchost_transfer_t *content);
+
 /*!
  * @brief sdio io access direct
  * @param card Card descriptor.
@@ -162,7 +169,7 @@ static status_t SDIO_SwitchVoltage(sdio_card_t *card, sdmmc_operation_voltage_t
 
     content.command = &command;
     content.data    = NULL;
-    error           = SDMMCHOST_TransferFunction(card->host, &content);
+    error           = SDIO_Transfer(card, &content);
     if (kStatus_Success != error)
     {
         return kStatus_SDMMC_TransferFailed;
@@ -223,8 +230,36 @@ static status_t SDIO_ExecuteTuning(sdio_card_t *card)
 {
     assert(card != NULL);
 
-    return SDMMCHOST_ExecuteTuning(card->host, (uint32_t)kSD_SendTuningBlock,
-                                   (uint32_t *)FSL_SDMMC_CARD_INTERNAL_BUFFER_ALIGN_ADDR(card->internalBuffer), 64U);
+    status_t error;
+
+    /* the SDIO card has no CID, the manufacturer ID read from the common CIS is used as the card ID of the key */
+    (void)memset(card->host->tuningKey.cardId, 0, sizeof(card->host->tuningKey.cardId));
+    card->host->tuningKey.cardId[0U]  = ((uint32_t)card->commonCIS.mInfo << 16U) | (uint32_t)card->commonCIS.mID;
+    card->host->tuningKey.busMode     = (uint32_t)card->currentTiming;
+    card->host->tuningKey.busClock_Hz = card->busClock_Hz;
+
+    SDMMC_INSTRUMENT_COUNT(&card->instrument, tuningEvents);
+    error = SDMMCHOST_ExecuteTuning(card->host, (uint32_t)kSD_SendTuningBlock,
+                                    (uint32_t *)FSL_SDMMC_CARD_INTERNAL_BUFFER_ALIGN_ADDR(card->internalBuffer), 64U);
+    if (error != kStatus_Success)
+    {
+        SDMMC_INSTRUMENT_COUNT(&card->instrument, tuningErrors);
+    }
+
+    return error;
+}
+
+static status_t SDIO_Transfer(sdio_card_t *card, sdmmchost_transfer_t *content)
+{
+    assert(card != NULL);
+    assert(content != NULL);
+
+    uint32_t startCycles = SDMMC_INSTRUMENT_TIMESTAMP();
+    status_t error       = SDMMCHOST_TransferFunction(card->host, content);
+
+    SDMMC_INSTRUMENT_TRANSFER(&card->instrument, content, error, startCycles);
+
+    return error;
 }
 
 static status_t SDIO_SendRca(sdio_card_t *card)
@@ -248,7 +283,7 @@ static status_t SDIO_SendRca(sdio_card_t *card)
 
     while (--i != 0U)
     {
-        error = SDMMCHOST_TransferFunction(card->host, &content);
+        error = SDIO_Transfer(card, &content);
         if (kStatus_Success == error)
         {
             /* check illegal state and cmd CRC error, may be the voltage or clock not stable, retry the cmd*/
@@ -291,7 +326,7 @@ static status_t SDIO_SendOperationCondition(sdio_card_t *card, uint32_t argument
 
     while (--i != 0U)
     {
-        error = SDMMCHOST_TransferFunction(card->host, &content);
+        error = SDIO_Transfer(card, &content);
         if ((kStatus_Success != error) || (command.response[0U] == 0U))
         {
             continue;
@@ -372,7 +407,7 @@ static status_t SDIO_IO_Access_Direct(sdio_card_t *card,
 
     content.command = &command;
     content.data    = NULL;
-    error           = SDMMCHOST_TransferFunction(card->host, &content);
+    error           = SDIO_Transfer(card, &content);
     if (kStatus_Success != error)
     {
         error = kStatus_SDMMC_TransferFailed;
@@ -535,7 +570,7 @@ status_t SDIO_IO_Write_Extended(
 
         content.command = &command;
         content.data    = &data;
-        error           = SDMMCHOST_TransferFunction(card->host, &content);
+        error           = SDIO_Transfer(card, &content);
         if (kStatus_Success != error)
         {
             error = kStatus_SDMMC_TransferFailed;
@@ -633,7 +668,7 @@ status_t SDIO_IO_Read_Extended(
 
         content.command = &command;
         content.data    = &data;
-        error           = SDMMCHOST_TransferFunction(card->host, &content);
+        error           = SDIO_Transfer(card, &content);
         if (kStatus_Success != error)
         {
             error = kStatus_SDMMC_TransferFailed;
@@ -734,7 +769,7 @@ status_t SDIO_IO_Transfer(sdio_card_t *card,
 
         do
         {
-            error = SDMMCHOST_TransferFunction(card->host, &content);
+            error = SDIO_Transfer(card, &content);
             if (kStatus_Success == error)
             {
                 if ((rxData != NULL) && (dataSize != 0U) &&
@@ -1671,6 +1706,9 @@ status_t SDIO_CardInit(sdio_card_t *card)
     (void)SDMMC_OSAMutexCreate(&card->lock);
     (void)SDMMC_OSAMutexLock(&card->lock, osaWaitForever_c);
 
+#if SDMMC_ENABLE_INSTRUMENTATION
+    SDMMC_InstrumentReset(&card->instrument);
+#endif
     SDIO_SetCardPower(card, true);
 
     error = sdiocard_init(card);
@@ -2109,3 +2147,24 @@ status_t SDIO_HandlePendingIOInterrupt(sdio_card_t *card)
 
     return kStatus_Success;
 }
+
+#if SDMMC_ENABLE_INSTRUMENTATION
+void SDIO_GetInstrumentation(sdio_card_t *card, sdmmc_instrument_t *instrument)
+{
+    assert(card != NULL);
+    assert(instrument != NULL);
+
+    (void)SDMMC_OSAMutexLock(&card->lock, osaWaitForever_c);
+    (void)memcpy(instrument, &card->instrument, sizeof(sdmmc_instrument_t));
+    (void)SDMMC_OSAMutexUnlock(&card->lock);
+}
+
+void SDIO_ResetInstrumentation(sdio_card_t *card)
+{
+    assert(card != NULL);
+
+    (void)SDMMC_OSAMutexLock(&card->lock, osaWaitForever_c);
+    SDMMC_InstrumentReset(&card->instrument);
+    (void)SDMMC_OSAMutexUnlock(&card->lock);
+}
+#endif
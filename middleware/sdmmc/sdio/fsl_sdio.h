@@ -20,7 +20,7 @@
  * Definitions
  ******************************************************************************/
 /*! @brief Middleware version. */
-#define FSL_SDIO_DRIVER_VERSION (MAKE_VERSION(2U, 4U, 1U)) /*2.4.1*/
+#define FSL_SDIO_DRIVER_VERSION (MAKE_VERSION(2U, 5U, 0U)) /*2.5.0*/
 
 /*!@brief sdio device support maximum IO number */
 #ifndef FSL_SDIO_MAX_IO_NUMS
@@ -77,6 +77,9 @@ struct _sdio_card
     uint8_t ioIntIndex;                                       /*!< used to record current enabled io interrupt index */
     uint8_t ioIntNums;                                        /*!< used to record total enabled io interrupt numbers  */
     sdmmc_osa_mutex_t lock;                                   /*!< card access lock */
+#if SDMMC_ENABLE_INSTRUMENTATION
+    sdmmc_instrument_t instrument; /*!< transfer instrumentation since the card init */
+#endif
 };
 
 /*************************************************************************************************
@@ -518,6 +521,26 @@ void SDIO_SetIOIRQHandler(sdio_card_t *card, sdio_func_num_t func, sdio_io_irq_h
  */
 status_t SDIO_HandlePendingIOInterrupt(sdio_card_t *card);
 
+#if SDMMC_ENABLE_INSTRUMENTATION
+/*!
+ * @brief Gets the transfer instrumentation of the card.
+ *
+ * The instrumentation is enabled by SDMMC_ENABLE_INSTRUMENTATION, the latency percentile of each command is got by
+ * SDMMC_LatencyHistogramPercentile.
+ *
+ * @param card Card descriptor.
+ * @param instrument Transfer instrumentation copied from the card.
+ */
+void SDIO_GetInstrumentation(sdio_card_t *card, sdmmc_instrument_t *instrument);
+
+/*!
+ * @brief Resets the transfer instrumentation of the card.
+ *
+ * @param card Card descriptor.
+ */
+void SDIO_ResetInstrumentation(sdio_card_t *card);
+#endif
+
 /* @} */
 
 #if defined(__cplusplus)
@@ -0,0 +1,177 @@
+/*
+ * Copyright 2020 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <string.h>
+#include "fsl_sdmmc_trace.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+/*!
+ * @brief Claim one record index.
+ * The claim is retried when the exclusive access is broken by the other writer, the writer never waits the others.
+ *
+ * @param trace trace descriptor.
+ * @return claimed record index.
+ */
+static uint32_t SDMMC_TraceClaim(sdmmc_trace_t *trace);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+/*! @brief installed trace ring */
+static sdmmc_trace_t *volatile s_sdmmcTrace = NULL;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+static uint32_t SDMMC_TraceClaim(sdmmc_trace_t *trace)
+{
+    uint32_t index = 0U;
+
+    do
+    {
+        index = __LDREXW(&trace->head);
+    } while (__STREXW(index + 1U, &trace->head) != 0U);
+
+    return index;
+}
+
+status_t SDMMC_TraceInit(sdmmc_trace_t *trace, sdmmc_trace_record_t *records, uint32_t recordCount)
+{
+    assert(trace != NULL);
+
+    if ((records == NULL) || (recordCount == 0U) || ((recordCount & (recordCount - 1U)) != 0U))
+    {
+        return kStatus_InvalidArgument;
+    }
+
+#if defined(SDMMC_TRACE_DWT_CYCLES)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
+    (void)memset(records, 0, recordCount * sizeof(sdmmc_trace_record_t));
+    trace->records    = records;
+    trace->recordMask = recordCount - 1U;
+    trace->head       = 0U;
+    trace->tail       = 0U;
+
+    __DMB();
+    s_sdmmcTrace = trace;
+
+    return kStatus_Success;
+}
+
+void SDMMC_TraceDeinit(sdmmc_trace_t *trace)
+{
+    assert(trace != NULL);
+
+    if (s_sdmmcTrace == trace)
+    {
+        s_sdmmcTrace = NULL;
+    }
+}
+
+void SDMMC_TraceTransfer(const sdmmchost_transfer_t *content, status_t error, uint32_t startCycles, uint32_t flags)
+{
+    assert(content != NULL);
+
+    sdmmc_trace_t *trace         = s_sdmmcTrace;
+    sdmmc_trace_record_t *record = NULL;
+    uint32_t duration            = SDMMC_TRACE_GET_CYCLES() - startCycles;
+    uint32_t index               = 0U;
+
+    if (trace == NULL)
+    {
+        return;
+    }
+
+    if (__get_IPSR() != 0U)
+    {
+        flags |= (uint32_t)kSDMMC_TraceFlagInterrupt;
+    }
+
+    index  = SDMMC_TraceClaim(trace);
+    record = &trace->records[index & trace->recordMask];
+
+    /* invalidate the record before the content is updated, the dump skips the record being written */
+    record->sequence = 0U;
+    __DMB();
+
+    record->timestamp  = startCycles;
+    record->duration   = duration;
+    record->argument   = content->command->argument;
+    record->status     = (int32_t)error;
+    record->command    = (uint8_t)content->command->index;
+    record->blockCount = 0U;
+    if (content->data != NULL)
+    {
+        record->blockCount = (uint16_t)content->data->blockCount;
+        flags |= (uint32_t)kSDMMC_TraceFlagData;
+        if (content->data->txData != NULL)
+        {
+            flags |= (uint32_t)kSDMMC_TraceFlagWrite;
+        }
+    }
+    record->flags = (uint8_t)flags;
+
+    __DMB();
+    record->sequence = index + 1U;
+}
+
+status_t SDMMC_TraceDump(sdmmc_trace_t *trace, sdmmc_trace_output_t output, void *userData)
+{
+    assert(trace != NULL);
+    assert(output != NULL);
+
+    sdmmc_trace_dump_header_t header;
+    sdmmc_trace_record_t record;
+    uint32_t head     = trace->head;
+    uint32_t index    = trace->tail;
+    uint32_t sequence = 0U;
+    status_t error    = kStatus_Success;
+
+    header.magic       = SDMMC_TRACE_DUMP_MAGIC;
+    header.version     = SDMMC_TRACE_DUMP_VERSION;
+    header.recordSize  = (uint16_t)sizeof(sdmmc_trace_record_t);
+    header.cyclesPerUs = SDMMC_TRACE_CYCLES_PER_US;
+    header.dropped     = 0U;
+    /* the records older than one ring size are overwritten */
+    if ((head - index) > (trace->recordMask + 1U))
+    {
+        header.dropped = head - index - (trace->recordMask + 1U);
+        index          = head - (trace->recordMask + 1U);
+    }
+    header.recordCount = head - index;
+
+    error = output(userData, (const uint8_t *)&header, sizeof(header));
+
+    while ((error == kStatus_Success) && (index != head))
+    {
+        sequence = trace->records[index & trace->recordMask].sequence;
+        __DMB();
+        (void)memcpy(&record, &trace->records[index & trace->recordMask], sizeof(record));
+        __DMB();
+        /* the record overwritten during the dump is exported with sequence 0 */
+        if ((sequence != (index + 1U)) || (trace->records[index & trace->recordMask].sequence != sequence))
+        {
+            record.sequence = 0U;
+        }
+
+        error = output(userData, (const uint8_t *)&record, sizeof(record));
+        index++;
+    }
+
+    trace->tail = index;
+
+    return error;
+}
@@ -0,0 +1,169 @@
+/*
+ * Copyright 2020 NXP
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _FSL_SDMMC_TRACE_H_
+#define _FSL_SDMMC_TRACE_H_
+
+#include "fsl_sdmmc_host.h"
+
+/*!
+ * @addtogroup sdmmc_trace SDMMC transfer trace
+ * @ingroup card
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*! @brief Transfer trace version. */
+#define FSL_SDMMC_TRACE_VERSION (MAKE_VERSION(1U, 0U, 0U)) /*1.0.0*/
+
+/*! @brief trace cycle counter, the DWT cycle counter is enabled by SDMMC_TraceInit by default */
+#ifndef SDMMC_TRACE_GET_CYCLES
+#define SDMMC_TRACE_GET_CYCLES() (DWT->CYCCNT)
+#define SDMMC_TRACE_DWT_CYCLES
+#endif
+/*! @brief trace cycle counter frequency in MHz, it is saved in the dump header for the timeline conversion */
+#ifndef SDMMC_TRACE_CYCLES_PER_US
+#define SDMMC_TRACE_CYCLES_PER_US (SystemCoreClock / 1000000U)
+#endif
+
+/*! @brief trace dump magic "SDTR" */
+#define SDMMC_TRACE_DUMP_MAGIC (0x52544453U)
+/*! @brief trace dump format version */
+#define SDMMC_TRACE_DUMP_VERSION (1U)
+
+/*! @brief sdmmc trace record flags */
+enum _sdmmc_trace_flag
+{
+    kSDMMC_TraceFlagData      = 1U << 0U, /*!< transfer with data */
+    kSDMMC_TraceFlagWrite     = 1U << 1U, /*!< data is written to the card */
+    kSDMMC_TraceFlagAsync     = 1U << 2U, /*!< asynchronous transfer, duration is from submit to completion */
+    kSDMMC_TraceFlagInterrupt = 1U << 3U, /*!< recorded in the interrupt context */
+};
+
+/*! @brief sdmmc trace record, it is dumped as is in little endian */
+typedef struct _sdmmc_trace_record
+{
+    volatile uint32_t sequence; /*!< record index plus one, 0 while the record is being written */
+    uint32_t timestamp;         /*!< transfer start in trace cycles */
+    uint32_t duration;          /*!< transfer duration in trace cycles */
+    uint32_t argument;          /*!< command argument */
+    int32_t status;             /*!< transfer status */
+    uint16_t blockCount;        /*!< data block count, 0 for the transfer without data */
+    uint8_t command;            /*!< command index */
+    uint8_t flags;              /*!< record flags, reference _sdmmc_trace_flag */
+} sdmmc_trace_record_t;
+
+/*! @brief sdmmc trace dump header, followed by recordCount records */
+typedef struct _sdmmc_trace_dump_header
+{
+    uint32_t magic;       /*!< SDMMC_TRACE_DUMP_MAGIC */
+    uint16_t version;     /*!< SDMMC_TRACE_DUMP_VERSION */
+    uint16_t recordSize;  /*!< size of sdmmc_trace_record_t */
+    uint32_t cyclesPerUs; /*!< trace cycle counter frequency in MHz */
+    uint32_t recordCount; /*!< records in the dump */
+    uint32_t dropped;     /*!< records overwritten before the dump since the previous dump */
+} sdmmc_trace_dump_header_t;
+
+/*!
+ * @brief sdmmc trace dump output function.
+ *
+ * @param userData user data pass to SDMMC_TraceDump.
+ * @param data dump data.
+ * @param size dump data size.
+ * @retval kStatus_Success the data is exported.
+ */
+typedef status_t (*sdmmc_trace_output_t)(void *userData, const uint8_t *data, uint32_t size);
+
+/*! @brief sdmmc trace ring */
+typedef struct _sdmmc_trace
+{
+    sdmmc_trace_record_t *records; /*!< record ring buffer */
+    uint32_t recordMask;           /*!< record ring size minus one, the size is power of 2 */
+    volatile uint32_t head;        /*!< claimed record count */
+    uint32_t tail;                 /*!< record count consumed by the dump */
+} sdmmc_trace_t;
+
+/*************************************************************************************************
+ * API
+ ************************************************************************************************/
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*!
+ * @name SDMMC transfer trace Function
+ * @{
+ */
+
+/*!
+ * @brief Initializes the trace ring and installs it to the host adapter.
+ *
+ * The host adapter records every SDMMCHOST_TransferFunction and asynchronous transfer into the installed ring when
+ * SDMMC_ENABLE_TRACE is enabled. The writer claims the record by exclusive access and never blocks, so the ring is
+ * shared by the hosts and the interrupt context, the oldest records are overwritten when the ring is full.
+ *
+ * Example:
+   @code
+   static sdmmc_trace_record_t s_traceRecords[1024U];
+
+   SDMMC_TraceInit(&trace, s_traceRecords, 1024U);
+   ...
+   SDMMC_TraceDump(&trace, UART_TraceOutput, NULL);
+   @endcode
+ *
+ * @param trace trace descriptor.
+ * @param records record buffer.
+ * @param recordCount record buffer size, it should be power of 2.
+ * @retval kStatus_Success init success.
+ * @retval kStatus_InvalidArgument invalid record buffer.
+ */
+status_t SDMMC_TraceInit(sdmmc_trace_t *trace, sdmmc_trace_record_t *records, uint32_t recordCount);
+
+/*!
+ * @brief Uninstalls the trace ring from the host adapter.
+ *
+ * @param trace trace descriptor.
+ */
+void SDMMC_TraceDeinit(sdmmc_trace_t *trace);
+
+/*!
+ * @brief Records the transfer into the installed trace ring.
+ *
+ * It is called by the host adapter, nothing is recorded if no trace ring is installed.
+ *
+ * @param content transfer content.
+ * @param error transfer status.
+ * @param startCycles transfer start got by SDMMC_TRACE_GET_CYCLES.
+ * @param flags extra record flags, such as kSDMMC_TraceFlagAsync.
+ */
+void SDMMC_TraceTransfer(const sdmmchost_transfer_t *content, status_t error, uint32_t startCycles, uint32_t flags);
+
+/*!
+ * @brief Dumps the records since the previous dump.
+ *
+ * The dump is a sdmmc_trace_dump_header_t followed by the records in the recorded order, the records overwritten
+ * before the dump are counted in the header and the record overwritten during the dump is exported with sequence 0.
+ * The dump can be converted to the Chrome trace/Perfetto timeline by tools/sdmmc_trace_to_json.py. Only one dump
+ * should be ongoing at the same time, the transfers are still recorded during the dump.
+ *
+ * @param trace trace descriptor.
+ * @param output dump output function.
+ * @param userData user data pass to the output function.
+ * @retval kStatus_Success dump success.
+ * @retval other status returned by the output function.
+ */
+status_t SDMMC_TraceDump(sdmmc_trace_t *trace, sdmmc_trace_output_t output, void *userData);
+
+/* @} */
+
+#if defined(__cplusplus)
+}
+#endif
+/*! @} */
+#endif /* _FSL_SDMMC_TRACE_H_*/
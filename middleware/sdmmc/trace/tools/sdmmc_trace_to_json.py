@@ -0,0 +1,138 @@
+#!/usr/bin/env python3
+#
+# Copyright 2020 NXP
+# All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+"""Convert the binary dump of SDMMC_TraceDump into a Chrome trace/Perfetto JSON timeline.
+
+Usage:
+    sdmmc_trace_to_json.py dump.bin [dump2.bin ...] -o timeline.json
+
+Several dumps of the same run can be given in order, the timestamps are unwrapped across them. Open the output in
+chrome://tracing or https://ui.perfetto.dev.
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+DUMP_MAGIC = 0x52544453
+DUMP_VERSION = 1
+HEADER = struct.Struct("<IHHIII")
+RECORD = struct.Struct("<IIIIiHBB")
+
+FLAG_DATA = 1 << 0
+FLAG_WRITE = 1 << 1
+FLAG_ASYNC = 1 << 2
+FLAG_INTERRUPT = 1 << 3
+
+# tid of the timeline rows
+TID_TRANSFER = 1
+TID_ASYNC = 2
+
+
+def read_dumps(paths):
+    """Yield (cyclesPerUs, dropped, records) of each dump in the files."""
+    for path in paths:
+        with open(path, "rb") as f:
+            data = f.read()
+        offset = 0
+        while offset + HEADER.size <= len(data):
+            magic, version, record_size, cycles_per_us, count, dropped = HEADER.unpack_from(data, offset)
+            if magic != DUMP_MAGIC or version != DUMP_VERSION:
+                sys.exit("%s: bad dump header at offset %d" % (path, offset))
+            offset += HEADER.size
+            records = []
+            for _ in range(count):
+                if offset + record_size > len(data):
+                    sys.exit("%s: truncated dump" % path)
+                records.append(RECORD.unpack_from(data, offset))
+                offset += record_size
+            yield cycles_per_us, dropped, records
+
+
+def command_name(command, flags):
+    name = "CMD%d" % command
+    if flags & FLAG_DATA:
+        name += " write" if flags & FLAG_WRITE else " read"
+    return name
+
+
+def convert(paths):
+    events = [
+        {"ph": "M", "name": "process_name", "pid": 1, "args": {"name": "sdmmc"}},
+        {"ph": "M", "name": "thread_name", "pid": 1, "tid": TID_TRANSFER, "args": {"name": "transfer"}},
+        {"ph": "M", "name": "thread_name", "pid": 1, "tid": TID_ASYNC, "args": {"name": "async transfer"}},
+    ]
+    last_cycles = None
+    unwrapped_cycles = 0
+    dropped_total = 0
+    torn_total = 0
+
+    for cycles_per_us, dropped, records in read_dumps(paths):
+        dropped_total += dropped
+        if cycles_per_us == 0:
+            sys.exit("cycle counter frequency is 0 in the dump header")
+        for sequence, timestamp, duration, argument, status, block_count, command, flags in records:
+            if sequence == 0:
+                torn_total += 1
+                continue
+            # the records are in completion order, the 32 bit start cycles are unwrapped by the signed distance to
+            # the previous record assuming the records are less than half a counter wrap apart
+            if last_cycles is None:
+                cycles = timestamp
+            else:
+                delta = (timestamp - last_cycles) & 0xFFFFFFFF
+                cycles = unwrapped_cycles + (delta - (1 << 32) if delta & 0x80000000 else delta)
+            last_cycles = timestamp
+            unwrapped_cycles = cycles
+            start_us = cycles / cycles_per_us
+            event = {
+                "name": command_name(command, flags),
+                "cat": "error" if status != 0 else ("data" if flags & FLAG_DATA else "command"),
+                "ph": "X",
+                "ts": start_us,
+                "dur": duration / cycles_per_us,
+                "pid": 1,
+                "tid": TID_ASYNC if flags & FLAG_ASYNC else TID_TRANSFER,
+                "args": {
+                    "sequence": sequence,
+                    "argument": "0x%08x" % argument,
+                    "blocks": block_count,
+                    "status": status,
+                    "interrupt": bool(flags & FLAG_INTERRUPT),
+                },
+            }
+            events.append(event)
+
+    return {
+        "traceEvents": events,
+        "displayTimeUnit": "ns",
+        "otherData": {"droppedRecords": dropped_total, "tornRecords": torn_total},
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert SDMMC trace dumps to a Chrome trace/Perfetto timeline.")
+    parser.add_argument("dumps", nargs="+", help="binary dump files written by SDMMC_TraceDump")
+    parser.add_argument("-o", "--output", default="-", help="output JSON file, stdout by default")
+    args = parser.parse_args()
+
+    timeline = convert(args.dumps)
+    if args.output == "-":
+        json.dump(timeline, sys.stdout)
+    else:
+        with open(args.output, "w") as f:
+            json.dump(timeline, f)
+    other = timeline["otherData"]
+    sys.stderr.write(
+        "%d events, %d records dropped, %d records torn\n"
+        % (len(timeline["traceEvents"]), other["droppedRecords"], other["tornRecords"])
+    )
+
+
+if __name__ == "__main__":
+    main()